@@ -32,7 +32,12 @@
 #include "CoTaskLib/Ease.hpp"
 #include "CoTaskLib/Typewriter.hpp"
 #include "CoTaskLib/Tween.hpp"
+#include "CoTaskLib/TweenBatch.hpp"
+#include "CoTaskLib/Timeline.hpp"
 #include "CoTaskLib/Sequence.hpp"
 #include "CoTaskLib/ScreenFade.hpp"
 #include "CoTaskLib/SimpleDialog.hpp"
 #include "CoTaskLib/S3dAsyncTask.hpp"
+#include "CoTaskLib/Worker.hpp"
+#include "CoTaskLib/Executor.hpp"
+#include "CoTaskLib/Profiler.hpp"
@@ -29,11 +29,65 @@
 #pragma once
 #include <Siv3D.hpp>
 #include <coroutine>
+#include <source_location>
+#if defined(COTASKLIB_ENABLE_PROFILER) && __has_include(<cxxabi.h>)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
 
 namespace cotasklib::Co
 {
 	namespace detail
 	{
+		using AwaiterID = uint64;
+
+		// 起床条件: 起床しない(タスクが削除されるまで休止する)
+		struct WakeNever
+		{
+		};
+
+		// 起床条件: 指定回数のupdate後に起床する
+		struct WakeAfterUpdateCount
+		{
+			uint64 count;
+		};
+
+		// 起床条件: Scene::Time()が指定時刻に達したら起床する
+		struct WakeAtSceneTime
+		{
+			double time;
+		};
+
+		// 起床条件: ISteadyClockの時刻が指定時刻に達したら起床する
+		struct WakeAtSteadyClockTime
+		{
+			ISteadyClock* pSteadyClock;
+			uint64 microsec;
+		};
+
+		using WakeCondition = std::variant<WakeNever, WakeAfterUpdateCount, WakeAtSceneTime, WakeAtSteadyClockTime>;
+
+		// 待機中のタスクの末端にあり、Backendが毎フレームresumeせずに休止させられる待機対象
+		class ISleeper
+		{
+		public:
+			virtual ~ISleeper() = default;
+
+			// 最後のresume時点からみた起床条件
+			[[nodiscard]]
+			virtual WakeCondition wakeCondition() const = 0;
+
+			// 休止中にresumeを省略したupdate回数を受け取り、毎フレームresumeした場合と同じ状態にする
+			virtual void onWake(uint64 skippedUpdateCount) = 0;
+
+			// 休止開始時に、休止したエントリを起床させるためのIDを受け取る
+			virtual void onPark([[maybe_unused]] AwaiterID id, [[maybe_unused]] uint32 parkSerial)
+			{
+			}
+		};
+
+		class PromiseBase;
+
 		class IAwaiter
 		{
 		public:
@@ -43,34 +97,90 @@ namespace cotasklib::Co
 
 			[[nodiscard]]
 			virtual bool done() const = 0;
+
+			// 子のタスクを含めて休止可能な待機対象のみを待っている場合、その待機対象を返す
+			[[nodiscard]]
+			virtual ISleeper* sleeper() const
+			{
+				return nullptr;
+			}
+
+			// 保持しているタスクのPromise(空のタスクの場合はnullptr)
+			[[nodiscard]]
+			virtual PromiseBase* promise() const
+			{
+				return nullptr;
+			}
+
+			// 保持しているタスクに実行中の並行タスク(Task::withで追加したもの)があるかどうか
+			[[nodiscard]]
+			virtual bool hasActiveConcurrentTasks() const
+			{
+				return false;
+			}
 		};
 
+		// タスクが保持しているメモリ
+		struct TaskMemoryUsage
+		{
+			// コルーチンフレーム(子のタスクと並行タスクを含む)の数とバイト数
+			std::size_t frameCount = 0;
+			std::size_t frameBytes = 0;
+
+			// Task::with()で追加された並行タスク(その子のタスクを含む)の数と、それらのコルーチンフレームおよび一覧の追加確保のバイト数
+			std::size_t companionCount = 0;
+			std::size_t companionBytes = 0;
+		};
+
+		// pAwaiterが保持しているタスクのメモリをusageへ加算する(PromiseBaseの定義後に定義)
+		void AddTaskMemoryUsage(const IAwaiter* pAwaiter, TaskMemoryUsage& usage);
+
+		// pRootAwaiterを1フレーム分実行し、次回resumeすべき末端のAwaiterを返す(PromiseBaseの定義後に定義)
+		[[nodiscard]]
+		IAwaiter* ResumeFromLeaf(IAwaiter* pRootAwaiter, IAwaiter* pLeafAwaiter);
+
 		struct AwaiterEntry
 		{
+			AwaiterID id;
+
+			// 登録順を表す通し番号(休止から復帰したエントリを元の実行順に戻すために使用)
+			uint64 sequence;
+
+			// 登録時点のupdate回数(登録からの経過を調べるために使用)
+			uint64 addedUpdateCount;
+
 			std::unique_ptr<IAwaiter> awaiter;
-			std::function<void(const IAwaiter*)> finishCallback;
-			std::function<void()> cancelCallback;
+
+			// 前回のresume時点で最も内側にあるAwaiter(nullptrの場合は次回のresume時に求める)
+			IAwaiter* pLeafAwaiter = nullptr;
+
+			// 完了・キャンセル時のコールバックを呼び出す関数(コールバック本体はawaiter側に保持される)
+			void (*fnCallEndCallback)(IAwaiter*) = nullptr;
 
 			void callEndCallback() const
 			{
-				if (awaiter->done())
-				{
-					if (finishCallback)
-					{
-						finishCallback(awaiter.get());
-					}
-				}
-				else
-				{
-					if (cancelCallback)
-					{
-						cancelCallback();
-					}
-				}
+				fnCallEndCallback(awaiter.get());
 			}
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+			// プロファイラ用の計測情報
+			struct ProfileRecord
+			{
+				String name;
+				std::source_location location;
+				bool hasLocation = false;
+				uint64 resumeCount = 0;
+				uint64 totalResumeNanosec = 0;
+			};
+
+			ProfileRecord profile{};
+#endif
 		};
 
-		using AwaiterID = uint64;
+#ifdef COTASKLIB_ENABLE_PROFILER
+		// 登録するタスクのPromiseから名前と記述位置を取得する(PromiseBaseの定義後に定義)
+		void InitProfileRecord(AwaiterEntry::ProfileRecord& record, const IAwaiter* pAwaiter);
+#endif
 
 		using UpdaterID = uint64;
 
@@ -79,6 +189,12 @@ namespace cotasklib::Co
 		template <typename TResult>
 		class TaskAwaiter;
 
+		template <typename TResult>
+		class RegisteredTaskAwaiter;
+
+		template <typename F>
+		class RegisteredUpdater;
+
 		template <typename TResult>
 		struct FinishCallbackTypeTrait
 		{
@@ -98,6 +214,11 @@ namespace cotasklib::Co
 	template <typename TResult>
 	class Task;
 
+	template <typename F>
+	class Updater;
+
+	class MultiRunner;
+
 	class SceneBase;
 
 	using SceneFactory = std::function<std::unique_ptr<SceneBase>()>;
@@ -161,17 +282,194 @@ namespace cotasklib::Co
 		Debug = 255,
 	};
 
+	// Backendから直接実行されるタスクの優先度
+	enum class TaskPriority : uint8
+	{
+		// 最優先(UIなど)。毎フレーム、他の優先度のタスクより先に実行される
+		Critical,
+
+		// 通常(ゲームプレイなど)。毎フレーム実行される
+		Normal,
+
+		// バックグラウンド(読み込みやAIなど)。フレーム予算を使い切った場合は後続のフレームへ持ち越される
+		Background,
+	};
+
+	// 優先度ごとの実行の統計情報
+	struct TaskPriorityStats
+	{
+		// resumeされた回数
+		uint64 resumeCount = 0;
+
+		// フレーム予算を使い切ったため次のフレームへ持ち越された回数
+		uint64 deferCount = 0;
+
+		// 持ち越しが続いたため、フレーム予算を超えていても実行された回数
+		uint64 forcedResumeCount = 0;
+
+		// resumeに要した時間の合計(優先度を指定したタスクがあるか、フレーム予算を設定している場合のみ計測)
+		Duration totalResumeTime{ 0 };
+	};
+
+	// ワーカースレッドなどで実行中の処理へキャンセル要求を伝えるトークン
+	// (コピーしたトークン同士は状態を共有するため、別スレッドで実行する関数にはコピーを渡す)
+	class CancellationToken
+	{
+	private:
+		std::shared_ptr<std::atomic<bool>> m_pIsCancellationRequested = std::make_shared<std::atomic<bool>>(false);
+
+	public:
+		// 任意のスレッドから呼び出せる
+		[[nodiscard]]
+		bool isCancellationRequested() const noexcept
+		{
+			return m_pIsCancellationRequested->load(std::memory_order_relaxed);
+		}
+
+		// 任意のスレッドから呼び出せる
+		void requestCancel() const noexcept
+		{
+			m_pIsCancellationRequested->store(true, std::memory_order_relaxed);
+		}
+	};
+
+	// プロファイラの計測区間の種類
+	enum class ProfileZoneKind : uint8
+	{
+		// Backendから直接実行されているタスクの1回のresume
+		Task,
+
+		// 1つのレイヤーの描画
+		Layer,
+
+		// 1つのDrawerの描画
+		Drawer,
+	};
+
+	// プロファイラの計測区間
+	// (nameとfileNameは呼び出し中のみ有効)
+	struct ProfileZone
+	{
+		ProfileZoneKind kind;
+
+		StringView name;
+
+		// 計測対象を記述したソースファイル名とその行番号(不明な場合はnullptrと0)
+		const char* fileName = nullptr;
+		uint32 line = 0;
+	};
+
+	// プロファイラの計測結果の出力先
+	// (COTASKLIB_ENABLE_PROFILERを定義した場合のみ呼ばれる)
+	class IProfilerSink
+	{
+	public:
+		virtual ~IProfilerSink() = default;
+
+		// 計測区間の開始時に呼ばれる(timestampNanosecはstd::chrono::steady_clockの時刻)
+		virtual void beginZone(const ProfileZone& zone, uint64 timestampNanosec) = 0;
+
+		// 直近に開始した計測区間の終了時に呼ばれる
+		virtual void endZone(uint64 timestampNanosec) = 0;
+	};
+
+	// Backendから直接実行されているタスクの計測結果
+	struct TaskProfile
+	{
+		// Task::named()で指定した名前(指定していない場合は空文字列)
+		String name;
+
+		// Task::named()を呼び出したソースファイル名と行番号(指定していない場合は空文字列と0)
+		String fileName;
+		uint32 line = 0;
+
+		// resumeされた回数と、resumeに要した時間の合計
+		uint64 resumeCount = 0;
+		Duration totalResumeTime{ 0 };
+	};
+
+	// Backendから直接実行されているタスクの情報
+	struct LiveTaskInfo
+	{
+		// Task::named()で指定した名前と呼び出し位置(COTASKLIB_ENABLE_PROFILERを定義していない場合は常に空文字列と0)
+		String name{};
+		String fileName{};
+		uint32 line = 0;
+
+		// 実行開始からのupdate回数
+		uint64 ageUpdateCount = 0;
+
+		// 休止中(WaitForeverやDelayなどで毎フレームのresume対象から外れている状態)かどうか
+		bool isParked = false;
+
+		// コルーチンフレーム(子のタスクと並行タスクを含む)の数とバイト数
+		std::size_t frameCount = 0;
+		std::size_t frameBytes = 0;
+	};
+
+	// タスクに関するメモリ使用量の集計
+	struct MemoryCensus
+	{
+		// Backendから直接実行されているタスクの数と、そのうち休止中のタスクの数
+		std::size_t taskCount = 0;
+		std::size_t parkedTaskCount = 0;
+
+		// 実行中のタスクが保持しているコルーチンフレーム(子のタスクと並行タスクを含む)の数とバイト数
+		std::size_t frameCount = 0;
+		std::size_t frameBytes = 0;
+
+		// Task::with()で追加された並行タスクの数と、それらのコルーチンフレームおよび一覧の追加確保のバイト数
+		std::size_t companionCount = 0;
+		std::size_t companionBytes = 0;
+
+		// Backendがタスクの実行管理のために確保している配列のバイト数
+		std::size_t backendBytes = 0;
+
+		// 登録されているDrawerの数と、描画管理のために確保している配列のバイト数
+		std::size_t drawerCount = 0;
+		std::size_t drawerBytes = 0;
+	};
+
 	namespace detail
 	{
-		struct DrawerKey
+#ifdef COTASKLIB_ENABLE_PROFILER
+		[[nodiscard]]
+		inline uint64 ProfilerNowNanosec() noexcept
 		{
-			Layer layer;
-			int32 drawIndex;
-			DrawerID id;
+			return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
 
-			[[nodiscard]]
-			auto operator<=>(const DrawerKey&) const = default;
-		};
+		// プロファイラに表示する型名
+		// (GCC・Clangのマングルされた名前は復元し、MSVCの"class "・"struct "の接頭辞は取り除く)
+		[[nodiscard]]
+		inline String ProfileTypeName(const std::type_info& typeInfo)
+		{
+			const char* const rawName = typeInfo.name();
+#if __has_include(<cxxabi.h>)
+			int status = 0;
+			char* const demangledName = abi::__cxa_demangle(rawName, nullptr, nullptr, &status);
+			if (status == 0 && demangledName)
+			{
+				String name = Unicode::Widen(demangledName);
+				std::free(demangledName);
+				return name;
+			}
+			std::free(demangledName);
+			return Unicode::Widen(rawName);
+#else
+			String name = Unicode::Widen(rawName);
+			for (const StringView prefix : { StringView{ U"class " }, StringView{ U"struct " } })
+			{
+				if (name.starts_with(prefix))
+				{
+					name.erase(0, prefix.size());
+					break;
+				}
+			}
+			return name;
+#endif
+		}
+#endif
 
 		class IDrawerInternal
 		{
@@ -184,47 +482,170 @@ namespace cotasklib::Co
 		class DrawExecutor
 		{
 		private:
-			DrawerID m_nextID = 1;
-			std::map<DrawerKey, IDrawerInternal*> m_drawers;
-			std::unordered_map<DrawerID, DrawerKey> m_drawerKeyByID;
-			std::unordered_map<Layer, uint64> m_layerDrawerCount;
+			static constexpr std::size_t NumLayers = 256;
+
+			struct DrawerNode
+			{
+				int32 drawIndex;
+
+				// 同一drawIndex内では登録順に描画するための通し番号
+				uint64 sequence;
+
+				DrawerID id;
+
+				IDrawerInternal* pDrawer;
+
+				// falseの場合は登録したまま描画を省略する
+				bool isVisible = true;
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+				// プロファイラ用の名前(setDrawerProfileNameで指定されていない場合、描画時点では派生クラスの構築が完了しているため、初回の描画時に型名から取得する)
+				String profileName{};
+#endif
+			};
+
+			// レイヤーの描画結果のキャッシュ
+			struct LayerCache
+			{
+				RenderTexture texture;
+
+				// falseの場合は次回の描画時にDrawerを描画し直す
+				bool isValid = false;
+
+				// Drawerを描画し直した回数
+				uint64 renderCount = 0;
+			};
+
+			struct LayerDrawers
+			{
+				Array<DrawerNode> nodes;
+
+				// 追加・削除・drawIndex変更があった場合のみ、次回の描画前に並べ替える
+				bool isSortNeeded = false;
+
+				// キャッシュが有効なレイヤーのみ保持する
+				std::unique_ptr<LayerCache> pCache;
+			};
+
+			// DrawerIDの下位32bitはスロット番号、上位32bitはスロットの世代を表す
+			struct DrawerSlot
+			{
+				uint32 generation = 1;
+				uint32 nodeIndex = 0;
+				Layer layer = Layer::Default;
+				bool inUse = false;
+			};
+
+			std::array<LayerDrawers, NumLayers> m_layers;
+			Array<DrawerSlot> m_drawerSlots;
+			Array<uint32> m_freeDrawerSlotIndices;
+			uint64 m_nextSequence = 1;
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+			IProfilerSink* m_pProfilerSink = nullptr;
+
+			// 直近の描画でレイヤーごとに要した時間
+			std::array<uint64, NumLayers> m_lastLayerDrawNanosecs{};
+
+			std::array<String, NumLayers> m_layerProfileNames;
+#endif
+
+			[[nodiscard]]
+			static constexpr uint32 SlotIndexOf(DrawerID id) noexcept
+			{
+				return static_cast<uint32>(id & 0xFFFFFFFFull);
+			}
+
+			[[nodiscard]]
+			static constexpr uint32 GenerationOf(DrawerID id) noexcept
+			{
+				return static_cast<uint32>(id >> 32);
+			}
+
+			[[nodiscard]]
+			LayerDrawers& layerDrawers(Layer layer) noexcept
+			{
+				return m_layers[static_cast<uint8>(layer)];
+			}
 
 			[[nodiscard]]
-			auto findByID(DrawerID id)
+			DrawerSlot* findSlot(DrawerID id)
 			{
-				const auto it = m_drawerKeyByID.find(id);
-				if (it == m_drawerKeyByID.end())
+				const uint32 slotIndex = SlotIndexOf(id);
+				if (slotIndex >= m_drawerSlots.size())
+				{
+					return nullptr;
+				}
+				DrawerSlot& slot = m_drawerSlots[slotIndex];
+				if (!slot.inUse || slot.generation != GenerationOf(id))
 				{
-					return m_drawers.end();
+					return nullptr;
 				}
-				return m_drawers.find(it->second);
+				return &slot;
 			}
 
-			void incrementLayerDrawerCount(Layer layer)
+			static void InvalidateCache(LayerDrawers& drawers) noexcept
 			{
-				const auto it = m_layerDrawerCount.find(layer);
-				if (it == m_layerDrawerCount.end())
+				if (drawers.pCache)
 				{
-					m_layerDrawerCount.emplace(layer, 1);
+					drawers.pCache->isValid = false;
 				}
-				else
+			}
+
+			// キャッシュへの描画用のブレンドステート
+			// (Drawerの通常のアルファブレンドの描画結果を、乗算済みアルファとしてキャッシュへ書き込む。キャッシュはBlendState::Premultipliedで描画する)
+			[[nodiscard]]
+			static BlendState CacheBlendState() noexcept
+			{
+				BlendState blendState = BlendState::Default2D;
+				blendState.srcAlpha = Blend::One;
+				blendState.dstAlpha = Blend::InvSrcAlpha;
+				blendState.opAlpha = BlendOp::Add;
+				return blendState;
+			}
+
+			// ノードを末尾要素との入れ替えで取り除く(並び順は崩れるため並べ替えが必要になる)
+			[[nodiscard]]
+			DrawerNode detachNode(const DrawerSlot& slot)
+			{
+				LayerDrawers& drawers = layerDrawers(slot.layer);
+				InvalidateCache(drawers);
+				const DrawerNode node = drawers.nodes[slot.nodeIndex];
+				if (slot.nodeIndex != drawers.nodes.size() - 1)
 				{
-					++it->second;
+					drawers.nodes[slot.nodeIndex] = drawers.nodes.back();
+					m_drawerSlots[SlotIndexOf(drawers.nodes[slot.nodeIndex].id)].nodeIndex = slot.nodeIndex;
+					drawers.isSortNeeded = true;
 				}
+				drawers.nodes.pop_back();
+				return node;
 			}
 
-			void decrementLayerDrawerCount(Layer layer)
+			void attachNode(DrawerSlot& slot, Layer layer, const DrawerNode& node)
 			{
-				const auto it = m_layerDrawerCount.find(layer);
-				if (it == m_layerDrawerCount.end())
+				LayerDrawers& drawers = layerDrawers(layer);
+				InvalidateCache(drawers);
+				slot.layer = layer;
+				slot.nodeIndex = static_cast<uint32>(drawers.nodes.size());
+				if (!drawers.nodes.empty())
 				{
-					throw Error{ U"DrawExecutor::decrementLayerDrawerCount: Layer drawer count underflow (layer={})"_fmt(static_cast<uint8>(layer)) };
+					drawers.isSortNeeded = true;
 				}
-				if (it->second == 0)
+				drawers.nodes.push_back(node);
+			}
+
+			void sortLayer(LayerDrawers& drawers)
+			{
+				std::sort(drawers.nodes.begin(), drawers.nodes.end(),
+					[](const DrawerNode& a, const DrawerNode& b)
+					{
+						return a.drawIndex != b.drawIndex ? a.drawIndex < b.drawIndex : a.sequence < b.sequence;
+					});
+				for (std::size_t i = 0; i < drawers.nodes.size(); ++i)
 				{
-					throw Error{ U"DrawExecutor::decrementLayerDrawerCount: Layer drawer count underflow (layer={})"_fmt(static_cast<uint8>(layer)) };
+					m_drawerSlots[SlotIndexOf(drawers.nodes[i].id)].nodeIndex = static_cast<uint32>(i);
 				}
-				--it->second;
+				drawers.isSortNeeded = false;
 			}
 
 		public:
@@ -232,436 +653,3011 @@ namespace cotasklib::Co
 
 			DrawerID add(Layer layer, int32 drawIndex, IDrawerInternal* pDrawable)
 			{
-				const DrawerID id = m_nextID++;
-				DrawerKey key{ layer, drawIndex, id };
-				const auto [it, inserted] = m_drawers.try_emplace(key, pDrawable);
-				if (!inserted)
+				uint32 slotIndex;
+				if (m_freeDrawerSlotIndices.empty())
+				{
+					slotIndex = static_cast<uint32>(m_drawerSlots.size());
+					m_drawerSlots.emplace_back();
+				}
+				else
 				{
-					throw Error{ U"DrawExecutor::add: ID={} already exists"_fmt(id) };
+					slotIndex = m_freeDrawerSlotIndices.back();
+					m_freeDrawerSlotIndices.pop_back();
 				}
-				m_drawerKeyByID.emplace(id, std::move(key));
-				incrementLayerDrawerCount(layer);
+
+				DrawerSlot& slot = m_drawerSlots[slotIndex];
+				slot.inUse = true;
+				const DrawerID id = (static_cast<DrawerID>(slot.generation) << 32) | slotIndex;
+				attachNode(slot, layer, DrawerNode{ drawIndex, m_nextSequence++, id, pDrawable });
 				return id;
 			}
 
 			void setDrawerLayer(DrawerID id, Layer layer)
 			{
-				const auto it = findByID(id);
-				if (it == m_drawers.end())
+				DrawerSlot* const pSlot = findSlot(id);
+				if (!pSlot)
 				{
-					throw Error{ U"DrawExecutor::remove: ID={} not found"_fmt(id) };
+					throw Error{ U"DrawExecutor::setDrawerLayer: ID={} not found"_fmt(id) };
 				}
-				if (it->first.layer == layer)
+				if (pSlot->layer == layer)
 				{
 					return;
 				}
-				const auto prevLayer = it->first.layer;
-
-				// 一度削除して再挿入
-				DrawerKey newKey = it->first;
-				newKey.layer = layer;
-				const auto pDrawable = it->second;
-				m_drawers.erase(it);
-				m_drawerKeyByID.erase(id);
-				m_drawers.emplace(newKey, pDrawable);
-				m_drawerKeyByID.emplace(id, std::move(newKey));
-
-				decrementLayerDrawerCount(prevLayer);
-				incrementLayerDrawerCount(layer);
+				attachNode(*pSlot, layer, detachNode(*pSlot));
 			}
 
 			void setDrawerDrawIndex(DrawerID id, int32 drawIndex)
 			{
-				const auto it = findByID(id);
-				if (it == m_drawers.end())
+				DrawerSlot* const pSlot = findSlot(id);
+				if (!pSlot)
 				{
-					throw Error{ U"DrawExecutor::remove: ID={} not found"_fmt(id) };
+					throw Error{ U"DrawExecutor::setDrawerDrawIndex: ID={} not found"_fmt(id) };
 				}
-				if (it->first.drawIndex == drawIndex)
+				LayerDrawers& drawers = layerDrawers(pSlot->layer);
+				DrawerNode& node = drawers.nodes[pSlot->nodeIndex];
+				if (node.drawIndex == drawIndex)
 				{
 					return;
 				}
 
-				// 一度削除して再挿入
-				DrawerKey newKey = it->first;
-				newKey.drawIndex = drawIndex;
-				const auto pDrawable = it->second;
-				m_drawers.erase(it);
-				m_drawers.emplace(newKey, pDrawable);
-				m_drawerKeyByID[id].drawIndex = drawIndex;
+				// 再挿入はせず値だけ書き換え、次回の描画前にまとめて並べ替える
+				node.drawIndex = drawIndex;
+				drawers.isSortNeeded = true;
+				InvalidateCache(drawers);
 			}
 
-			void remove(DrawerID id)
+			void setDrawerVisible(DrawerID id, bool isVisible)
 			{
-				const auto it = findByID(id);
-				if (it == m_drawers.end())
+				DrawerSlot* const pSlot = findSlot(id);
+				if (!pSlot)
 				{
-					throw Error{ U"DrawExecutor::remove: ID={} not found"_fmt(id) };
+					throw Error{ U"DrawExecutor::setDrawerVisible: ID={} not found"_fmt(id) };
 				}
-				decrementLayerDrawerCount(it->first.layer);
-				m_drawers.erase(it);
-				m_drawerKeyByID.erase(id);
+				LayerDrawers& drawers = layerDrawers(pSlot->layer);
+				DrawerNode& node = drawers.nodes[pSlot->nodeIndex];
+				if (node.isVisible == isVisible)
+				{
+					return;
+				}
+				node.isVisible = isVisible;
+				InvalidateCache(drawers);
 			}
+#ifdef COTASKLIB_ENABLE_PROFILER
 
-			void execute() const
+			void setDrawerProfileName(DrawerID id, StringView name)
 			{
-				for (const auto& [key, pDrawer] : m_drawers)
+				DrawerSlot* const pSlot = findSlot(id);
+				if (!pSlot)
 				{
-					pDrawer->drawInternal();
+					throw Error{ U"DrawExecutor::setDrawerProfileName: ID={} not found"_fmt(id) };
 				}
+				layerDrawers(pSlot->layer).nodes[pSlot->nodeIndex].profileName = name;
 			}
+#endif
 
-			[[nodiscard]]
-			bool drawerExistsInLayer(Layer layer) const
+			// レイヤーの描画結果をキャッシュするかどうかを設定する
+			// (キャッシュしたレイヤーは、無効化されるまでDrawerを呼ばずに前回の描画結果のテクスチャを描画する)
+			void setLayerCached(Layer layer, bool isCached)
 			{
-				const auto it = m_layerDrawerCount.find(layer);
-				if (it == m_layerDrawerCount.end())
+				LayerDrawers& drawers = layerDrawers(layer);
+				if (!isCached)
 				{
-					return false;
+					drawers.pCache.reset();
+				}
+				else if (!drawers.pCache)
+				{
+					drawers.pCache = std::make_unique<LayerCache>();
 				}
-				return it->second > 0;
 			}
-		};
 
-		class Backend
-		{
-		private:
-			static constexpr StringView AddonName{ U"Co::BackendAddon" };
+			[[nodiscard]]
+			bool isLayerCached(Layer layer) const noexcept
+			{
+				return m_layers[static_cast<uint8>(layer)].pCache != nullptr;
+			}
 
-			static inline Backend* s_pInstance = nullptr;
+			void invalidateLayerCache(Layer layer) noexcept
+			{
+				InvalidateCache(layerDrawers(layer));
+			}
 
-			// Note: draw関数がconstであることの対処用にアドオンと実体を分離し、実体はポインタで持つようにしている
-			class BackendAddon : public IAddon
+			// キャッシュのためにレイヤーのDrawerを描画し直した回数(キャッシュが無効の場合は0)
+			[[nodiscard]]
+			uint64 layerCacheRenderCount(Layer layer) const noexcept
 			{
-			private:
-				std::unique_ptr<Backend> m_instance;
+				const auto& pCache = m_layers[static_cast<uint8>(layer)].pCache;
+				return pCache ? pCache->renderCount : 0;
+			}
 
-			public:
-				BackendAddon()
-					: m_instance{ std::make_unique<Backend>() }
+			void remove(DrawerID id)
+			{
+				DrawerSlot* const pSlot = findSlot(id);
+				if (!pSlot)
 				{
-					if (s_pInstance)
-					{
-						throw Error{ U"Co::BackendAddon: Instance already exists" };
-					}
-					s_pInstance = m_instance.get();
+					throw Error{ U"DrawExecutor::remove: ID={} not found"_fmt(id) };
+				}
+				(void)detachNode(*pSlot);
+				pSlot->inUse = false;
+				if (++pSlot->generation == 0)
+				{
+					pSlot->generation = 1;
 				}
+				m_freeDrawerSlotIndices.push_back(SlotIndexOf(id));
+			}
 
-				virtual ~BackendAddon()
+		private:
+			void drawNodes(LayerDrawers& drawers)
+			{
+				// Note: 描画中にDrawerが追加・削除される場合を考慮し、インデックスでアクセスする
+				for (std::size_t i = 0; i < drawers.nodes.size(); ++i)
 				{
-					if (s_pInstance == m_instance.get())
+					if (!drawers.nodes[i].isVisible)
 					{
-						s_pInstance = nullptr;
+						continue;
+					}
+#ifdef COTASKLIB_ENABLE_PROFILER
+					if (m_pProfilerSink)
+					{
+						drawNodeProfiled(drawers.nodes[i]);
+						continue;
 					}
+#endif
+					drawers.nodes[i].pDrawer->drawInternal();
 				}
+			}
+#ifdef COTASKLIB_ENABLE_PROFILER
 
-				virtual bool update() override
+			void drawNodeProfiled(DrawerNode& node)
+			{
+				if (node.profileName.isEmpty())
 				{
-					m_instance->update();
-					return true;
+					node.profileName = ProfileTypeName(typeid(*node.pDrawer));
 				}
+				m_pProfilerSink->beginZone(ProfileZone{ .kind = ProfileZoneKind::Drawer, .name = node.profileName }, ProfilerNowNanosec());
+				node.pDrawer->drawInternal();
+				m_pProfilerSink->endZone(ProfilerNowNanosec());
+			}
 
-				virtual void draw() const override
+			// レイヤーを描画し、要した時間を記録する
+			void drawLayerProfiled(std::size_t layerIndex)
+			{
+				const uint64 layerBeginNanosec = ProfilerNowNanosec();
+				if (m_pProfilerSink)
 				{
-					m_instance->draw();
+					if (m_layerProfileNames[layerIndex].isEmpty())
+					{
+						m_layerProfileNames[layerIndex] = U"Layer {}"_fmt(layerIndex);
+					}
+					m_pProfilerSink->beginZone(ProfileZone{ .kind = ProfileZoneKind::Layer, .name = m_layerProfileNames[layerIndex] }, layerBeginNanosec);
 				}
 
-				[[nodiscard]]
-				Backend* instance() const
+				drawLayer(m_layers[layerIndex]);
+
+				const uint64 layerEndNanosec = ProfilerNowNanosec();
+				m_lastLayerDrawNanosecs[layerIndex] = layerEndNanosec - layerBeginNanosec;
+				if (m_pProfilerSink)
 				{
-					return m_instance.get();
+					m_pProfilerSink->endZone(layerEndNanosec);
 				}
-			};
+			}
+#endif
 
-			AwaiterID m_nextAwaiterID = 1;
+			void drawLayer(LayerDrawers& drawers)
+			{
+				if (drawers.isSortNeeded)
+				{
+					sortLayer(drawers);
+				}
 
-			Optional<AwaiterID> m_currentAwaiterID = none;
+				if (!drawers.pCache)
+				{
+					drawNodes(drawers);
+					return;
+				}
 
-			bool m_currentAwaiterRemovalNeeded = false;
+				// キャッシュが無効な場合のみDrawerを描画し直し、それ以外はテクスチャ1枚の描画のみとする
+				LayerCache& cache = *drawers.pCache;
+				if (!cache.isValid || cache.texture.size() != Scene::Size())
+				{
+					if (cache.texture.size() != Scene::Size())
+					{
+						cache.texture = RenderTexture{ Scene::Size() };
+					}
+					cache.texture.clear(ColorF{ 0.0, 0.0 });
+
+					// Note: 描画中に無効化された場合は次回の描画で描画し直すため、先に有効にしておく
+					cache.isValid = true;
+					++cache.renderCount;
+					{
+						const ScopedRenderTarget2D renderTarget{ cache.texture };
+						const ScopedRenderStates2D renderStates{ CacheBlendState() };
+						drawNodes(drawers);
+					}
+				}
 
-			std::map<AwaiterID, AwaiterEntry> m_awaiterEntries;
+				// Note: キャッシュの色は乗算済みアルファのため、通常のアルファブレンドで描画すると不透明度が二重に掛かる
+				const ScopedRenderStates2D renderStates{ BlendState::Premultiplied };
+				cache.texture.draw();
+			}
 
-			DrawExecutor m_drawExecutor;
+		public:
+			void execute()
+			{
+				for (std::size_t layerIndex = 0; layerIndex < NumLayers; ++layerIndex)
+				{
+					LayerDrawers& drawers = m_layers[layerIndex];
+					if (drawers.nodes.empty())
+					{
+#ifdef COTASKLIB_ENABLE_PROFILER
+						m_lastLayerDrawNanosecs[layerIndex] = 0;
+#endif
+						continue;
+					}
+#ifdef COTASKLIB_ENABLE_PROFILER
+					drawLayerProfiled(layerIndex);
+#else
+					drawLayer(drawers);
+#endif
+				}
+			}
+#ifdef COTASKLIB_ENABLE_PROFILER
 
-			SceneFactory m_currentSceneFactory;
+			void setProfilerSink(IProfilerSink* pProfilerSink) noexcept
+			{
+				m_pProfilerSink = pProfilerSink;
+			}
+
+			[[nodiscard]]
+			uint64 lastLayerDrawNanosec(Layer layer) const noexcept
+			{
+				return m_lastLayerDrawNanosecs[static_cast<uint8>(layer)];
+			}
+#endif
+
+			[[nodiscard]]
+			bool drawerExistsInLayer(Layer layer) const
+			{
+				return !m_layers[static_cast<uint8>(layer)].nodes.empty();
+			}
+
+			[[nodiscard]]
+			std::size_t drawerCount() const noexcept
+			{
+				std::size_t count = 0;
+				for (const LayerDrawers& drawers : m_layers)
+				{
+					count += drawers.nodes.size();
+				}
+				return count;
+			}
+
+			[[nodiscard]]
+			std::size_t allocatedBytes() const noexcept
+			{
+				std::size_t bytes = m_drawerSlots.capacity() * sizeof(DrawerSlot) + m_freeDrawerSlotIndices.capacity() * sizeof(uint32);
+				for (const LayerDrawers& drawers : m_layers)
+				{
+					bytes += drawers.nodes.capacity() * sizeof(DrawerNode);
+				}
+				return bytes;
+			}
+		};
+
+		class Backend;
+
+		// 通知により起床する休止可能な待機対象
+		// (Backendから直接実行されていない場合は休止せず、毎フレームのresume時に待機側が条件を確認する)
+		class SignalSleeper : public ISleeper
+		{
+		private:
+			AwaiterID m_parkedID = 0;
+			uint32 m_parkSerial = 0;
+			bool m_isParked = false;
+
+			// 休止させたBackend(通知時点の実行先ではなく、このBackendを起床させる)
+			std::weak_ptr<Backend> m_pParkedBackend;
 
 		public:
-			Backend() = default;
+			[[nodiscard]]
+			WakeCondition wakeCondition() const override
+			{
+				return WakeNever{};
+			}
 
-			void update()
+			void onWake(uint64) override
 			{
-				std::exception_ptr exceptionPtr;
-				for (auto it = m_awaiterEntries.begin(); it != m_awaiterEntries.end();)
+				m_isParked = false;
+			}
+
+			void onPark(AwaiterID id, uint32 parkSerial) override;
+
+			void notify();
+		};
+
+		// ワーカースレッドで完了した処理の通知ノード
+		class ICompletionNode
+		{
+		private:
+			friend class CompletionQueue;
+
+			ICompletionNode* m_pNextCompletion = nullptr;
+
+		public:
+			virtual ~ICompletionNode() = default;
+
+			// メインスレッドで完了を受け取る
+			virtual void onCompleted() = 0;
+
+			// キューが保持していた参照を解放する
+			virtual void release() noexcept = 0;
+		};
+
+		// ワーカースレッドからメインスレッドへ完了を通知するロックフリーのキュー(複数の書き込み側・単一の読み出し側)
+		// (書き込み側はCASで先頭へ積み、読み出し側は全件をまとめて取り出してから積まれた順へ並べ直す)
+		class CompletionQueue
+		{
+		private:
+			std::atomic<ICompletionNode*> m_pHead = nullptr;
+
+			[[nodiscard]]
+			ICompletionNode* takeAllInPushedOrder() noexcept
+			{
+				ICompletionNode* pNode = m_pHead.exchange(nullptr, std::memory_order_acquire);
+				ICompletionNode* pReversed = nullptr;
+				while (pNode)
 				{
-					m_currentAwaiterID = it->first;
+					ICompletionNode* const pNext = pNode->m_pNextCompletion;
+					pNode->m_pNextCompletion = pReversed;
+					pReversed = pNode;
+					pNode = pNext;
+				}
+				return pReversed;
+			}
 
-					const auto& entry = it->second;
-					entry.awaiter->resume();
-					if (m_currentAwaiterRemovalNeeded || entry.awaiter->done())
-					{
-						try
-						{
-							entry.callEndCallback();
-						}
-						catch (...)
-						{
-							if (!exceptionPtr)
-							{
-								exceptionPtr = std::current_exception();
-							}
-						}
-						it = m_awaiterEntries.erase(it);
-						m_currentAwaiterRemovalNeeded = false;
-					}
-					else
+		public:
+			CompletionQueue() = default;
+
+			CompletionQueue(const CompletionQueue&) = delete;
+
+			CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+			~CompletionQueue()
+			{
+				// 通知されずに残ったノードは参照の解放のみ行う
+				ICompletionNode* pNode = takeAllInPushedOrder();
+				while (pNode)
+				{
+					ICompletionNode* const pNext = pNode->m_pNextCompletion;
+					pNode->release();
+					pNode = pNext;
+				}
+			}
+
+			// 任意のスレッドから呼び出せる
+			void push(ICompletionNode* pNode) noexcept
+			{
+				ICompletionNode* pHead = m_pHead.load(std::memory_order_relaxed);
+				do
+				{
+					pNode->m_pNextCompletion = pHead;
+				} while (!m_pHead.compare_exchange_weak(pHead, pNode, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			// メインスレッドからのみ呼び出す
+			std::size_t drain()
+			{
+				std::size_t count = 0;
+				ICompletionNode* pNode = takeAllInPushedOrder();
+				while (pNode)
+				{
+					ICompletionNode* const pNext = pNode->m_pNextCompletion;
+					pNode->onCompleted();
+					pNode->release();
+					pNode = pNext;
+					++count;
+				}
+				return count;
+			}
+		};
+
+		class WaiterList;
+
+		// WaiterListへ登録するためのノード(待機側のコルーチンフレーム内に置く)
+		class WaiterNode
+		{
+		private:
+			friend class WaiterList;
+
+			WaiterList* m_pList = nullptr;
+			WaiterNode* m_pPrev = nullptr;
+			WaiterNode* m_pNext = nullptr;
+			SignalSleeper* m_pSleeper = nullptr;
+
+		public:
+			WaiterNode() = default;
+
+			WaiterNode(const WaiterNode&) = delete;
+
+			WaiterNode& operator=(const WaiterNode&) = delete;
+
+			WaiterNode(WaiterNode&&) = delete;
+
+			WaiterNode& operator=(WaiterNode&&) = delete;
+
+			~WaiterNode()
+			{
+				unlink();
+			}
+
+			void unlink() noexcept;
+		};
+
+		// 通知を待つSignalSleeperの侵入型リスト
+		class WaiterList
+		{
+		private:
+			friend class WaiterNode;
+
+			WaiterNode* m_pHead = nullptr;
+
+		public:
+			WaiterList() = default;
+
+			WaiterList(const WaiterList&) = delete;
+
+			WaiterList& operator=(const WaiterList&) = delete;
+
+			WaiterList(WaiterList&& rhs) noexcept
+				: m_pHead(rhs.m_pHead)
+			{
+				rhs.m_pHead = nullptr;
+				for (WaiterNode* pNode = m_pHead; pNode; pNode = pNode->m_pNext)
+				{
+					pNode->m_pList = this;
+				}
+			}
+
+			// Note: 代入先に登録されていた待機は、破棄時と同様に通知せず登録だけ解除する
+			WaiterList& operator=(WaiterList&& rhs) noexcept
+			{
+				if (this != &rhs)
+				{
+					unlinkAll();
+					m_pHead = std::exchange(rhs.m_pHead, nullptr);
+					for (WaiterNode* pNode = m_pHead; pNode; pNode = pNode->m_pNext)
 					{
-						++it;
+						pNode->m_pList = this;
 					}
 				}
-				m_currentAwaiterID.reset();
-				if (exceptionPtr)
+				return *this;
+			}
+
+			~WaiterList()
+			{
+				// Note: 破棄時は通知せず登録だけ解除する(待機側は削除されるまで休止したままとなる)
+				unlinkAll();
+			}
+
+			void unlinkAll() noexcept
+			{
+				while (m_pHead)
 				{
-					std::rethrow_exception(exceptionPtr);
+					m_pHead->unlink();
 				}
 			}
 
-			void draw()
+			void push(WaiterNode& node, SignalSleeper* pSleeper) noexcept
 			{
-				m_drawExecutor.execute();
+				if (node.m_pList == this)
+				{
+					return;
+				}
+				node.unlink();
+				node.m_pList = this;
+				node.m_pSleeper = pSleeper;
+				node.m_pNext = m_pHead;
+				if (m_pHead)
+				{
+					m_pHead->m_pPrev = &node;
+				}
+				m_pHead = &node;
 			}
 
-			static void Init()
+			// 登録されている全ての待機に通知する(通知した待機は登録を解除するため、再度待つ場合は登録し直す)
+			void notifyAll()
 			{
-				Addon::Register(AddonName, std::make_unique<BackendAddon>());
+				while (m_pHead)
+				{
+					SignalSleeper* const pSleeper = m_pHead->m_pSleeper;
+					m_pHead->unlink();
+					pSleeper->notify();
+				}
 			}
 
-			template <typename TResult>
 			[[nodiscard]]
-			static AwaiterID Add(std::unique_ptr<TaskAwaiter<TResult>>&& awaiter, FinishCallbackType<TResult> finishCallback, std::function<void()> cancelCallback)
+			bool empty() const noexcept
 			{
-				if (!awaiter)
+				return m_pHead == nullptr;
+			}
+		};
+
+		inline void WaiterNode::unlink() noexcept
+		{
+			if (!m_pList)
+			{
+				return;
+			}
+			if (m_pPrev)
+			{
+				m_pPrev->m_pNext = m_pNext;
+			}
+			else
+			{
+				m_pList->m_pHead = m_pNext;
+			}
+			if (m_pNext)
+			{
+				m_pNext->m_pPrev = m_pPrev;
+			}
+			m_pList = nullptr;
+			m_pPrev = nullptr;
+			m_pNext = nullptr;
+		}
+
+		// 領域へのマウス入力を待つ待機の種類
+		enum class InputWaitKind : uint8
+		{
+			LeftClicked,
+			LeftReleased,
+			RightClicked,
+			RightReleased,
+			MouseOver,
+		};
+
+		class InputRouter;
+
+		// InputRouterへ登録する、領域へのマウス入力を待つ待機のノード(待機側のコルーチンフレーム内に置く)
+		class InputWaiterNode
+		{
+		private:
+			friend class InputRouter;
+
+			const void* m_pArea;
+			bool (*m_fnMouseOver)(const void*);
+			RectF m_bounds;
+			bool m_isBounded;
+			Layer m_layer;
+			InputWaitKind m_kind;
+			SignalSleeper* m_pSleeper;
+
+			// 登録したグリッドのセルの範囲(境界が不明な場合や大きすぎる場合はグリッドに登録しない)
+			bool m_isInGrid = false;
+			Point m_cellMin{ 0, 0 };
+			Point m_cellMax{ 0, 0 };
+
+			bool m_isRegistered = false;
+
+		public:
+			template <class TArea>
+			InputWaiterNode(const TArea* pArea, Layer layer, InputWaitKind kind, SignalSleeper* pSleeper)
+				: m_pArea(pArea)
+				, m_fnMouseOver([](const void* p) -> bool { return static_cast<const TArea*>(p)->mouseOver(); })
+				, m_bounds(0, 0, 0, 0)
+				, m_isBounded(false)
+				, m_layer(layer)
+				, m_kind(kind)
+				, m_pSleeper(pSleeper)
+			{
+				if constexpr (std::is_convertible_v<TArea, RectF>)
 				{
-					throw Error{ U"awaiter must not be nullptr" };
+					m_bounds = RectF{ *pArea };
+					m_isBounded = true;
+				}
+				else if constexpr (requires { RectF{ pArea->boundingRect() }; })
+				{
+					m_bounds = RectF{ pArea->boundingRect() };
+					m_isBounded = true;
+				}
+			}
+
+			InputWaiterNode(const InputWaiterNode&) = delete;
+
+			InputWaiterNode& operator=(const InputWaiterNode&) = delete;
+
+			InputWaiterNode(InputWaiterNode&&) = delete;
+
+			InputWaiterNode& operator=(InputWaiterNode&&) = delete;
+
+			// Backendの定義後に定義
+			~InputWaiterNode();
+		};
+
+		// 領域へのマウス入力を待つ待機を空間グリッドで管理し、カーソルが当たった待機のみを起床させる
+		// (カーソル位置とボタンの状態が変化したフレームのみ、カーソル位置のセルに登録された待機を調べる)
+		class InputRouter
+		{
+		private:
+			static constexpr double CellSize = 64.0;
+
+			// 1つの待機が登録されるセル数の上限(超える場合はグリッド外の一覧に登録する)
+			static constexpr int32 MaxCellsPerNode = 64;
+
+			struct Blocker
+			{
+				uint64 id;
+				Layer layer;
+				Optional<RectF> area;
+			};
+
+			HashTable<uint64, Array<InputWaiterNode*>> m_cells;
+
+			// グリッドに登録しない待機
+			Array<InputWaiterNode*> m_unboundedNodes;
+
+			std::size_t m_nodeCount = 0;
+
+			Array<Blocker> m_blockers;
+
+			uint64 m_nextBlockerID = 1;
+
+			Optional<Vec2> m_lastCursorPos;
+
+			// カーソル位置とボタンの状態が変化していなくても、次回のdispatchで調べる必要があるかどうか
+			bool m_isQueryRequested = false;
+
+			Array<InputWaiterNode*> m_hitNodes;
+
+			uint64 m_queryCount = 0;
+
+			uint64 m_hitTestCount = 0;
+
+			[[nodiscard]]
+			static Point CellOf(const Vec2& pos) noexcept
+			{
+				return Point{ static_cast<int32>(Math::Floor(pos.x / CellSize)), static_cast<int32>(Math::Floor(pos.y / CellSize)) };
+			}
+
+			[[nodiscard]]
+			static constexpr uint64 CellKey(int32 x, int32 y) noexcept
+			{
+				return (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y);
+			}
+
+			[[nodiscard]]
+			static bool IsTriggered(InputWaitKind kind)
+			{
+				switch (kind)
+				{
+				case InputWaitKind::LeftClicked:
+					return MouseL.down();
+				case InputWaitKind::LeftReleased:
+					return MouseL.up();
+				case InputWaitKind::RightClicked:
+					return MouseR.down();
+				case InputWaitKind::RightReleased:
+					return MouseR.up();
+				default:
+					return true;
 				}
+			}
 
+			static void RemoveFrom(Array<InputWaiterNode*>& nodes, InputWaiterNode* pNode)
+			{
+				const auto it = std::find(nodes.begin(), nodes.end(), pNode);
+				if (it != nodes.end())
+				{
+					*it = nodes.back();
+					nodes.pop_back();
+				}
+			}
+
+		public:
+			InputRouter() = default;
+
+			InputRouter(const InputRouter&) = delete;
+
+			InputRouter& operator=(const InputRouter&) = delete;
+
+			void add(InputWaiterNode& node)
+			{
+				if (node.m_isRegistered)
+				{
+					return;
+				}
+				node.m_isRegistered = true;
+				++m_nodeCount;
+
+				if (node.m_isBounded)
+				{
+					const Point cellMin = CellOf(node.m_bounds.tl());
+					const Point cellMax = CellOf(node.m_bounds.br());
+					if (static_cast<int64>(cellMax.x - cellMin.x + 1) * (cellMax.y - cellMin.y + 1) <= MaxCellsPerNode)
+					{
+						node.m_isInGrid = true;
+						node.m_cellMin = cellMin;
+						node.m_cellMax = cellMax;
+						for (int32 y = cellMin.y; y <= cellMax.y; ++y)
+						{
+							for (int32 x = cellMin.x; x <= cellMax.x; ++x)
+							{
+								m_cells[CellKey(x, y)].push_back(&node);
+							}
+						}
+						return;
+					}
+				}
+				node.m_isInGrid = false;
+				m_unboundedNodes.push_back(&node);
+			}
+
+			void remove(InputWaiterNode& node)
+			{
+				if (!node.m_isRegistered)
+				{
+					return;
+				}
+				node.m_isRegistered = false;
+				--m_nodeCount;
+
+				if (!node.m_isInGrid)
+				{
+					RemoveFrom(m_unboundedNodes, &node);
+					return;
+				}
+				for (int32 y = node.m_cellMin.y; y <= node.m_cellMax.y; ++y)
+				{
+					for (int32 x = node.m_cellMin.x; x <= node.m_cellMax.x; ++x)
+					{
+						const auto it = m_cells.find(CellKey(x, y));
+						if (it == m_cells.end())
+						{
+							continue;
+						}
+						RemoveFrom(it->second, &node);
+						if (it->second.empty())
+						{
+							m_cells.erase(it);
+						}
+					}
+				}
+			}
+
+			[[nodiscard]]
+			uint64 addBlocker(Layer layer, const Optional<RectF>& area)
+			{
+				const uint64 id = m_nextBlockerID++;
+				m_blockers.push_back(Blocker{ .id = id, .layer = layer, .area = area });
+				m_isQueryRequested = true;
+				return id;
+			}
+
+			void removeBlocker(uint64 id)
+			{
+				m_blockers.remove_if([id](const Blocker& blocker) { return blocker.id == id; });
+
+				// 遮られていた待機はカーソルが動かなくても当たる可能性があるため、次回のdispatchで調べる
+				m_isQueryRequested = true;
+			}
+
+			// 指定レイヤーより上のレイヤーの遮断領域がカーソル位置を覆っているかどうか
+			[[nodiscard]]
+			bool isBlocked(Layer layer, const Vec2& cursorPos) const
+			{
+				for (const Blocker& blocker : m_blockers)
+				{
+					if (blocker.layer > layer && (!blocker.area || blocker.area->intersects(cursorPos)))
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// カーソル位置とボタンの状態が変化した場合のみ、カーソルが当たった待機を起床させる
+			void dispatch()
+			{
+				const Vec2 cursorPos = Cursor::PosF();
+				const bool isButtonChanged = MouseL.down() || MouseL.up() || MouseR.down() || MouseR.up();
+				if (!isButtonChanged && !m_isQueryRequested && m_lastCursorPos == cursorPos)
+				{
+					return;
+				}
+				m_lastCursorPos = cursorPos;
+				m_isQueryRequested = false;
+				if (m_nodeCount == 0)
+				{
+					return;
+				}
+				++m_queryCount;
+
+				const auto fnTest = [&](InputWaiterNode* pNode)
+					{
+						if (!IsTriggered(pNode->m_kind) || isBlocked(pNode->m_layer, cursorPos))
+						{
+							return;
+						}
+						if (pNode->m_isBounded && !pNode->m_bounds.intersects(cursorPos))
+						{
+							return;
+						}
+						++m_hitTestCount;
+						if (pNode->m_fnMouseOver(pNode->m_pArea))
+						{
+							m_hitNodes.push_back(pNode);
+						}
+					};
+
+				const Point cell = CellOf(cursorPos);
+				if (const auto it = m_cells.find(CellKey(cell.x, cell.y)); it != m_cells.end())
+				{
+					for (InputWaiterNode* pNode : it->second)
+					{
+						fnTest(pNode);
+					}
+				}
+				for (InputWaiterNode* pNode : m_unboundedNodes)
+				{
+					fnTest(pNode);
+				}
+
+				// Note: 起床したエントリは同じupdate内で実行され、待機側が改めて条件を確認する
+				for (InputWaiterNode* pNode : m_hitNodes)
+				{
+					pNode->m_pSleeper->notify();
+				}
+				m_hitNodes.clear();
+			}
+
+			[[nodiscard]]
+			std::size_t nodeCount() const noexcept
+			{
+				return m_nodeCount;
+			}
+
+			[[nodiscard]]
+			uint64 queryCount() const noexcept
+			{
+				return m_queryCount;
+			}
+
+			[[nodiscard]]
+			uint64 hitTestCount() const noexcept
+			{
+				return m_hitTestCount;
+			}
+		};
+
+		// MultiRunnerが要素の完了をBackendから通知してもらうための状態
+		// (Backend側は弱参照で保持するため、MultiRunnerが先に破棄されても問題ない)
+		struct RunnerTracker
+		{
+			// 追跡中の未完了の実行数
+			std::size_t liveCount = 0;
+
+			// 完了した要素のMultiRunner上の添字(重複を含みうる)
+			// (MultiRunnerは完了済みの要素を取り除く際に全要素を走査せず、この一覧の要素のみを確認する)
+			Array<uint32> finishedIndices;
+
+			// 完了済みの要素の自動削除が有効なMultiRunner(要素の完了を通知したBackendが、updateの終了時に取り除く)
+			MultiRunner* pAutoRemoveOwner = nullptr;
+
+			// Backendの自動削除の待ち行列に積まれているかどうか
+			bool isAutoRemoveQueued = false;
+
+			// 要素の完了・追加を待つ待機
+			WaiterList waiters;
+
+			RunnerTracker() = default;
+
+			explicit RunnerTracker(WaiterList&& waiters) noexcept
+				: waiters(std::move(waiters))
+			{
+			}
+
+			void onFinished(uint32 index)
+			{
+				--liveCount;
+				finishedIndices.push_back(index);
+				waiters.notifyAll();
+			}
+		};
+
+		// MultiRunnerの完了済みの要素を取り除く(MultiRunnerの定義後に定義)
+		void RemoveDoneRunners(MultiRunner& mr);
+
+		// TaskGroupの状態
+		// (Backendのスロットからも共有されるため、所属するタスクより先に破棄されることはない)
+		// 一時停止中に実行順が回ってきた所属タスクは、このオブジェクトを待機対象として休止させ、以降の毎フレームのresume対象から外す
+		class TaskGroupState : public ISleeper, public ISteadyClock
+		{
+		private:
+			bool m_isPaused = false;
+
+			double m_timeScale = 1.0;
+
+			// 元になる時計(nullptrの場合はScene::Time())
+			ISteadyClock* m_pSourceClock;
+
+			double m_elapsedMicrosec = 0.0;
+
+			double m_lastSourceMicrosec;
+
+			[[nodiscard]]
+			double sourceMicrosec() const;
+
+			// 前回から経過した時間を、一時停止中でなければ時間スケールを掛けて加算する
+			void advance();
+
+		public:
+			// 所属するタスク(Backendのスロットが添字を保持し、削除時に末尾と入れ替えて取り除く)
+			Array<AwaiterID> memberIDs;
+
+			explicit TaskGroupState(ISteadyClock* pSourceClock);
+
+			[[nodiscard]]
+			WakeCondition wakeCondition() const override
+			{
+				return WakeNever{};
+			}
+
+			void onWake(uint64) override
+			{
+				// 一時停止中はresumeしないため、省略したupdate回数の分を進める必要はない
+			}
+
+			// 時間スケールと一時停止を反映した経過時間
+			uint64 getMicrosec() override
+			{
+				advance();
+				return static_cast<uint64>(m_elapsedMicrosec);
+			}
+
+			[[nodiscard]]
+			bool isPaused() const noexcept
+			{
+				return m_isPaused;
+			}
+
+			void setPaused(bool isPaused)
+			{
+				advance();
+				m_isPaused = isPaused;
+			}
+
+			[[nodiscard]]
+			double timeScale() const noexcept
+			{
+				return m_timeScale;
+			}
+
+			void setTimeScale(double timeScale)
+			{
+				if (timeScale < 0.0)
+				{
+					throw Error{ U"TaskGroup: timeScale must not be negative" };
+				}
+				advance();
+				m_timeScale = timeScale;
+			}
+		};
+
+		// 起床時刻の早い順に取り出すためのキュー(二分ヒープ)
+		template <typename TDeadline>
+		class WakeQueue
+		{
+		private:
+			struct Item
+			{
+				TDeadline deadline;
+				AwaiterID id;
+				uint32 parkSerial;
+			};
+
+			struct LaterDeadline
+			{
+				[[nodiscard]]
+				bool operator()(const Item& a, const Item& b) const noexcept
+				{
+					return a.deadline > b.deadline;
+				}
+			};
+
+			Array<Item> m_items;
+
+		public:
+			void push(TDeadline deadline, AwaiterID id, uint32 parkSerial)
+			{
+				m_items.push_back(Item{ deadline, id, parkSerial });
+				std::push_heap(m_items.begin(), m_items.end(), LaterDeadline{});
+			}
+
+			// 起床時刻を迎えた要素を取り出してfnに渡す
+			template <typename TFunc>
+			void popDue(TDeadline now, TFunc fn)
+			{
+				while (!m_items.empty() && m_items.front().deadline <= now)
+				{
+					std::pop_heap(m_items.begin(), m_items.end(), LaterDeadline{});
+					const Item item = m_items.back();
+					m_items.pop_back();
+					fn(item.id, item.parkSerial);
+				}
+			}
+
+			[[nodiscard]]
+			bool empty() const noexcept
+			{
+				return m_items.empty();
+			}
+
+			void clear() noexcept
+			{
+				m_items.clear();
+			}
+		};
+
+		class Backend : public std::enable_shared_from_this<Backend>
+		{
+		private:
+			static constexpr StringView AddonName{ U"Co::BackendAddon" };
+
+			// 呼び出し元スレッドで現在タスクの実行先となっているBackend
+			// (メインスレッドではアドオンの実体、それ以外のスレッドではCo::Executorにより切り替えられる)
+			static inline thread_local Backend* s_pInstance = nullptr;
+
+			// Note: draw関数がconstであることの対処用にアドオンと実体を分離し、実体はポインタで持つようにしている
+			class BackendAddon : public IAddon
+			{
+			private:
+				// Note: ScopedTaskRunnerが所有者として弱参照を持つため、shared_ptrで持つ
+				std::shared_ptr<Backend> m_instance;
+
+			public:
+				BackendAddon()
+					: m_instance{ std::make_shared<Backend>() }
+				{
+					if (s_pInstance)
+					{
+						throw Error{ U"Co::BackendAddon: Instance already exists" };
+					}
+					s_pInstance = m_instance.get();
+				}
+
+				virtual ~BackendAddon()
+				{
+					if (s_pInstance == m_instance.get())
+					{
+						s_pInstance = nullptr;
+					}
+				}
+
+				virtual bool update() override
+				{
+					m_instance->update();
+					return true;
+				}
+
+				virtual void draw() const override
+				{
+					m_instance->draw();
+				}
+
+				[[nodiscard]]
+				Backend* instance() const
+				{
+					return m_instance.get();
+				}
+			};
+
+			// AwaiterIDの下位32bitはスロット番号、上位32bitはスロットの世代を表す
+			// (スロットは再利用されるが、再利用時に世代を進めるため、削除済みのAwaiterIDが別のAwaiterを指すことはない)
+			// 休止中はentryIndexがm_parkedAwaitersのインデックスを表す
+			struct AwaiterSlot
+			{
+				uint32 generation = 1;
+				uint32 entryIndex = 0;
+				uint32 parkSerial = 0;
+				bool inUse = false;
+				bool isParked = false;
+
+				// 実行完了(キャンセル含む)を待つ待機
+				WaiterList finishWaiters;
+
+				// 実行完了を通知するMultiRunnerの状態と、そのMultiRunner上の添字
+				std::weak_ptr<RunnerTracker> tracker;
+				uint32 trackerIndex = 0;
+
+				TaskPriority priority = TaskPriority::Normal;
+
+				// フレーム予算を使い切ったため連続して持ち越されたupdate回数
+				uint32 deferredUpdateCount = 0;
+
+				// 最後に実行順が回ってきたupdate回数(同じupdate内で2回resumeしないために使用)
+				uint64 turnUpdateCount = 0;
+
+				// 所属するTaskGroup
+				std::shared_ptr<TaskGroupState> pTaskGroup;
+
+				// TaskGroupState::memberIDs上の添字
+				uint32 taskGroupMemberIndex = 0;
+
+				// 実行中に所属から外れたTaskGroup
+				// (外れる前に構築したタイマーがTaskGroupの時計を参照している可能性があるため、スロットの解放まで破棄しない)
+				Array<std::shared_ptr<TaskGroupState>> leftTaskGroups;
+			};
+
+			// 休止中のエントリ
+			struct ParkedAwaiter
+			{
+				AwaiterEntry entry;
+				ISleeper* pSleeper;
+				uint64 parkedUpdateCount;
+				ISteadyClock* pSteadyClock;
+			};
+
+			// ISteadyClockごとの起床キュー
+			// (休止中のタスクがなくなった時計は破棄済みの可能性があるため、liveCountが0のキューは時刻を取得する前に破棄する)
+			struct SteadyClockWakeQueue
+			{
+				ISteadyClock* pSteadyClock;
+				uint32 liveCount;
+				WakeQueue<uint64> queue;
+			};
+
+			Optional<AwaiterID> m_currentAwaiterID = none;
+
+			bool m_currentAwaiterRemovalNeeded = false;
+
+			// 登録順に並んだエントリ(削除済みのエントリはawaiterがnullptrとなり、次回のupdateで詰められる)
+			Array<AwaiterEntry> m_awaiterEntries;
+
+			Array<AwaiterSlot> m_awaiterSlots;
+
+			Array<uint32> m_freeAwaiterSlotIndices;
+
+			uint64 m_nextAwaiterSequence = 1;
+
+			// update回数(DelayFrameは毎フレームではなくupdateごとに進むため、休止中のDelayFrameの起床判定に使用)
+			uint64 m_updateCount = 0;
+
+			// resume中に休止可能な待機が始まったかどうか(立っている場合のみ、resume後に休止可能か調べる)
+			bool m_sleepCheckRequested = false;
+
+			// 休止中のエントリ(毎フレームのresume対象外)
+			Array<ParkedAwaiter> m_parkedAwaiters;
+
+			// 要素が完了した、自動削除が有効なMultiRunnerの状態(updateの終了時に完了済みの要素を取り除く)
+			Array<std::weak_ptr<RunnerTracker>> m_autoRemoveTrackers;
+
+			WakeQueue<uint64> m_updateCountWakeQueue;
+
+			WakeQueue<double> m_sceneTimeWakeQueue;
+
+			Array<SteadyClockWakeQueue> m_steadyClockWakeQueues;
+
+			// update中に共有する時刻のスナップショット
+			// (タイマーごとに時刻を取得せず、update中の全タスクが同じ時刻を参照する。ISteadyClockは最初に参照された時点で1回だけ取得する)
+			struct FrameClockSnapshot
+			{
+				bool isValid = false;
+				int32 frameCount = 0;
+				double sceneTime = 0.0;
+				Array<std::pair<ISteadyClock*, uint64>> steadyClockMicrosecs;
+			};
+
+			FrameClockSnapshot m_frameClockSnapshot;
+
+			// Scene::FrameCount()・Scene::Time()を時計の元にするかどうか
+			// (falseの場合はCo::Executorの実体で、メインスレッド以外で実行されうるため、Siv3Dの時計やカーソルを参照しない)
+			bool m_usesSceneClock = true;
+
+			// FastForwardで進めたフレーム数・時間
+			// (BackendのフレームカウンタとScene時刻は、Scene::FrameCount()・Scene::Time()にこれらを加算した仮想的な値となる)
+			int32 m_fastForwardFrameCount = 0;
+			double m_fastForwardSceneTime = 0.0;
+
+			[[nodiscard]]
+			int32 virtualFrameCount() const
+			{
+				return m_usesSceneClock ? Scene::FrameCount() + m_fastForwardFrameCount : m_fastForwardFrameCount;
+			}
+
+			[[nodiscard]]
+			double virtualSceneTime() const
+			{
+				return m_usesSceneClock ? Scene::Time() + m_fastForwardSceneTime : m_fastForwardSceneTime;
+			}
+
+			static constexpr std::size_t NumTaskPriorities = 3;
+
+			// 優先度がNormal以外のエントリの数(0の場合は優先度ごとに分けず登録順に1回で実行する)
+			std::size_t m_nonNormalPriorityCount = 0;
+
+			// Backgroundのタスクを実行する際のフレーム予算(0の場合は制限なし)
+			uint64 m_frameBudgetMicrosec = 0;
+
+			// フレーム予算の計測に使用する時計(nullptrの場合はstd::chrono::steady_clock)
+			ISteadyClock* m_pFrameBudgetClock = nullptr;
+
+			// 持ち越しがこの回数続いたBackgroundのタスクは、フレーム予算を超えていても実行する
+			uint32 m_maxDeferredUpdates = 8;
+
+			// 前回のupdateで最後に実行したBackgroundのタスクの通し番号(次回はその次から実行する)
+			uint64 m_backgroundCursorSequence = 0;
+
+			std::array<TaskPriorityStats, NumTaskPriorities> m_priorityStats;
+
+			// ワーカースレッドからの完了通知(Backendより後まで処理中のジョブから参照されるためshared_ptrで持つ)
+			std::shared_ptr<CompletionQueue> m_pCompletionQueue = std::make_shared<CompletionQueue>();
+
+			// 領域へのマウス入力を待つ待機の振り分け
+			InputRouter m_inputRouter;
+
+			// resume中のタスクが所属するTaskGroup(Delayなどの時間待ちは、時計の指定がなければこのTaskGroupの時計を使用する)
+			TaskGroupState* m_pCurrentTaskGroup = nullptr;
+
+			// 休止から復帰したエントリを末尾へ追加したことで、登録順が崩れているかどうか
+			bool m_isEntryOrderDirty = false;
+
+			// 登録順を戻す際に取り出した起床済みのエントリ(確保済みの領域を再利用するためメンバとして持つ)
+			Array<AwaiterEntry> m_outOfOrderEntries;
+
+			// 登録順にresume中の優先度(update中のresumeの巡回中のみ値を持つ)
+			Optional<TaskPriority> m_resumingPriority;
+
+			// 巡回中に最後にresumeしたエントリの通し番号
+			uint64 m_resumeCursorSequence = 0;
+
+			// 巡回中に起床したエントリのうち、巡回がまだ登録順の位置に達していないもの(通し番号の小さい順に取り出す)
+			WakeQueue<uint64> m_wokenAheadQueue;
+
+			DrawExecutor m_drawExecutor;
+
+			SceneFactory m_currentSceneFactory;
+
+			// シーン遷移時にScenePreloadMode::Overlappedを許可するかどうか
+			bool m_isOverlappedScenePreloadAllowed = true;
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+			IProfilerSink* m_pProfilerSink = nullptr;
+#endif
+
+			[[nodiscard]]
+			static constexpr uint32 SlotIndexOf(AwaiterID id) noexcept
+			{
+				return static_cast<uint32>(id & 0xFFFFFFFFull);
+			}
+
+			[[nodiscard]]
+			static constexpr uint32 GenerationOf(AwaiterID id) noexcept
+			{
+				return static_cast<uint32>(id >> 32);
+			}
+
+			[[nodiscard]]
+			AwaiterID allocateAwaiterSlot()
+			{
+				uint32 slotIndex;
+				if (m_freeAwaiterSlotIndices.empty())
+				{
+					slotIndex = static_cast<uint32>(m_awaiterSlots.size());
+					m_awaiterSlots.emplace_back();
+				}
+				else
+				{
+					slotIndex = m_freeAwaiterSlotIndices.back();
+					m_freeAwaiterSlotIndices.pop_back();
+				}
+
+				AwaiterSlot& slot = m_awaiterSlots[slotIndex];
+				slot.entryIndex = static_cast<uint32>(m_awaiterEntries.size());
+				slot.inUse = true;
+				slot.turnUpdateCount = 0;
+				return (static_cast<AwaiterID>(slot.generation) << 32) | slotIndex;
+			}
+
+			void releaseAwaiterSlot(AwaiterID id)
+			{
+				AwaiterSlot& slot = m_awaiterSlots[SlotIndexOf(id)];
+				slot.inUse = false;
+				if (slot.priority != TaskPriority::Normal)
+				{
+					--m_nonNormalPriorityCount;
+				}
+				slot.priority = TaskPriority::Normal;
+				slot.deferredUpdateCount = 0;
+				if (++slot.generation == 0)
+				{
+					slot.generation = 1;
+				}
+				m_freeAwaiterSlotIndices.push_back(SlotIndexOf(id));
+				removeTaskGroupMember(slot);
+				slot.leftTaskGroups.clear();
+
+				if (const auto pTracker = slot.tracker.lock())
+				{
+					slot.tracker.reset();
+					pTracker->onFinished(slot.trackerIndex);
+					if (pTracker->pAutoRemoveOwner && !pTracker->isAutoRemoveQueued)
+					{
+						pTracker->isAutoRemoveQueued = true;
+						m_autoRemoveTrackers.push_back(pTracker);
+					}
+				}
+
+				if (!slot.finishWaiters.empty())
+				{
+					// Note: 通知中にスロット配列が再確保されることはないが、念のため取り出してから通知する
+					WaiterList finishWaiters = std::move(slot.finishWaiters);
+					finishWaiters.notifyAll();
+				}
+			}
+
+			// TaskGroupの所属から外す(一時停止のために休止中の場合も起床させない)
+			void removeTaskGroupMember(AwaiterSlot& slot)
+			{
+				if (!slot.pTaskGroup)
+				{
+					return;
+				}
+				Array<AwaiterID>& memberIDs = slot.pTaskGroup->memberIDs;
+				const uint32 memberIndex = slot.taskGroupMemberIndex;
+				if (memberIndex != memberIDs.size() - 1)
+				{
+					memberIDs[memberIndex] = memberIDs.back();
+					m_awaiterSlots[SlotIndexOf(memberIDs[memberIndex])].taskGroupMemberIndex = memberIndex;
+				}
+				memberIDs.pop_back();
+				slot.pTaskGroup.reset();
+				slot.taskGroupMemberIndex = 0;
+			}
+
+			// TaskGroupの一時停止により休止中であれば起床させる
+			void wakeIfPausedByTaskGroup(AwaiterID id, const TaskGroupState* pTaskGroup)
+			{
+				const AwaiterSlot& slot = m_awaiterSlots[SlotIndexOf(id)];
+				if (slot.isParked && m_parkedAwaiters[slot.entryIndex].pSleeper == pTaskGroup)
+				{
+					wake(id, slot.parkSerial);
+				}
+			}
+
+			[[nodiscard]]
+			AwaiterSlot* findAwaiterSlot(AwaiterID id)
+			{
+				const uint32 slotIndex = SlotIndexOf(id);
+				if (slotIndex >= m_awaiterSlots.size())
+				{
+					return nullptr;
+				}
+				AwaiterSlot& slot = m_awaiterSlots[slotIndex];
+				if (!slot.inUse || slot.generation != GenerationOf(id))
+				{
+					return nullptr;
+				}
+				return &slot;
+			}
+
+			[[nodiscard]]
+			AwaiterEntry* findAwaiterEntry(AwaiterID id)
+			{
+				const uint32 slotIndex = SlotIndexOf(id);
+				if (slotIndex >= m_awaiterSlots.size())
+				{
+					return nullptr;
+				}
+				const AwaiterSlot& slot = m_awaiterSlots[slotIndex];
+				if (!slot.inUse || slot.generation != GenerationOf(id))
+				{
+					return nullptr;
+				}
+				if (slot.isParked)
+				{
+					return &m_parkedAwaiters[slot.entryIndex].entry;
+				}
+				return &m_awaiterEntries[slot.entryIndex];
+			}
+
+			[[nodiscard]]
+			SteadyClockWakeQueue& steadyClockWakeQueue(ISteadyClock* pSteadyClock)
+			{
+				for (auto& wakeQueue : m_steadyClockWakeQueues)
+				{
+					if (wakeQueue.pSteadyClock == pSteadyClock)
+					{
+						return wakeQueue;
+					}
+				}
+				return m_steadyClockWakeQueues.emplace_back(SteadyClockWakeQueue{ pSteadyClock, 0, {} });
+			}
+
+			void decrementSteadyClockLiveCount(ISteadyClock* pSteadyClock)
+			{
+				for (auto& wakeQueue : m_steadyClockWakeQueues)
+				{
+					if (wakeQueue.pSteadyClock == pSteadyClock)
+					{
+						--wakeQueue.liveCount;
+						return;
+					}
+				}
+			}
+
+			// m_awaiterEntries[entryIndex]を休止させる
+			void park(std::size_t entryIndex, ISleeper* pSleeper)
+			{
+				const AwaiterID id = m_awaiterEntries[entryIndex].id;
+				AwaiterSlot& slot = m_awaiterSlots[SlotIndexOf(id)];
+				slot.isParked = true;
+				++slot.parkSerial;
+				slot.entryIndex = static_cast<uint32>(m_parkedAwaiters.size());
+
+				ISteadyClock* pSteadyClock = nullptr;
+				std::visit([&]<typename T>(const T& condition)
+					{
+						if constexpr (std::is_same_v<T, WakeAfterUpdateCount>)
+						{
+							m_updateCountWakeQueue.push(m_updateCount + condition.count, id, slot.parkSerial);
+						}
+						else if constexpr (std::is_same_v<T, WakeAtSceneTime>)
+						{
+							m_sceneTimeWakeQueue.push(condition.time, id, slot.parkSerial);
+						}
+						else if constexpr (std::is_same_v<T, WakeAtSteadyClockTime>)
+						{
+							pSteadyClock = condition.pSteadyClock;
+							SteadyClockWakeQueue& wakeQueue = steadyClockWakeQueue(pSteadyClock);
+							++wakeQueue.liveCount;
+							wakeQueue.queue.push(condition.microsec, id, slot.parkSerial);
+						}
+					}, pSleeper->wakeCondition());
+
+				pSleeper->onPark(id, slot.parkSerial);
+
+				// Note: ムーブ後のエントリはawaiterがnullptrの削除済み状態となり、update内で詰められる
+				m_parkedAwaiters.push_back(ParkedAwaiter{ std::move(m_awaiterEntries[entryIndex]), pSleeper, m_updateCount, pSteadyClock });
+			}
+
+			// 休止中のエントリをm_parkedAwaitersから取り出す
+			[[nodiscard]]
+			ParkedAwaiter unpark(AwaiterSlot& slot)
+			{
+				const uint32 parkedIndex = slot.entryIndex;
+				ParkedAwaiter parked = std::move(m_parkedAwaiters[parkedIndex]);
+				if (parkedIndex != m_parkedAwaiters.size() - 1)
+				{
+					m_parkedAwaiters[parkedIndex] = std::move(m_parkedAwaiters.back());
+					m_awaiterSlots[SlotIndexOf(m_parkedAwaiters[parkedIndex].entry.id)].entryIndex = parkedIndex;
+				}
+				m_parkedAwaiters.pop_back();
+				slot.isParked = false;
+				if (parked.pSteadyClock)
+				{
+					decrementSteadyClockLiveCount(parked.pSteadyClock);
+				}
+				return parked;
+			}
+
+			void wake(AwaiterID id, uint32 parkSerial)
+			{
+				// Note: 休止後に削除されたエントリの要素もキューに残っているため、世代と休止の通し番号で判定する
+				const uint32 slotIndex = SlotIndexOf(id);
+				AwaiterSlot& slot = m_awaiterSlots[slotIndex];
+				if (!slot.inUse || slot.generation != GenerationOf(id) || !slot.isParked || slot.parkSerial != parkSerial)
+				{
+					return;
+				}
+				ParkedAwaiter parked = unpark(slot);
+
+				// Note: 通知による起床は休止したupdate内で起こりうるため、その場合は省略回数を0とする
+				parked.pSleeper->onWake(m_updateCount > parked.parkedUpdateCount ? m_updateCount - parked.parkedUpdateCount - 1 : 0);
+
+				// 末尾へ追加し、次回のupdate開始時(update中の場合はupdate終了時)に登録順へ並べ直す
+				const uint64 sequence = parked.entry.sequence;
+				m_isEntryOrderDirty = true;
+				slot.entryIndex = static_cast<uint32>(m_awaiterEntries.size());
+				m_awaiterEntries.push_back(std::move(parked.entry));
+
+				// 巡回中の起床は、毎フレーム条件を調べて待つ場合と同じタイミングで再開させる
+				// (巡回がまだ登録順の位置に達していなければ同じupdate内でその位置から実行し、既に通過していれば次回のupdateで実行する)
+				if (m_resumingPriority)
+				{
+					if (!isTurnAhead(slot.priority, sequence))
+					{
+						slot.turnUpdateCount = m_updateCount;
+					}
+					else if (slot.priority == *m_resumingPriority)
+					{
+						m_wokenAheadQueue.push(sequence, id, slot.parkSerial);
+					}
+					// Note: 後の巡回の優先度の場合は、その巡回の開始前に登録順へ並べ直される
+				}
+			}
+
+			// 巡回中に起床したエントリの実行順が、このupdate内でまだ回ってくるかどうか
+			[[nodiscard]]
+			bool isTurnAhead(TaskPriority priority, uint64 sequence) const
+			{
+				if (priority != *m_resumingPriority)
+				{
+					return priority > *m_resumingPriority;
+				}
+
+				// Backgroundの巡回は開始時点のエントリのみを対象とするため、巡回中の起床は次回のupdateへ回す
+				return priority != TaskPriority::Background && sequence > m_resumeCursorSequence;
+			}
+
+			// 巡回中に起床したエントリのうち、通し番号がsequenceより小さいものを登録順にresumeする
+			void resumeWokenEntriesBefore(uint64 sequence, std::exception_ptr& exceptionPtr)
+			{
+				if (m_wokenAheadQueue.empty())
+				{
+					return;
+				}
+
+				TaskPriorityStats& stats = m_priorityStats[static_cast<std::size_t>(*m_resumingPriority)];
+				m_wokenAheadQueue.popDue(sequence - 1, [&](AwaiterID id, uint32 parkSerial)
+					{
+						// Note: 起床後に削除・休止されたエントリや、巡回で既にresumeしたエントリは除く
+						const AwaiterSlot& slot = m_awaiterSlots[SlotIndexOf(id)];
+						if (!slot.inUse || slot.generation != GenerationOf(id) || slot.isParked || slot.parkSerial != parkSerial || slot.turnUpdateCount == m_updateCount)
+						{
+							return;
+						}
+						++stats.resumeCount;
+						(void)resumeEntry(slot.entryIndex, exceptionPtr);
+					});
+			}
+
+			// 指定した優先度のエントリを登録順にresumeする間、巡回中として扱う
+			struct ResumePassScope
+			{
+				Backend& backend;
+
+				ResumePassScope(Backend& backend, TaskPriority priority)
+					: backend(backend)
+				{
+					backend.m_resumingPriority = priority;
+					backend.m_resumeCursorSequence = 0;
+				}
+
+				~ResumePassScope()
+				{
+					backend.m_resumingPriority.reset();
+					backend.m_wokenAheadQueue.clear();
+				}
+			};
+
+			void restoreEntryOrder()
+			{
+				if (!m_isEntryOrderDirty)
+				{
+					return;
+				}
+				m_isEntryOrderDirty = false;
+
+				// 起床したエントリ以外は登録順(update中に追加されたエントリも末尾に登録順で並ぶ)に並んでいるため、
+				// 手前のエントリより通し番号が小さいエントリのみを取り出して並べ替え、登録順の列へマージする
+				// (全体を並べ替えないため、起床したエントリの数をkとしてO(n + k log k)で済む。削除済みのエントリはここで詰める)
+				std::size_t writeIndex = 0;
+				std::size_t firstMovedIndex = m_awaiterEntries.size();
+				uint64 lastSequence = 0;
+				for (std::size_t readIndex = 0; readIndex < m_awaiterEntries.size(); ++readIndex)
+				{
+					AwaiterEntry& entry = m_awaiterEntries[readIndex];
+					if (entry.awaiter && entry.sequence < lastSequence)
+					{
+						m_outOfOrderEntries.push_back(std::move(entry));
+					}
+					else if (entry.awaiter)
+					{
+						lastSequence = entry.sequence;
+						if (writeIndex != readIndex)
+						{
+							m_awaiterEntries[writeIndex] = std::move(entry);
+						}
+						++writeIndex;
+						continue;
+					}
+					firstMovedIndex = Min(firstMovedIndex, readIndex);
+				}
+				m_awaiterEntries.erase(m_awaiterEntries.begin() + writeIndex, m_awaiterEntries.end());
+
+				if (!m_outOfOrderEntries.empty())
+				{
+					const auto fnLess = [](const AwaiterEntry& a, const AwaiterEntry& b) { return a.sequence < b.sequence; };
+					std::sort(m_outOfOrderEntries.begin(), m_outOfOrderEntries.end(), fnLess);
+
+					// 取り出したエントリより手前の範囲はマージで動かないため、マージはその後ろからのみ行う
+					const std::size_t mergeBeginIndex = static_cast<std::size_t>(std::upper_bound(m_awaiterEntries.begin(), m_awaiterEntries.end(), m_outOfOrderEntries.front(), fnLess) - m_awaiterEntries.begin());
+					firstMovedIndex = Min(firstMovedIndex, mergeBeginIndex);
+					const std::size_t orderedCount = m_awaiterEntries.size();
+					m_awaiterEntries.insert(m_awaiterEntries.end(), std::make_move_iterator(m_outOfOrderEntries.begin()), std::make_move_iterator(m_outOfOrderEntries.end()));
+					m_outOfOrderEntries.clear();
+					std::inplace_merge(m_awaiterEntries.begin() + mergeBeginIndex, m_awaiterEntries.begin() + orderedCount, m_awaiterEntries.end(), fnLess);
+				}
+
+				for (std::size_t i = firstMovedIndex; i < m_awaiterEntries.size(); ++i)
+				{
+					m_awaiterSlots[SlotIndexOf(m_awaiterEntries[i].id)].entryIndex = static_cast<uint32>(i);
+				}
+			}
+
+			// 起床条件を満たしたエントリをm_awaiterEntriesへ戻す
+			void wakeDueAwaiters()
+			{
+				if (m_parkedAwaiters.empty())
+				{
+					return;
+				}
+
+				const auto fnWake = [this](AwaiterID id, uint32 parkSerial) { wake(id, parkSerial); };
+				m_updateCountWakeQueue.popDue(m_updateCount, fnWake);
+				if (!m_sceneTimeWakeQueue.empty())
+				{
+					m_sceneTimeWakeQueue.popDue(m_frameClockSnapshot.sceneTime, fnWake);
+				}
+				m_steadyClockWakeQueues.remove_if([](const SteadyClockWakeQueue& wakeQueue) { return wakeQueue.liveCount == 0; });
+				for (auto& wakeQueue : m_steadyClockWakeQueues)
+				{
+					wakeQueue.queue.popDue(snapshotSteadyClockMicrosec(wakeQueue.pSteadyClock), fnWake);
+				}
+			}
+
+			[[nodiscard]]
+			uint64 snapshotSteadyClockMicrosec(ISteadyClock* pSteadyClock)
+			{
+				for (const auto& [pClock, microsec] : m_frameClockSnapshot.steadyClockMicrosecs)
+				{
+					if (pClock == pSteadyClock)
+					{
+						return microsec;
+					}
+				}
+				const uint64 microsec = pSteadyClock->getMicrosec();
+				m_frameClockSnapshot.steadyClockMicrosecs.emplace_back(pSteadyClock, microsec);
+				return microsec;
+			}
+
+			struct FrameClockSnapshotScope
+			{
+				FrameClockSnapshot& snapshot;
+
+				FrameClockSnapshotScope(FrameClockSnapshot& snapshot, int32 frameCount, double sceneTime)
+					: snapshot(snapshot)
+				{
+					snapshot.isValid = true;
+					snapshot.frameCount = frameCount;
+					snapshot.sceneTime = sceneTime;
+					snapshot.steadyClockMicrosecs.clear();
+				}
+
+				~FrameClockSnapshotScope()
+				{
+					snapshot.isValid = false;
+				}
+			};
+
+			// m_awaiterEntries[entryIndex]を1回resumeする
+			// (完了・削除・休止によりm_awaiterEntriesから外れた場合はfalseを返す。外れたエントリはawaiterがnullptrの削除済み状態として残る)
+			bool resumeEntry(std::size_t entryIndex, std::exception_ptr& exceptionPtr)
+			{
+				const AwaiterID id = m_awaiterEntries[entryIndex].id;
+				m_awaiterSlots[SlotIndexOf(id)].turnUpdateCount = m_updateCount;
+				m_resumeCursorSequence = m_awaiterEntries[entryIndex].sequence;
+
+				// 一時停止中のTaskGroupに所属している場合は、一時停止が解除されるまで休止させる
+				TaskGroupState* const pTaskGroup = m_awaiterSlots[SlotIndexOf(id)].pTaskGroup.get();
+				if (pTaskGroup && pTaskGroup->isPaused())
+				{
+					park(entryIndex, pTaskGroup);
+					return false;
+				}
+
+				m_currentAwaiterID = id;
+				m_pCurrentTaskGroup = pTaskGroup;
+
+				// Note: resume中にエントリが追加されると配列が再確保されうるため、resume後に参照を取り直す
+				IAwaiter* const pAwaiter = m_awaiterEntries[entryIndex].awaiter.get();
+				m_sleepCheckRequested = false;
+#ifdef COTASKLIB_ENABLE_PROFILER
+				const uint64 resumeBeginNanosec = ProfilerNowNanosec();
+				if (m_pProfilerSink)
+				{
+					m_pProfilerSink->beginZone(taskProfileZone(m_awaiterEntries[entryIndex].profile), resumeBeginNanosec);
+				}
+#endif
+				IAwaiter* const pLeafAwaiter = ResumeFromLeaf(pAwaiter, m_awaiterEntries[entryIndex].pLeafAwaiter);
+				m_awaiterEntries[entryIndex].pLeafAwaiter = pLeafAwaiter;
+				m_pCurrentTaskGroup = nullptr;
+#ifdef COTASKLIB_ENABLE_PROFILER
+				const uint64 resumeEndNanosec = ProfilerNowNanosec();
+				if (m_pProfilerSink)
+				{
+					m_pProfilerSink->endZone(resumeEndNanosec);
+				}
+				++m_awaiterEntries[entryIndex].profile.resumeCount;
+				m_awaiterEntries[entryIndex].profile.totalResumeNanosec += resumeEndNanosec - resumeBeginNanosec;
+#endif
+
+				if (m_currentAwaiterRemovalNeeded || pAwaiter->done())
+				{
+					AwaiterEntry entry = std::move(m_awaiterEntries[entryIndex]);
+					releaseAwaiterSlot(id);
+
+					// Note: 終了時のコールバック内で自身のランナーが破棄された場合に、削除フラグが再び立って次に実行するタスクが削除されないよう、
+					//       実行中のAwaiterIDを外してからコールバックを呼び、削除フラグはコールバックの後で下ろす
+					m_currentAwaiterID.reset();
+					try
+					{
+						entry.callEndCallback();
+					}
+					catch (...)
+					{
+						if (!exceptionPtr)
+						{
+							exceptionPtr = std::current_exception();
+						}
+					}
+					m_currentAwaiterRemovalNeeded = false;
+					return false;
+				}
+
+				// 休止可能な待機対象のみを待っている場合は、起床条件を満たすまでresume対象から外す
+				if (m_sleepCheckRequested)
+				{
+					m_sleepCheckRequested = false;
+					// Note: 末端より外側は子のタスクを待っているだけなので、末端から調べれば十分
+					if (ISleeper* const pSleeper = pLeafAwaiter->sleeper())
+					{
+						park(entryIndex, pSleeper);
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			// 削除済みのエントリを詰める
+			void compactEntries()
+			{
+				std::size_t writeIndex = 0;
+				for (std::size_t readIndex = 0; readIndex < m_awaiterEntries.size(); ++readIndex)
+				{
+					if (!m_awaiterEntries[readIndex].awaiter)
+					{
+						continue;
+					}
+					if (writeIndex != readIndex)
+					{
+						m_awaiterEntries[writeIndex] = std::move(m_awaiterEntries[readIndex]);
+						m_awaiterSlots[SlotIndexOf(m_awaiterEntries[writeIndex].id)].entryIndex = static_cast<uint32>(writeIndex);
+					}
+					++writeIndex;
+				}
+				m_awaiterEntries.erase(m_awaiterEntries.begin() + writeIndex, m_awaiterEntries.end());
+			}
+
+			[[nodiscard]]
+			uint64 frameBudgetClockMicrosec() const
+			{
+				if (m_pFrameBudgetClock)
+				{
+					return m_pFrameBudgetClock->getMicrosec();
+				}
+				return static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+
+			[[nodiscard]]
+			TaskPriority priorityOf(const AwaiterEntry& entry) const
+			{
+				return m_awaiterSlots[SlotIndexOf(entry.id)].priority;
+			}
+
+			// 指定した優先度のエントリを登録順に実行する
+			void resumeEntriesWithPriority(TaskPriority priority, std::exception_ptr& exceptionPtr)
+			{
+				TaskPriorityStats& stats = m_priorityStats[static_cast<std::size_t>(priority)];
+				const uint64 beginMicrosec = frameBudgetClockMicrosec();
+				const ResumePassScope passScope{ *this, priority };
+				for (std::size_t entryIndex = 0; entryIndex < m_awaiterEntries.size(); ++entryIndex)
+				{
+					if (!m_awaiterEntries[entryIndex].awaiter || priorityOf(m_awaiterEntries[entryIndex]) != priority)
+					{
+						continue;
+					}
+
+					// Note: 起床したエントリのresume中に、このエントリが削除されることがある
+					resumeWokenEntriesBefore(m_awaiterEntries[entryIndex].sequence, exceptionPtr);
+					if (m_awaiterEntries[entryIndex].awaiter && m_awaiterSlots[SlotIndexOf(m_awaiterEntries[entryIndex].id)].turnUpdateCount != m_updateCount)
+					{
+						++stats.resumeCount;
+						(void)resumeEntry(entryIndex, exceptionPtr);
+					}
+				}
+				stats.totalResumeTime += Duration{ (frameBudgetClockMicrosec() - beginMicrosec) / 1'000'000.0 };
+			}
+
+			// Backgroundのエントリを、前回最後に実行したエントリの次から登録順に巡回して実行する
+			// フレーム予算を使い切った後のエントリは次回へ持ち越す(持ち越しがm_maxDeferredUpdates回続いたエントリは予算を超えていても実行する)
+			void resumeBackgroundEntries(uint64 updateBeginMicrosec, std::exception_ptr& exceptionPtr)
+			{
+				TaskPriorityStats& stats = m_priorityStats[static_cast<std::size_t>(TaskPriority::Background)];
+				const uint64 beginMicrosec = frameBudgetClockMicrosec();
+				const ResumePassScope passScope{ *this, TaskPriority::Background };
+
+				// Note: エントリは登録順に並んでいるため、巡回の開始位置は通し番号から求められる
+				// (resume中に起床したエントリが末尾に追加されうるため、開始時点の要素数までを対象とする)
+				const std::size_t entryCount = m_awaiterEntries.size();
+				std::size_t startIndex = 0;
+				while (startIndex < entryCount && m_awaiterEntries[startIndex].sequence <= m_backgroundCursorSequence)
+				{
+					++startIndex;
+				}
+
+				Optional<uint64> lastResumedSequence;
+				for (std::size_t i = 0; i < entryCount; ++i)
+				{
+					const std::size_t entryIndex = (startIndex + i) % entryCount;
+					if (!m_awaiterEntries[entryIndex].awaiter || priorityOf(m_awaiterEntries[entryIndex]) != TaskPriority::Background)
+					{
+						continue;
+					}
+
+					AwaiterSlot& slot = m_awaiterSlots[SlotIndexOf(m_awaiterEntries[entryIndex].id)];
+					const bool isOverBudget = m_frameBudgetMicrosec != 0 && frameBudgetClockMicrosec() - updateBeginMicrosec >= m_frameBudgetMicrosec;
+					if (isOverBudget)
+					{
+						if (slot.deferredUpdateCount < m_maxDeferredUpdates)
+						{
+							++slot.deferredUpdateCount;
+							++stats.deferCount;
+							continue;
+						}
+						++stats.forcedResumeCount;
+					}
+					slot.deferredUpdateCount = 0;
+
+					const uint64 sequence = m_awaiterEntries[entryIndex].sequence;
+					++stats.resumeCount;
+					(void)resumeEntry(entryIndex, exceptionPtr);
+					if (!isOverBudget)
+					{
+						lastResumedSequence = sequence;
+					}
+				}
+
+				// 予算内で実行できた最後のエントリの次から、次回の巡回を始める
+				if (lastResumedSequence)
+				{
+					m_backgroundCursorSequence = *lastResumedSequence;
+				}
+				stats.totalResumeTime += Duration{ (frameBudgetClockMicrosec() - beginMicrosec) / 1'000'000.0 };
+			}
+
+#ifdef COTASKLIB_ENABLE_PROFILER
+			[[nodiscard]]
+			static ProfileZone taskProfileZone(const AwaiterEntry::ProfileRecord& record) noexcept
+			{
+				return ProfileZone
+				{
+					.kind = ProfileZoneKind::Task,
+					.name = record.name.isEmpty() ? StringView{ U"Task" } : StringView{ record.name },
+					.fileName = record.hasLocation ? record.location.file_name() : nullptr,
+					.line = record.hasLocation ? static_cast<uint32>(record.location.line()) : 0,
+				};
+			}
+
+#endif
+			// 自動削除が有効なMultiRunnerから、このupdateまでに完了した要素を取り除く
+			// (要素のresume中に取り除くと、MultiRunnerを走査中のタスクのイテレータが無効になるため、updateの終了時にまとめて行う)
+			void removeAutoRemoveDoneRunners()
+			{
+				if (m_autoRemoveTrackers.empty())
+				{
+					return;
+				}
+				const Array<std::weak_ptr<RunnerTracker>> trackers = std::exchange(m_autoRemoveTrackers, {});
+				for (const std::weak_ptr<RunnerTracker>& weakTracker : trackers)
+				{
+					if (const auto pTracker = weakTracker.lock())
+					{
+						pTracker->isAutoRemoveQueued = false;
+						if (pTracker->pAutoRemoveOwner)
+						{
+							RemoveDoneRunners(*pTracker->pAutoRemoveOwner);
+						}
+					}
+				}
+			}
+
+		public:
+			Backend() = default;
+
+			explicit Backend(bool usesSceneClock)
+				: m_usesSceneClock(usesSceneClock)
+			{
+			}
+
+			Backend(const Backend&) = delete;
+
+			Backend& operator=(const Backend&) = delete;
+
+			~Backend()
+			{
+				// 実行中のタスクはBackendとともに破棄されるため、追跡しているMultiRunnerには完了として通知する
+				// (通知しないと、Backendの破棄後にMultiRunnerのallDone()がtrueにならない)
+				for (AwaiterSlot& slot : m_awaiterSlots)
+				{
+					if (!slot.inUse)
+					{
+						continue;
+					}
+					if (const auto pTracker = slot.tracker.lock())
+					{
+						slot.tracker.reset();
+						pTracker->onFinished(slot.trackerIndex);
+					}
+				}
+				for (const std::weak_ptr<RunnerTracker>& weakTracker : m_autoRemoveTrackers)
+				{
+					if (const auto pTracker = weakTracker.lock())
+					{
+						pTracker->isAutoRemoveQueued = false;
+					}
+				}
+			}
+
+			void update()
+			{
+				std::exception_ptr exceptionPtr;
+
+				const FrameClockSnapshotScope snapshotScope{ m_frameClockSnapshot, virtualFrameCount(), virtualSceneTime() };
+
+				++m_updateCount;
+
+				// 完了したワーカーのジョブを待っているタスクのみ起床させる
+				m_pCompletionQueue->drain();
+
+				// カーソルが当たった領域の入力を待っているタスクのみ起床させる
+				if (m_usesSceneClock)
+				{
+					m_inputRouter.dispatch();
+				}
+
+				wakeDueAwaiters();
+				restoreEntryOrder();
+
+				if (m_nonNormalPriorityCount == 0 && m_frameBudgetMicrosec == 0)
+				{
+					// 実行しながら削除済み・完了済みのエントリを前方へ詰める
+					// (resume中に追加されたエントリは末尾に追加され、同じupdate内で実行される)
+					TaskPriorityStats& stats = m_priorityStats[static_cast<std::size_t>(TaskPriority::Normal)];
+					const ResumePassScope passScope{ *this, TaskPriority::Normal };
+					std::size_t writeIndex = 0;
+					for (std::size_t readIndex = 0; readIndex < m_awaiterEntries.size(); ++readIndex)
+					{
+						if (!m_awaiterEntries[readIndex].awaiter)
+						{
+							// 削除済み
+							continue;
+						}
+
+						// Note: 起床したエントリのresume中に、このエントリが削除されることがある
+						resumeWokenEntriesBefore(m_awaiterEntries[readIndex].sequence, exceptionPtr);
+						if (!m_awaiterEntries[readIndex].awaiter)
+						{
+							continue;
+						}
+
+						// 巡回中に起床したエントリは、既にresume済みか次回のupdateへ回されたものなので、詰めるのみ
+						const AwaiterID id = m_awaiterEntries[readIndex].id;
+						if (m_awaiterSlots[SlotIndexOf(id)].turnUpdateCount != m_updateCount)
+						{
+							++stats.resumeCount;
+							if (!resumeEntry(readIndex, exceptionPtr))
+							{
+								continue;
+							}
+						}
+
+						if (writeIndex != readIndex)
+						{
+							m_awaiterEntries[writeIndex] = std::move(m_awaiterEntries[readIndex]);
+							m_awaiterSlots[SlotIndexOf(id)].entryIndex = static_cast<uint32>(writeIndex);
+						}
+						++writeIndex;
+					}
+					m_awaiterEntries.erase(m_awaiterEntries.begin() + writeIndex, m_awaiterEntries.end());
+				}
+				else
+				{
+					// 優先度の高い順に実行し、削除済み・完了済みのエントリは最後にまとめて詰める
+					// (前の優先度の実行中に起床したエントリを登録順の位置から実行するため、優先度ごとに登録順へ並べ直す)
+					const uint64 beginMicrosec = frameBudgetClockMicrosec();
+					resumeEntriesWithPriority(TaskPriority::Critical, exceptionPtr);
+					restoreEntryOrder();
+					resumeEntriesWithPriority(TaskPriority::Normal, exceptionPtr);
+					restoreEntryOrder();
+					resumeBackgroundEntries(beginMicrosec, exceptionPtr);
+					compactEntries();
+				}
+				m_currentAwaiterID.reset();
+				restoreEntryOrder();
+				removeAutoRemoveDoneRunners();
+				if (exceptionPtr)
+				{
+					std::rethrow_exception(exceptionPtr);
+				}
+			}
+
+			void draw()
+			{
+				m_drawExecutor.execute();
+			}
+
+			// フレーム数と時刻を1フレーム分進めてからupdateを実行する
+			void advanceFrame(double deltaSec)
+			{
+				++m_fastForwardFrameCount;
+				m_fastForwardSceneTime += deltaSec;
+				update();
+			}
+
+			[[nodiscard]]
+			bool isUpdating() const noexcept
+			{
+				return m_frameClockSnapshot.isValid;
+			}
+
+			// 実行中(休止中を含む)のタスクがあるかどうか
+			[[nodiscard]]
+			bool hasAwaiters() const noexcept
+			{
+				return !m_awaiterEntries.empty() || !m_parkedAwaiters.empty();
+			}
+
+			// 呼び出し元スレッドでタスクの実行先とするBackendを切り替え、切り替え前のBackendを返す
+			static Backend* BindCurrent(Backend* pBackend) noexcept
+			{
+				return std::exchange(s_pInstance, pBackend);
+			}
+
+			// 呼び出し元スレッドで現在タスクの実行先となっているBackendへの弱参照を返す
+			[[nodiscard]]
+			static std::weak_ptr<Backend> CurrentWeak() noexcept
+			{
+				return s_pInstance ? s_pInstance->weak_from_this() : std::weak_ptr<Backend>{};
+			}
+
+			static void Init()
+			{
+				Addon::Register(AddonName, std::make_unique<BackendAddon>());
+			}
+
+			// Note: TRegisteredAwaiterは完了・キャンセル時のコールバックを呼ぶstatic関数CallEndCallbackを持つ必要がある
+			template <typename TRegisteredAwaiter>
+			[[nodiscard]]
+			static AwaiterID Add(std::unique_ptr<TRegisteredAwaiter>&& awaiter)
+			{
+				if (!awaiter)
+				{
+					throw Error{ U"awaiter must not be nullptr" };
+				}
+
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				const AwaiterID id = s_pInstance->allocateAwaiterSlot();
+				s_pInstance->m_awaiterEntries.push_back(
+					AwaiterEntry
+					{
+						.id = id,
+						.sequence = s_pInstance->m_nextAwaiterSequence++,
+						.addedUpdateCount = s_pInstance->m_updateCount,
+						.awaiter = std::move(awaiter),
+						.fnCallEndCallback = &TRegisteredAwaiter::CallEndCallback,
+					});
+#ifdef COTASKLIB_ENABLE_PROFILER
+				AwaiterEntry& entry = s_pInstance->m_awaiterEntries.back();
+				InitProfileRecord(entry.profile, entry.awaiter.get());
+#endif
+				return id;
+			}
+
+			static bool Remove(AwaiterID id)
+			{
+				if (!s_pInstance)
+				{
+					// Note: ユーザーがインスタンスをstaticで持ってしまった場合にAddon解放後に呼ばれるケースが起こりうるので、ここでは例外を出さない
+					return false;
+				}
+				if (id == s_pInstance->m_currentAwaiterID)
+				{
+					// 実行中タスクのAwaiterをここで削除するとアクセス違反やイテレータ破壊が起きるため、代わりに削除フラグを立てて実行完了時に削除
+					// (例えば、タスク実行のライフタイムをOptional<ScopedTaskRunner>型のメンバ変数として持ち、タスク実行中にそこへnoneを代入して実行を止める場合が該当)
+					if (!s_pInstance->m_currentAwaiterRemovalNeeded)
+					{
+						s_pInstance->m_currentAwaiterRemovalNeeded = true;
+						return true;
+					}
+					return false;
+				}
+				if (AwaiterEntry* pEntry = s_pInstance->findAwaiterEntry(id))
+				{
+					AwaiterSlot& slot = s_pInstance->m_awaiterSlots[SlotIndexOf(id)];
+					if (slot.isParked)
+					{
+						// 起床キュー上の要素は残るが、起床時に世代で判定して無視される
+						ParkedAwaiter parked = s_pInstance->unpark(slot);
+						s_pInstance->releaseAwaiterSlot(id);
+						parked.entry.callEndCallback();
+						return true;
+					}
+
+					// 配列上のエントリはawaiterがnullptrの削除済み状態として残し、次回のupdateで詰める
+					AwaiterEntry entry = std::move(*pEntry);
+					s_pInstance->releaseAwaiterSlot(id);
+					entry.callEndCallback();
+					return true;
+				}
+				return false;
+			}
+
+			[[nodiscard]]
+			static bool IsDone(AwaiterID id)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				if (const AwaiterEntry* pEntry = s_pInstance->findAwaiterEntry(id))
+				{
+					return pEntry->awaiter->done();
+				}
+
+				// スロットの世代が進んでいれば削除済み
+				const uint32 slotIndex = SlotIndexOf(id);
+				return slotIndex < s_pInstance->m_awaiterSlots.size() && GenerationOf(id) < s_pInstance->m_awaiterSlots[slotIndex].generation;
+			}
+
+			// 休止中のエントリを起床させる
+			static void Wake(AwaiterID id, uint32 parkSerial)
+			{
+				if (!s_pInstance)
+				{
+					return;
+				}
+				s_pInstance->wake(id, parkSerial);
+			}
+
+			static void AddInputWaiter(InputWaiterNode& node)
+			{
+				if (s_pInstance)
+				{
+					s_pInstance->m_inputRouter.add(node);
+				}
+			}
+
+			static void RemoveInputWaiter(InputWaiterNode& node)
+			{
+				if (s_pInstance)
+				{
+					s_pInstance->m_inputRouter.remove(node);
+				}
+			}
+
+			[[nodiscard]]
+			static uint64 AddInputBlocker(Layer layer, const Optional<RectF>& area)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_inputRouter.addBlocker(layer, area);
+			}
+
+			static void RemoveInputBlocker(uint64 id)
+			{
+				if (s_pInstance)
+				{
+					s_pInstance->m_inputRouter.removeBlocker(id);
+				}
+			}
+
+			[[nodiscard]]
+			static bool IsInputBlocked(Layer layer)
+			{
+				if (!s_pInstance)
+				{
+					return false;
+				}
+				return s_pInstance->m_inputRouter.isBlocked(layer, Cursor::PosF());
+			}
+
+			[[nodiscard]]
+			static const InputRouter& GetInputRouter()
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_inputRouter;
+			}
+
+			// 実行完了時に通知されるよう登録する(すでに完了している場合はfalseを返す)
+			static bool AddFinishWaiter(AwaiterID id, WaiterNode& node, SignalSleeper* pSleeper)
+			{
+				if (!s_pInstance)
+				{
+					return false;
+				}
+				const AwaiterEntry* pEntry = s_pInstance->findAwaiterEntry(id);
+				if (!pEntry || pEntry->awaiter->done())
+				{
+					return false;
+				}
+				s_pInstance->m_awaiterSlots[SlotIndexOf(id)].finishWaiters.push(node, pSleeper);
+				return true;
+			}
+
+			// 現在のフレーム数(update中はスナップショットの値を返す。FastForwardで進めたフレーム数を含む)
+			[[nodiscard]]
+			static int32 FrameCount()
+			{
+				if (!s_pInstance)
+				{
+					return Scene::FrameCount();
+				}
+				if (s_pInstance->m_frameClockSnapshot.isValid)
+				{
+					return s_pInstance->m_frameClockSnapshot.frameCount;
+				}
+				return s_pInstance->virtualFrameCount();
+			}
+
+			// 現在のScene::Time()(update中はスナップショットの値を返す。FastForwardで進めた時間を含む)
+			[[nodiscard]]
+			static double SceneTime()
+			{
+				if (!s_pInstance)
+				{
+					return Scene::Time();
+				}
+				if (s_pInstance->m_frameClockSnapshot.isValid)
+				{
+					return s_pInstance->m_frameClockSnapshot.sceneTime;
+				}
+				return s_pInstance->virtualSceneTime();
+			}
+
+			// ISteadyClockの現在時刻(update中はフレーム内で最初に参照した時点の値を返す)
+			[[nodiscard]]
+			static uint64 SteadyClockMicrosec(ISteadyClock* pSteadyClock)
+			{
+				if (s_pInstance && s_pInstance->m_frameClockSnapshot.isValid)
+				{
+					return s_pInstance->snapshotSteadyClockMicrosec(pSteadyClock);
+				}
+				return pSteadyClock->getMicrosec();
+			}
+
+			// 実行完了時にMultiRunnerの状態へ、MultiRunner上の添字とともに通知されるよう登録する(すでに完了している場合はfalseを返す)
+			static bool TrackFinish(AwaiterID id, const std::shared_ptr<RunnerTracker>& pTracker, uint32 index)
+			{
+				if (!s_pInstance)
+				{
+					return false;
+				}
+				const AwaiterEntry* pEntry = s_pInstance->findAwaiterEntry(id);
+				if (!pEntry || pEntry->awaiter->done())
+				{
+					return false;
+				}
+				AwaiterSlot& slot = s_pInstance->m_awaiterSlots[SlotIndexOf(id)];
+				slot.tracker = pTracker;
+				slot.trackerIndex = index;
+				++pTracker->liveCount;
+				return true;
+			}
+
+			// MultiRunner上の添字が変わった場合に、通知する添字を更新する
+			static void SetTrackerIndex(AwaiterID id, uint32 index)
+			{
+				if (!s_pInstance || !s_pInstance->findAwaiterEntry(id))
+				{
+					return;
+				}
+				s_pInstance->m_awaiterSlots[SlotIndexOf(id)].trackerIndex = index;
+			}
+
+			// MultiRunnerの要素から取り出された実行を、MultiRunnerの状態の追跡から外す
+			static void UntrackFinish(AwaiterID id, RunnerTracker& tracker)
+			{
+				if (!s_pInstance || !s_pInstance->findAwaiterEntry(id))
+				{
+					return;
+				}
+				AwaiterSlot& slot = s_pInstance->m_awaiterSlots[SlotIndexOf(id)];
+				if (slot.tracker.lock().get() == &tracker)
+				{
+					slot.tracker.reset();
+					--tracker.liveCount;
+				}
+			}
+
+			// 実行完了を待つ待機に通知する(ScopedTaskRunnerが実行を手放した場合用)
+			static void NotifyFinishWaiters(AwaiterID id)
+			{
+				if (!s_pInstance || !s_pInstance->findAwaiterEntry(id))
+				{
+					return;
+				}
+				WaiterList finishWaiters = std::move(s_pInstance->m_awaiterSlots[SlotIndexOf(id)].finishWaiters);
+				finishWaiters.notifyAll();
+			}
+
+			[[nodiscard]]
+			static std::shared_ptr<CompletionQueue> WorkerCompletionQueue()
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_pCompletionQueue;
+			}
+
+			// TaskGroupへ所属させる(他のTaskGroupに所属していた場合は移動する)
+			static void JoinTaskGroup(AwaiterID id, const std::shared_ptr<TaskGroupState>& pTaskGroup)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				AwaiterSlot* const pSlot = s_pInstance->findAwaiterSlot(id);
+				if (!pSlot || pSlot->pTaskGroup == pTaskGroup)
+				{
+					return;
+				}
+				if (pSlot->pTaskGroup)
+				{
+					LeaveTaskGroup(id);
+				}
+				pSlot->pTaskGroup = pTaskGroup;
+				pSlot->taskGroupMemberIndex = static_cast<uint32>(pTaskGroup->memberIDs.size());
+				pTaskGroup->memberIDs.push_back(id);
+			}
+
+			// TaskGroupから外す(TaskGroupの一時停止により休止中の場合は起床させる)
+			static void LeaveTaskGroup(AwaiterID id)
+			{
+				if (!s_pInstance)
+				{
+					return;
+				}
+				AwaiterSlot* const pSlot = s_pInstance->findAwaiterSlot(id);
+				if (!pSlot || !pSlot->pTaskGroup)
+				{
+					return;
+				}
+				TaskGroupState* const pTaskGroup = pSlot->pTaskGroup.get();
+				pSlot->leftTaskGroups.push_back(pSlot->pTaskGroup);
+				s_pInstance->removeTaskGroupMember(*pSlot);
+				s_pInstance->wakeIfPausedByTaskGroup(id, pTaskGroup);
+			}
+
+			// 一時停止の解除時に、一時停止により休止中の所属タスクを起床させる
+			static void WakeTaskGroupMembers(const TaskGroupState& taskGroup)
+			{
+				if (!s_pInstance)
+				{
+					return;
+				}
+				for (const AwaiterID id : taskGroup.memberIDs)
+				{
+					s_pInstance->wakeIfPausedByTaskGroup(id, &taskGroup);
+				}
+			}
+
+			// 所属タスクを全て削除する
+			static bool RemoveTaskGroupMembers(TaskGroupState& taskGroup)
+			{
+				bool anyRemoved = false;
+
+				// Note: 削除時にmemberIDsから取り除かれるため、取り出してから削除する
+				const Array<AwaiterID> memberIDs = taskGroup.memberIDs;
+				for (const AwaiterID id : memberIDs)
+				{
+					if (Remove(id))
+					{
+						anyRemoved = true;
+					}
+				}
+				return anyRemoved;
+			}
+
+			// resume中のタスクが所属するTaskGroupの時計(所属していない場合はnullptr)
+			[[nodiscard]]
+			static ISteadyClock* CurrentTaskGroupClock() noexcept
+			{
+				return s_pInstance ? s_pInstance->m_pCurrentTaskGroup : nullptr;
+			}
+
+			[[nodiscard]]
+			static TaskGroupState* ExchangeCurrentTaskGroup(TaskGroupState* pTaskGroup) noexcept
+			{
+				return s_pInstance ? std::exchange(s_pInstance->m_pCurrentTaskGroup, pTaskGroup) : nullptr;
+			}
+
+			// 休止可能な待機対象がawait_suspendされたことを通知する
+			static void RequestSleepCheck() noexcept
+			{
+				if (s_pInstance)
+				{
+					s_pInstance->m_sleepCheckRequested = true;
+				}
+			}
+
+			static void ManualUpdate()
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->update();
+			}
+
+			static void ManualDraw()
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->draw();
+			}
+
+			// 描画せずに、フレーム数と時刻を1フレーム分ずつ進めながらupdateをframes回実行する
+			static void FastForward(int32 frames, Duration deltaTime)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				if (s_pInstance->m_frameClockSnapshot.isValid)
+				{
+					throw Error{ U"FastForward must not be called during Backend update" };
+				}
+				if (frames < 0)
+				{
+					throw Error{ U"FastForward: frames must not be negative" };
+				}
+				if (deltaTime < Duration::zero())
+				{
+					throw Error{ U"FastForward: deltaTime must not be negative" };
+				}
+
+				const double deltaSec = deltaTime.count();
+				for (int32 i = 0; i < frames; ++i)
+				{
+					s_pInstance->advanceFrame(deltaSec);
+				}
+			}
+
+			[[nodiscard]]
+			static DrawerID AddDrawer(IDrawerInternal* pDrawer, Layer layer, int32 drawIndex)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_drawExecutor.add(layer, drawIndex, pDrawer);
+			}
+
+			static void SetDrawerLayer(DrawerID id, Layer layer)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_drawExecutor.setDrawerLayer(id, layer);
+			}
+
+			static void SetDrawerDrawIndex(DrawerID id, int32 drawIndex)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_drawExecutor.setDrawerDrawIndex(id, drawIndex);
+			}
+
+			static void SetDrawerVisible(DrawerID id, bool isVisible)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_drawExecutor.setDrawerVisible(id, isVisible);
+			}
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+			static void SetDrawerProfileName(DrawerID id, StringView name)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_drawExecutor.setDrawerProfileName(id, name);
+			}
+#endif
+
+			static void SetLayerCached(Layer layer, bool isCached)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_drawExecutor.setLayerCached(layer, isCached);
+			}
+
+			[[nodiscard]]
+			static bool IsLayerCached(Layer layer)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_drawExecutor.isLayerCached(layer);
+			}
+
+			static void InvalidateLayerCache(Layer layer)
+			{
+				if (s_pInstance)
+				{
+					s_pInstance->m_drawExecutor.invalidateLayerCache(layer);
+				}
+			}
+
+			[[nodiscard]]
+			static uint64 LayerCacheRenderCount(Layer layer)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_drawExecutor.layerCacheRenderCount(layer);
+			}
+
+			static void RemoveDrawer(DrawerID id)
+			{
+				if (!s_pInstance)
+				{
+					// Note: ユーザーがインスタンスをstaticで持ってしまった場合にAddon解放後に呼ばれるケースが起こりうるので、ここでは例外を出さない
+					return;
+				}
+				s_pInstance->m_drawExecutor.remove(id);
+			}
+
+			static void SetOverlappedScenePreloadAllowed(bool isAllowed)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_isOverlappedScenePreloadAllowed = isAllowed;
+			}
+
+			[[nodiscard]]
+			static bool IsOverlappedScenePreloadAllowed()
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_isOverlappedScenePreloadAllowed;
+			}
+
+			[[nodiscard]]
+			static bool HasActiveDrawerInLayer(Layer layer)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				return s_pInstance->m_drawExecutor.drawerExistsInLayer(layer);
+			}
+
+			static void SetProfilerSink([[maybe_unused]] IProfilerSink* pProfilerSink)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+#ifdef COTASKLIB_ENABLE_PROFILER
+				s_pInstance->m_pProfilerSink = pProfilerSink;
+				s_pInstance->m_drawExecutor.setProfilerSink(pProfilerSink);
+#endif
+			}
+
+			[[nodiscard]]
+			static Array<TaskProfile> TaskProfiles()
+			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				const AwaiterID id = s_pInstance->m_nextAwaiterID++;
-				std::function<void(const IAwaiter*)> finishCallbackTypeErased =
-					[finishCallback = std::move(finishCallback), cancelCallback/*コピーキャプチャ*/, id](const IAwaiter* awaiter)
+				Array<TaskProfile> profiles;
+#ifdef COTASKLIB_ENABLE_PROFILER
+				const auto fnAppend = [&profiles](const AwaiterEntry& entry)
 					{
-						auto fnGetResult = [awaiter, cancelCallback]() -> TResult
+						const AwaiterEntry::ProfileRecord& record = entry.profile;
+						profiles.push_back(TaskProfile
 							{
-								try
-								{
-									// awaiterの型がTaskAwaiter<TResult>であることは保証されるため、static_castでキャストして問題ない
-									return static_cast<const TaskAwaiter<TResult>*>(awaiter)->value();
-								}
-								catch (...)
-								{
-									// 例外を捕捉した場合はキャンセル扱いにした上で例外を投げ直す
-									if (cancelCallback)
-									{
-										cancelCallback();
-									}
-									throw;
-								}
-							};
-						if constexpr (std::is_void_v<TResult>)
-						{
-							fnGetResult(); // 例外伝搬のためにvoidでも呼び出す
-							if (finishCallback)
-							{
-								finishCallback();
-							}
-						}
-						else
-						{
-							auto result = fnGetResult();
-							if (finishCallback)
-							{
-								finishCallback(std::move(result));
-							}
-						}
+								.name = record.name,
+								.fileName = record.hasLocation ? Unicode::Widen(record.location.file_name()) : String{},
+								.line = record.hasLocation ? static_cast<uint32>(record.location.line()) : 0,
+								.resumeCount = record.resumeCount,
+								.totalResumeTime = Duration{ record.totalResumeNanosec / 1'000'000'000.0 },
+							});
 					};
-				s_pInstance->m_awaiterEntries.emplace(id,
-					AwaiterEntry
+				for (const AwaiterEntry& entry : s_pInstance->m_awaiterEntries)
+				{
+					if (entry.awaiter)
 					{
-						.awaiter = std::move(awaiter),
-						.finishCallback = std::move(finishCallbackTypeErased),
-						.cancelCallback = std::move(cancelCallback),
-					});
-				return id;
+						fnAppend(entry);
+					}
+				}
+				for (const ParkedAwaiter& parked : s_pInstance->m_parkedAwaiters)
+				{
+					fnAppend(parked.entry);
+				}
+#endif
+				return profiles;
 			}
 
-			static bool Remove(AwaiterID id)
+			static void SetPriority(AwaiterID id, TaskPriority priority)
 			{
 				if (!s_pInstance)
 				{
-					// Note: ユーザーがインスタンスをstaticで持ってしまった場合にAddon解放後に呼ばれるケースが起こりうるので、ここでは例外を出さない
-					return false;
+					throw Error{ U"Backend is not initialized" };
 				}
-				if (id == s_pInstance->m_currentAwaiterID)
+				if (!s_pInstance->findAwaiterEntry(id))
 				{
-					// 実行中タスクのAwaiterをここで削除するとアクセス違反やイテレータ破壊が起きるため、代わりに削除フラグを立てて実行完了時に削除
-					// (例えば、タスク実行のライフタイムをOptional<ScopedTaskRunner>型のメンバ変数として持ち、タスク実行中にそこへnoneを代入して実行を止める場合が該当)
-					if (!s_pInstance->m_currentAwaiterRemovalNeeded)
-					{
-						s_pInstance->m_currentAwaiterRemovalNeeded = true;
-						return true;
-					}
-					return false;
+					// 完了済み
+					return;
 				}
-				const auto it = s_pInstance->m_awaiterEntries.find(id);
-				if (it != s_pInstance->m_awaiterEntries.end())
+				AwaiterSlot& slot = s_pInstance->m_awaiterSlots[SlotIndexOf(id)];
+				if (slot.priority == priority)
 				{
-					it->second.callEndCallback();
-					s_pInstance->m_awaiterEntries.erase(it);
-					return true;
+					return;
 				}
-				return false;
+				if (slot.priority == TaskPriority::Normal)
+				{
+					++s_pInstance->m_nonNormalPriorityCount;
+				}
+				else if (priority == TaskPriority::Normal)
+				{
+					--s_pInstance->m_nonNormalPriorityCount;
+				}
+				slot.priority = priority;
+				slot.deferredUpdateCount = 0;
 			}
 
 			[[nodiscard]]
-			static bool IsDone(AwaiterID id)
+			static TaskPriority Priority(AwaiterID id)
 			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				const auto it = s_pInstance->m_awaiterEntries.find(id);
-				if (it != s_pInstance->m_awaiterEntries.end())
+				if (!s_pInstance->findAwaiterEntry(id))
 				{
-					return it->second.awaiter->done();
+					return TaskPriority::Normal;
 				}
-				return id < s_pInstance->m_nextAwaiterID;
+				return s_pInstance->m_awaiterSlots[SlotIndexOf(id)].priority;
 			}
 
-			static void ManualUpdate()
+			static void SetFrameBudget(Duration budget, ISteadyClock* pSteadyClock)
 			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				s_pInstance->update();
+				if (budget < Duration::zero())
+				{
+					throw Error{ U"Co::SetFrameBudget: budget must not be negative" };
+				}
+				s_pInstance->m_frameBudgetMicrosec = static_cast<uint64>(budget.count() * 1'000'000);
+				s_pInstance->m_pFrameBudgetClock = pSteadyClock;
+			}
+
+			static void SetMaxDeferredUpdates(uint32 maxDeferredUpdates)
+			{
+				if (!s_pInstance)
+				{
+					throw Error{ U"Backend is not initialized" };
+				}
+				s_pInstance->m_maxDeferredUpdates = maxDeferredUpdates;
 			}
 
 			[[nodiscard]]
-			static DrawerID AddDrawer(IDrawerInternal* pDrawer, Layer layer, int32 drawIndex)
+			static TaskPriorityStats PriorityStats(TaskPriority priority)
 			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				return s_pInstance->m_drawExecutor.add(layer, drawIndex, pDrawer);
+				const std::size_t index = static_cast<std::size_t>(priority);
+				if (index >= NumTaskPriorities)
+				{
+					throw Error{ U"Co::GetTaskPriorityStats: Invalid TaskPriority" };
+				}
+				return s_pInstance->m_priorityStats[index];
 			}
 
-			static void SetDrawerLayer(DrawerID id, Layer layer)
+			static void ResetPriorityStats()
 			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				s_pInstance->m_drawExecutor.setDrawerLayer(id, layer);
+				s_pInstance->m_priorityStats = {};
 			}
 
-			static void SetDrawerDrawIndex(DrawerID id, int32 drawIndex)
+			[[nodiscard]]
+			static MemoryCensus Census()
 			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				s_pInstance->m_drawExecutor.setDrawerDrawIndex(id, drawIndex);
+				MemoryCensus census;
+				TaskMemoryUsage usage;
+				for (const AwaiterEntry& entry : s_pInstance->m_awaiterEntries)
+				{
+					if (entry.awaiter)
+					{
+						++census.taskCount;
+						AddTaskMemoryUsage(entry.awaiter.get(), usage);
+					}
+				}
+				for (const ParkedAwaiter& parked : s_pInstance->m_parkedAwaiters)
+				{
+					++census.taskCount;
+					++census.parkedTaskCount;
+					AddTaskMemoryUsage(parked.entry.awaiter.get(), usage);
+				}
+				census.frameCount = usage.frameCount;
+				census.frameBytes = usage.frameBytes;
+				census.companionCount = usage.companionCount;
+				census.companionBytes = usage.companionBytes;
+				census.backendBytes = s_pInstance->m_awaiterEntries.capacity() * sizeof(AwaiterEntry)
+					+ s_pInstance->m_awaiterSlots.capacity() * sizeof(AwaiterSlot)
+					+ s_pInstance->m_freeAwaiterSlotIndices.capacity() * sizeof(uint32)
+					+ s_pInstance->m_parkedAwaiters.capacity() * sizeof(ParkedAwaiter);
+				census.drawerCount = s_pInstance->m_drawExecutor.drawerCount();
+				census.drawerBytes = s_pInstance->m_drawExecutor.allocatedBytes();
+				return census;
 			}
 
-			static void RemoveDrawer(DrawerID id)
+			// 登録順(休止中のタスクは末尾)に返す
+			[[nodiscard]]
+			static Array<LiveTaskInfo> LiveTasks()
 			{
 				if (!s_pInstance)
 				{
-					// Note: ユーザーがインスタンスをstaticで持ってしまった場合にAddon解放後に呼ばれるケースが起こりうるので、ここでは例外を出さない
-					return;
+					throw Error{ U"Backend is not initialized" };
 				}
-				s_pInstance->m_drawExecutor.remove(id);
+				Array<LiveTaskInfo> infos;
+				const auto fnAppend = [&infos](const AwaiterEntry& entry, bool isParked)
+					{
+						TaskMemoryUsage usage;
+						AddTaskMemoryUsage(entry.awaiter.get(), usage);
+						LiveTaskInfo info
+						{
+							.ageUpdateCount = s_pInstance->m_updateCount - entry.addedUpdateCount,
+							.isParked = isParked,
+							.frameCount = usage.frameCount,
+							.frameBytes = usage.frameBytes,
+						};
+#ifdef COTASKLIB_ENABLE_PROFILER
+						info.name = entry.profile.name;
+						if (entry.profile.hasLocation)
+						{
+							info.fileName = Unicode::Widen(entry.profile.location.file_name());
+							info.line = static_cast<uint32>(entry.profile.location.line());
+						}
+#endif
+						infos.push_back(std::move(info));
+					};
+				for (const AwaiterEntry& entry : s_pInstance->m_awaiterEntries)
+				{
+					if (entry.awaiter)
+					{
+						fnAppend(entry, false);
+					}
+				}
+				for (const ParkedAwaiter& parked : s_pInstance->m_parkedAwaiters)
+				{
+					fnAppend(parked.entry, true);
+				}
+				return infos;
 			}
 
 			[[nodiscard]]
-			static bool HasActiveDrawerInLayer(Layer layer)
+			static Duration LastLayerDrawTime([[maybe_unused]] Layer layer)
 			{
 				if (!s_pInstance)
 				{
 					throw Error{ U"Backend is not initialized" };
 				}
-				return s_pInstance->m_drawExecutor.drawerExistsInLayer(layer);
+#ifdef COTASKLIB_ENABLE_PROFILER
+				return Duration{ s_pInstance->m_drawExecutor.lastLayerDrawNanosec(layer) / 1'000'000'000.0 };
+#else
+				return Duration{ 0 };
+#endif
 			}
 		};
 
-		template <typename TResult>
-		[[nodiscard]]
-		Optional<AwaiterID> ResumeAwaiterOnceAndRegisterIfNotDone(TaskAwaiter<TResult>&& awaiter, FinishCallbackType<TResult> finishCallback, std::function<void()> cancelCallback)
+		inline TaskGroupState::TaskGroupState(ISteadyClock* pSourceClock)
+			: m_pSourceClock(pSourceClock)
+			, m_lastSourceMicrosec(sourceMicrosec())
+		{
+		}
+
+		inline double TaskGroupState::sourceMicrosec() const
+		{
+			if (m_pSourceClock)
+			{
+				return static_cast<double>(Backend::SteadyClockMicrosec(m_pSourceClock));
+			}
+			return Backend::SceneTime() * 1'000'000.0;
+		}
+
+		inline void TaskGroupState::advance()
+		{
+			const double currentMicrosec = sourceMicrosec();
+			if (!m_isPaused)
+			{
+				m_elapsedMicrosec += (currentMicrosec - m_lastSourceMicrosec) * m_timeScale;
+			}
+			m_lastSourceMicrosec = currentMicrosec;
+		}
+
+		// initial_suspend後の最初のresumeを、実行するTaskGroupに所属した状態で行うためのスコープ
+		class CurrentTaskGroupScope
+		{
+		private:
+			TaskGroupState* m_pPrevTaskGroup;
+
+		public:
+			explicit CurrentTaskGroupScope(TaskGroupState* pTaskGroup) noexcept
+				: m_pPrevTaskGroup(Backend::ExchangeCurrentTaskGroup(pTaskGroup))
+			{
+			}
+
+			CurrentTaskGroupScope(const CurrentTaskGroupScope&) = delete;
+
+			CurrentTaskGroupScope& operator=(const CurrentTaskGroupScope&) = delete;
+
+			~CurrentTaskGroupScope()
+			{
+				(void)Backend::ExchangeCurrentTaskGroup(m_pPrevTaskGroup);
+			}
+		};
+
+		// タスクを登録したBackendを、スコープを抜けるまで呼び出し元スレッドでの実行先とする
+		// (ScopedTaskRunnerの操作を、破棄・参照時点の実行先ではなく、タスクを登録したBackendへ向けるために使用)
+		class OwnerBackendScope
 		{
-			const auto fnCallFinishCallback = [&]
+		private:
+			std::shared_ptr<Backend> m_pOwner;
+
+			Backend* m_pPrevBackend = nullptr;
+
+		public:
+			explicit OwnerBackendScope(const std::weak_ptr<Backend>& owner) noexcept
+				: m_pOwner(owner.lock())
+			{
+				if (m_pOwner)
 				{
-					if constexpr (std::is_void_v<TResult>)
-					{
-						try
-						{
-							awaiter.value(); // 例外伝搬のためにvoidでも呼び出す
-						}
-						catch (...)
-						{
-							if (cancelCallback)
-							{
-								cancelCallback();
-							}
-							throw;
-						}
+					m_pPrevBackend = Backend::BindCurrent(m_pOwner.get());
+				}
+			}
 
-						if (finishCallback)
-						{
-							finishCallback();
-						}
-					}
-					else
-					{
-						auto result = [&]() -> TResult
-							{
-								try
-								{
-									return awaiter.value();
-								}
-								catch (...)
-								{
-									if (cancelCallback)
-									{
-										cancelCallback();
-									}
-									throw;
-								}
-							}();
-						if (finishCallback)
-						{
-							finishCallback(std::move(result));
-						}
-					}
-				};
+			OwnerBackendScope(const OwnerBackendScope&) = delete;
+
+			OwnerBackendScope& operator=(const OwnerBackendScope&) = delete;
+
+			~OwnerBackendScope()
+			{
+				if (m_pOwner)
+				{
+					Backend::BindCurrent(m_pPrevBackend);
+				}
+			}
+
+			// タスクを登録したBackendが破棄済みでないかどうか(破棄済みの場合、タスクも破棄済み)
+			[[nodiscard]]
+			explicit operator bool() const noexcept
+			{
+				return m_pOwner != nullptr;
+			}
+		};
+
+		inline void SignalSleeper::onPark(AwaiterID id, uint32 parkSerial)
+		{
+			m_parkedID = id;
+			m_parkSerial = parkSerial;
+			m_isParked = true;
+
+			// Note: 休止はBackendのupdate中に行われるため、現在の実行先が休止させたBackendとなる
+			m_pParkedBackend = Backend::CurrentWeak();
+		}
+
+		inline void SignalSleeper::notify()
+		{
+			if (m_isParked)
+			{
+				m_isParked = false;
+
+				// Executor内で通知された場合も、休止させたBackendを起床させる
+				const OwnerBackendScope ownerScope{ m_pParkedBackend };
+				if (ownerScope)
+				{
+					Backend::Wake(m_parkedID, m_parkSerial);
+				}
+			}
+		}
+
+		inline InputWaiterNode::~InputWaiterNode()
+		{
+			Backend::RemoveInputWaiter(*this);
+		}
+
+		template <typename TResult, typename TAwaiter>
+		void InvokeFinishCallback(TAwaiter& awaiter, const FinishCallbackType<TResult>& finishCallback, const std::function<void()>& cancelCallback);
+
+		// 一度resumeし、未完了の場合のみTRegisteredAwaiterとしてBackendへ登録する
+		template <typename TRegisteredAwaiter, typename TResult, typename TAwaiter>
+		[[nodiscard]]
+		Optional<AwaiterID> ResumeAwaiterOnceAndRegisterAs(TAwaiter&& awaiter, FinishCallbackType<TResult> finishCallback, std::function<void()> cancelCallback, const std::shared_ptr<TaskGroupState>& pTaskGroup)
+		{
+			static_assert(!std::is_lvalue_reference_v<TAwaiter>, "awaiter must be an rvalue");
 
 			// フレーム待ちなしで終了した場合は登録不要
 			// (ここで一度resumeするのは、runScoped実行まで開始を遅延させるためにinitial_suspendをsuspend_alwaysにしているため)
 			if (awaiter.done())
 			{
-				fnCallFinishCallback();
+				InvokeFinishCallback<TResult>(awaiter, finishCallback, cancelCallback);
 				return none;
 			}
-			awaiter.resume();
+			{
+				// Note: TaskGroupを指定しない場合も、resume中のタスクのTaskGroupを引き継がないようnullptrを設定する
+				const CurrentTaskGroupScope taskGroupScope{ pTaskGroup.get() };
+				awaiter.resume();
+			}
 			if (awaiter.done())
 			{
-				fnCallFinishCallback();
+				InvokeFinishCallback<TResult>(awaiter, finishCallback, cancelCallback);
 				return none;
 			}
 
-			return Backend::Add(std::make_unique<TaskAwaiter<TResult>>(std::move(awaiter)), std::move(finishCallback), std::move(cancelCallback));
+			// Note: Awaiterとコールバックは1つのブロックにまとめて確保される(コールバックなしの場合は追加の確保は発生しない)
+			const AwaiterID id = Backend::Add(std::make_unique<TRegisteredAwaiter>(std::move(awaiter), std::move(finishCallback), std::move(cancelCallback)));
+			if (pTaskGroup)
+			{
+				Backend::JoinTaskGroup(id, pTaskGroup);
+			}
+			return id;
+		}
+
+		template <typename TResult>
+		[[nodiscard]]
+		Optional<AwaiterID> ResumeAwaiterOnceAndRegisterIfNotDone(TaskAwaiter<TResult>&& awaiter, FinishCallbackType<TResult> finishCallback, std::function<void()> cancelCallback, const std::shared_ptr<TaskGroupState>& pTaskGroup = nullptr)
+		{
+			return ResumeAwaiterOnceAndRegisterAs<RegisteredTaskAwaiter<TResult>, TResult>(std::move(awaiter), std::move(finishCallback), std::move(cancelCallback), pTaskGroup);
 		}
 
 		template <typename TResult>
@@ -674,17 +3670,166 @@ namespace cotasklib::Co
 		return std::suspend_always{};
 	}
 
+	class ScopedTaskRunner;
+
 	class MultiRunner;
 
+	// 一時停止状態と時間スケールを共有するタスクのグループ
+	// (コピーしたインスタンス同士は状態を共有する)
+	class TaskGroup
+	{
+	private:
+		friend class ScopedTaskRunner;
+
+		friend class MultiRunner;
+
+		std::shared_ptr<detail::TaskGroupState> m_pState;
+
+	public:
+		// Note: pSourceClockを指定しない場合、Scene::Time()を元に時間を進める
+		explicit TaskGroup(ISteadyClock* pSourceClock = nullptr)
+			: m_pState(std::make_shared<detail::TaskGroupState>(pSourceClock))
+		{
+		}
+
+		// 一時停止中は、所属するタスクをresumeせず、TaskGroupの時計も進めない
+		void setPaused(bool isPaused)
+		{
+			if (m_pState->isPaused() == isPaused)
+			{
+				return;
+			}
+			m_pState->setPaused(isPaused);
+			if (!isPaused)
+			{
+				detail::Backend::WakeTaskGroupMembers(*m_pState);
+			}
+		}
+
+		[[nodiscard]]
+		bool isPaused() const noexcept
+		{
+			return m_pState->isPaused();
+		}
+
+		// 所属するタスク内で時計を指定せずに構築したDelayなどの時間待ちは、時間スケールを掛けた速さで進む
+		void setTimeScale(double timeScale)
+		{
+			m_pState->setTimeScale(timeScale);
+		}
+
+		[[nodiscard]]
+		double timeScale() const noexcept
+		{
+			return m_pState->timeScale();
+		}
+
+		// 一時停止と時間スケールを反映した時計
+		[[nodiscard]]
+		ISteadyClock* clock() const noexcept
+		{
+			return m_pState.get();
+		}
+
+		// 所属する実行中のタスクの数
+		[[nodiscard]]
+		std::size_t size() const noexcept
+		{
+			return m_pState->memberIDs.size();
+		}
+
+		[[nodiscard]]
+		bool empty() const noexcept
+		{
+			return m_pState->memberIDs.empty();
+		}
+
+		// 所属するタスクを全てキャンセルする
+		// (ランナーを個別に走査せず、Backendが保持する所属タスクの一覧から削除する)
+		bool requestCancelAll()
+		{
+			return detail::Backend::RemoveTaskGroupMembers(*m_pState);
+		}
+	};
+
 	class ScopedTaskRunner
 	{
 	private:
 		Optional<detail::AwaiterID> m_id;
 
-	public:
+		// タスクを登録したBackend
+		// (AwaiterIDはBackendごとに振られるため、Co::Executorの切り替え外で破棄・参照された場合も登録先のBackendに対して操作する)
+		// Note: m_idの登録後に取得するため、m_idより後に宣言する
+		std::weak_ptr<detail::Backend> m_pOwner = detail::Backend::CurrentWeak();
+
+		friend class MultiRunner;
+
+		// 実行完了時に通知されるよう登録する(すでに完了している場合はfalseを返す)
+		bool addFinishWaiter(detail::WaiterNode& node, detail::SignalSleeper* pSleeper) const
+		{
+			if (!m_id.has_value())
+			{
+				return false;
+			}
+			const detail::OwnerBackendScope ownerScope{ m_pOwner };
+			return ownerScope && detail::Backend::AddFinishWaiter(*m_id, node, pSleeper);
+		}
+
+		// 実行完了時にMultiRunnerの状態へ、MultiRunner上の添字とともに通知されるよう登録する(すでに完了している場合はfalseを返す)
+		bool trackFinish(const std::shared_ptr<detail::RunnerTracker>& pTracker, std::size_t index) const
+		{
+			if (!m_id.has_value())
+			{
+				return false;
+			}
+			const detail::OwnerBackendScope ownerScope{ m_pOwner };
+			return ownerScope && detail::Backend::TrackFinish(*m_id, pTracker, static_cast<uint32>(index));
+		}
+
+		// MultiRunner上の添字が変わった場合に、通知する添字を更新する
+		void setTrackerIndex(std::size_t index) const
+		{
+			if (!m_id.has_value())
+			{
+				return;
+			}
+			if (const detail::OwnerBackendScope ownerScope{ m_pOwner })
+			{
+				detail::Backend::SetTrackerIndex(*m_id, static_cast<uint32>(index));
+			}
+		}
+
+		// タスクを登録したBackendから削除する
+		bool removeFromOwner() const
+		{
+			const detail::OwnerBackendScope ownerScope{ m_pOwner };
+			return ownerScope && detail::Backend::Remove(*m_id);
+		}
+
+	public:
+		template <typename TResult>
+		explicit ScopedTaskRunner(Task<TResult>&& task, FinishCallbackType<TResult> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)
+			: m_id(ResumeAwaiterOnceAndRegisterIfNotDone(detail::TaskAwaiter<TResult>{ std::move(task) }, std::move(finishCallback), std::move(cancelCallback)))
+		{
+		}
+
+		// 最初のresumeからTaskGroupに所属した状態で実行する
 		template <typename TResult>
-		explicit ScopedTaskRunner(Task<TResult>&& task, FinishCallbackType<TResult> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)
-			: m_id(ResumeAwaiterOnceAndRegisterIfNotDone(detail::TaskAwaiter<TResult>{ std::move(task) }, std::move(finishCallback), std::move(cancelCallback)))
+		ScopedTaskRunner(Task<TResult>&& task, const TaskGroup& taskGroup, FinishCallbackType<TResult> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)
+			: m_id(ResumeAwaiterOnceAndRegisterIfNotDone(detail::TaskAwaiter<TResult>{ std::move(task) }, std::move(finishCallback), std::move(cancelCallback), taskGroup.m_pState))
+		{
+		}
+
+		// Updaterはコルーチンフレームを介さず、関数オブジェクトを保持したままBackendへ登録される
+		template <typename F>
+		explicit ScopedTaskRunner(Updater<F>&& updater, FinishCallbackType<typename Updater<F>::result_type> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)
+			: m_id(detail::ResumeAwaiterOnceAndRegisterAs<detail::RegisteredUpdater<F>, typename Updater<F>::result_type>(std::move(updater), std::move(finishCallback), std::move(cancelCallback), nullptr))
+		{
+		}
+
+		template <typename F>
+		ScopedTaskRunner(Updater<F>&& updater, const TaskGroup& taskGroup, FinishCallbackType<typename Updater<F>::result_type> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)
+			: m_id(detail::ResumeAwaiterOnceAndRegisterAs<detail::RegisteredUpdater<F>, typename Updater<F>::result_type>(std::move(updater), std::move(finishCallback), std::move(cancelCallback), taskGroup.m_pState))
 		{
 		}
 
@@ -694,6 +3839,7 @@ namespace cotasklib::Co
 
 		ScopedTaskRunner(ScopedTaskRunner&& rhs) noexcept
 			: m_id(rhs.m_id)
+			, m_pOwner(std::move(rhs.m_pOwner))
 		{
 			rhs.m_id.reset();
 		}
@@ -702,9 +3848,10 @@ namespace cotasklib::Co
 		{
 			if (m_id.has_value())
 			{
-				detail::Backend::Remove(*m_id);
+				removeFromOwner();
 			}
 			m_id = rhs.m_id;
+			m_pOwner = std::move(rhs.m_pOwner);
 			rhs.m_id.reset();
 			return *this;
 		}
@@ -713,32 +3860,97 @@ namespace cotasklib::Co
 		{
 			if (m_id.has_value())
 			{
-				detail::Backend::Remove(*m_id);
+				removeFromOwner();
 			}
 		}
 
 		[[nodiscard]]
 		bool done() const
 		{
-			return !m_id.has_value() || detail::Backend::IsDone(*m_id);
+			if (!m_id.has_value())
+			{
+				return true;
+			}
+
+			// 登録先のBackendが破棄済みの場合は、タスクも破棄済み
+			const detail::OwnerBackendScope ownerScope{ m_pOwner };
+			return !ownerScope || detail::Backend::IsDone(*m_id);
 		}
 
 		void forget()
 		{
-			m_id.reset();
+			if (m_id.has_value())
+			{
+				// 手放した時点でdone()がtrueになるため、waitUntilDoneで待っている側へ通知する
+				const detail::AwaiterID id = *m_id;
+				m_id.reset();
+				if (const detail::OwnerBackendScope ownerScope{ m_pOwner })
+				{
+					detail::Backend::NotifyFinishWaiters(id);
+				}
+			}
 		}
 
 		bool requestCancel()
 		{
 			if (m_id.has_value())
 			{
-				const bool removed = detail::Backend::Remove(*m_id);
+				const bool removed = removeFromOwner();
 				m_id.reset();
 				return removed;
 			}
 			return false;
 		}
 
+		// 実行の優先度を設定する(完了済みの場合は何もしない)
+		void setPriority(TaskPriority priority)
+		{
+			if (m_id.has_value())
+			{
+				if (const detail::OwnerBackendScope ownerScope{ m_pOwner })
+				{
+					detail::Backend::SetPriority(*m_id, priority);
+				}
+			}
+		}
+
+		[[nodiscard]]
+		TaskPriority priority() const
+		{
+			if (m_id.has_value())
+			{
+				if (const detail::OwnerBackendScope ownerScope{ m_pOwner })
+				{
+					return detail::Backend::Priority(*m_id);
+				}
+			}
+			return TaskPriority::Normal;
+		}
+
+		// TaskGroupに所属させる(他のTaskGroupに所属していた場合は移動する。完了済みの場合は何もしない)
+		void joinGroup(const TaskGroup& taskGroup) const
+		{
+			if (m_id.has_value())
+			{
+				if (const detail::OwnerBackendScope ownerScope{ m_pOwner })
+				{
+					detail::Backend::JoinTaskGroup(*m_id, taskGroup.m_pState);
+				}
+			}
+		}
+
+		// TaskGroupから外す(TaskGroupの一時停止により止まっていた場合は再開する)
+		void leaveGroup() const
+		{
+			if (m_id.has_value())
+			{
+				if (const detail::OwnerBackendScope ownerScope{ m_pOwner })
+				{
+					detail::Backend::LeaveTaskGroup(*m_id);
+				}
+			}
+		}
+
 		void addTo(MultiRunner& mr)&&;
 
 		[[nodiscard]]
@@ -748,11 +3960,149 @@ namespace cotasklib::Co
 		Task<void> waitUntilDone() const&& = delete;
 	};
 
+	// 複数のタスクの実行をまとめて保持する
+	// (完了判定・完了済みの要素の削除は各要素を走査せず、Backendから通知された完了数と完了した要素の添字で行う)
+	// Note: removeDone()・自動削除は、取り除いた要素の位置へ末尾の要素を移動するため、要素の順序を保持しない
 	class MultiRunner
 	{
 	private:
+		template <typename TResult>
+		friend class Task;
+
+		template <typename F>
+		friend class Updater;
+
+		// Note: 要素の破棄時に完了通知を受けるため、m_runnersより先に宣言する
+		mutable std::shared_ptr<detail::RunnerTracker> m_pTracker;
+
+		// 要素を所属させるTaskGroup
+		Optional<TaskGroup> m_taskGroup;
+
 		Array<ScopedTaskRunner> m_runners;
 
+		// 非constの参照を返した要素の添字と、その時点の実行
+		// (要素がムーブ・代入で差し替えられた場合に、次回の完了判定時にその要素のみを追跡し直す)
+		struct AccessedElement
+		{
+			uint32 index;
+			Optional<detail::AwaiterID> id;
+			std::weak_ptr<detail::Backend> pOwner;
+		};
+
+		mutable Array<AccessedElement> m_accessedElements;
+
+		// 非constのイテレータを返したかどうか(立っている場合は次回の完了判定時に全要素を追跡し直す)
+		mutable bool m_isTrackerDirty = false;
+
+		bool m_isAutoRemoveDoneEnabled = false;
+
+		[[nodiscard]]
+		detail::RunnerTracker& tracker() const
+		{
+			if (!m_pTracker)
+			{
+				m_pTracker = std::make_shared<detail::RunnerTracker>();
+			}
+			if (m_isTrackerDirty)
+			{
+				retrackAll();
+			}
+			else if (!m_accessedElements.empty())
+			{
+				retrackAccessedElements();
+			}
+			return *m_pTracker;
+		}
+
+		// 非constのイテレータにより要素がムーブ・代入された可能性があるため、新しい状態で全要素を追跡し直す
+		// (古い状態はBackend側の弱参照が切れるため、以降は通知されない。イテレータによる走査と同じくO(n)となる)
+		void retrackAll() const
+		{
+			m_isTrackerDirty = false;
+			m_accessedElements.clear();
+
+			auto pNewTracker = std::make_shared<detail::RunnerTracker>(std::move(m_pTracker->waiters));
+			pNewTracker->pAutoRemoveOwner = std::exchange(m_pTracker->pAutoRemoveOwner, nullptr);
+			m_pTracker = std::move(pNewTracker);
+			for (std::size_t index = 0; index < m_runners.size(); ++index)
+			{
+				if (!m_runners[index].trackFinish(m_pTracker, index))
+				{
+					m_pTracker->finishedIndices.push_back(static_cast<uint32>(index));
+				}
+			}
+			m_pTracker->waiters.notifyAll();
+		}
+
+		// 非constの参照を返した要素のうち、実行が差し替えられた要素のみを追跡し直す
+		void retrackAccessedElements() const
+		{
+			// 同じ要素へ複数回アクセスした場合は、最初のアクセス時点の実行を追跡から外せばよい
+			std::stable_sort(m_accessedElements.begin(), m_accessedElements.end(), [](const AccessedElement& a, const AccessedElement& b) { return a.index < b.index; });
+			m_accessedElements.erase(std::unique(m_accessedElements.begin(), m_accessedElements.end(), [](const AccessedElement& a, const AccessedElement& b) { return a.index == b.index; }), m_accessedElements.end());
+
+			const auto isReplaced = [this](const AccessedElement& accessed)
+				{
+					const ScopedTaskRunner& runner = m_runners[accessed.index];
+					return runner.m_id != accessed.id
+						|| runner.m_pOwner.owner_before(accessed.pOwner)
+						|| accessed.pOwner.owner_before(runner.m_pOwner);
+				};
+
+			// Note: 要素同士を入れ替えた場合に備え、先に全ての元の実行を追跡から外してから、新しい実行を追跡する
+			bool anyReplaced = false;
+			for (const AccessedElement& accessed : m_accessedElements)
+			{
+				if (accessed.index >= m_runners.size() || !isReplaced(accessed) || !accessed.id.has_value())
+				{
+					continue;
+				}
+				if (const detail::OwnerBackendScope ownerScope{ accessed.pOwner })
+				{
+					detail::Backend::UntrackFinish(*accessed.id, *m_pTracker);
+				}
+			}
+			for (const AccessedElement& accessed : m_accessedElements)
+			{
+				if (accessed.index >= m_runners.size() || !isReplaced(accessed))
+				{
+					continue;
+				}
+				anyReplaced = true;
+				if (!m_runners[accessed.index].trackFinish(m_pTracker, accessed.index))
+				{
+					m_pTracker->finishedIndices.push_back(accessed.index);
+				}
+			}
+			m_accessedElements.clear();
+
+			if (anyReplaced)
+			{
+				m_pTracker->waiters.notifyAll();
+			}
+		}
+
+		[[nodiscard]]
+		ScopedTaskRunner& accessElement(ScopedTaskRunner& runner, std::size_t index)
+		{
+			if (!m_isTrackerDirty)
+			{
+				m_accessedElements.push_back(AccessedElement{ static_cast<uint32>(index), runner.m_id, runner.m_pOwner });
+			}
+			return runner;
+		}
+
+		[[nodiscard]]
+		std::size_t doneCount() const
+		{
+			return m_runners.size() - tracker().liveCount;
+		}
+
+		void markTrackerDirty() noexcept
+		{
+			m_isTrackerDirty = true;
+		}
+
 	public:
 		MultiRunner() = default;
 
@@ -760,15 +4110,116 @@ namespace cotasklib::Co
 
 		MultiRunner& operator=(const MultiRunner&) = delete;
 
-		MultiRunner(MultiRunner&&) = default;
+		MultiRunner(MultiRunner&& rhs)
+			: m_pTracker(std::move(rhs.m_pTracker))
+			, m_taskGroup(std::move(rhs.m_taskGroup))
+			, m_runners(std::move(rhs.m_runners))
+			, m_accessedElements(std::move(rhs.m_accessedElements))
+			, m_isTrackerDirty(std::exchange(rhs.m_isTrackerDirty, false))
+			, m_isAutoRemoveDoneEnabled(rhs.m_isAutoRemoveDoneEnabled)
+		{
+			if (m_pTracker && m_pTracker->pAutoRemoveOwner)
+			{
+				m_pTracker->pAutoRemoveOwner = this;
+			}
+		}
 
-		MultiRunner& operator=(MultiRunner&&) = default;
+		MultiRunner& operator=(MultiRunner&& rhs)
+		{
+			if (m_pTracker)
+			{
+				m_pTracker->pAutoRemoveOwner = nullptr;
+			}
+			m_runners = std::move(rhs.m_runners);
+			m_taskGroup = std::move(rhs.m_taskGroup);
+
+			// 待機側は再度完了判定を行うため、双方の待機に通知する
+			const auto pOldTracker = std::move(m_pTracker);
+			m_pTracker = std::move(rhs.m_pTracker);
+			m_accessedElements = std::move(rhs.m_accessedElements);
+			m_isTrackerDirty = std::exchange(rhs.m_isTrackerDirty, false);
+			m_isAutoRemoveDoneEnabled = rhs.m_isAutoRemoveDoneEnabled;
+			if (m_pTracker && m_pTracker->pAutoRemoveOwner)
+			{
+				m_pTracker->pAutoRemoveOwner = this;
+			}
+			if (pOldTracker)
+			{
+				pOldTracker->waiters.notifyAll();
+			}
+			if (m_pTracker)
+			{
+				m_pTracker->waiters.notifyAll();
+			}
+			return *this;
+		}
 
-		~MultiRunner() = default;
+		~MultiRunner()
+		{
+			// 要素の破棄時の完了通知で、破棄中のMultiRunnerが自動削除の対象とならないようにする
+			if (m_pTracker)
+			{
+				m_pTracker->pAutoRemoveOwner = nullptr;
+			}
+		}
 
 		void add(ScopedTaskRunner&& runner)
 		{
+			if (m_isAutoRemoveDoneEnabled)
+			{
+				removeDone();
+			}
+			detail::RunnerTracker& runnerTracker = tracker();
+			const std::size_t index = m_runners.size();
+			if (!runner.trackFinish(m_pTracker, index))
+			{
+				runnerTracker.finishedIndices.push_back(static_cast<uint32>(index));
+			}
+			if (m_taskGroup)
+			{
+				runner.joinGroup(*m_taskGroup);
+			}
 			m_runners.push_back(std::move(runner));
+			runnerTracker.waiters.notifyAll();
+		}
+
+		// 現在の要素と、以降に追加する要素をTaskGroupに所属させる
+		void joinGroup(const TaskGroup& taskGroup)
+		{
+			m_taskGroup = taskGroup;
+			for (const ScopedTaskRunner& runner : m_runners)
+			{
+				runner.joinGroup(taskGroup);
+			}
+		}
+
+		// 現在の要素をTaskGroupから外し、以降に追加する要素も所属させない
+		void leaveGroup()
+		{
+			m_taskGroup.reset();
+			for (const ScopedTaskRunner& runner : m_runners)
+			{
+				runner.leaveGroup();
+			}
+		}
+
+		// 有効にすると、完了済みの要素を自動で取り除く(removeDoneを毎フレーム呼ぶ必要がなくなる)
+		// (要素が完了したupdateの終了時と、add時に取り除く)
+		// Note: 有効な場合、co_awaitをまたいで要素への参照・イテレータを保持しないこと
+		void setAutoRemoveDone(bool enabled)
+		{
+			m_isAutoRemoveDoneEnabled = enabled;
+			tracker().pAutoRemoveOwner = enabled ? this : nullptr;
+			if (enabled)
+			{
+				removeDone();
+			}
+		}
+
+		[[nodiscard]]
+		bool isAutoRemoveDoneEnabled() const noexcept
+		{
+			return m_isAutoRemoveDoneEnabled;
 		}
 
 		void reserve(std::size_t size)
@@ -778,7 +4229,10 @@ namespace cotasklib::Co
 
 		void clear()
 		{
+			// 要素から取り出された実行を追跡から外してから破棄する
+			detail::RunnerTracker& runnerTracker = tracker();
 			m_runners.clear();
+			runnerTracker.finishedIndices.clear();
 		}
 
 		[[nodiscard]]
@@ -801,6 +4255,7 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		auto begin() noexcept
 		{
+			markTrackerDirty();
 			return m_runners.begin();
 		}
 
@@ -813,6 +4268,7 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		auto end() noexcept
 		{
+			markTrackerDirty();
 			return m_runners.end();
 		}
 
@@ -837,6 +4293,7 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		auto rbegin() noexcept
 		{
+			markTrackerDirty();
 			return m_runners.rbegin();
 		}
 
@@ -849,6 +4306,7 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		auto rend() noexcept
 		{
+			markTrackerDirty();
 			return m_runners.rend();
 		}
 
@@ -873,7 +4331,7 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		ScopedTaskRunner& operator[](size_t index)
 		{
-			return m_runners[index];
+			return accessElement(m_runners[index], index);
 		}
 
 		[[nodiscard]]
@@ -885,7 +4343,7 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		ScopedTaskRunner& at(size_t index)
 		{
-			return m_runners.at(index);
+			return accessElement(m_runners.at(index), index);
 		}
 
 		[[nodiscard]]
@@ -894,9 +4352,33 @@ namespace cotasklib::Co
 			return m_runners.at(index);
 		}
 
+		// 完了済みの要素を取り除く(完了した要素の数に比例する時間で済み、完了していない要素は走査しない)
 		void removeDone()
 		{
-			m_runners.remove_if([](const ScopedTaskRunner& runner) { return runner.done(); });
+			detail::RunnerTracker& runnerTracker = tracker();
+			Array<uint32>& finishedIndices = runnerTracker.finishedIndices;
+			if (finishedIndices.empty())
+			{
+				return;
+			}
+
+			// 後ろの要素から取り除くことで、取り除いた位置へ移動する末尾の要素は処理済みの(完了済みでない)要素となる
+			std::sort(finishedIndices.begin(), finishedIndices.end(), std::greater<>{});
+			finishedIndices.erase(std::unique(finishedIndices.begin(), finishedIndices.end()), finishedIndices.end());
+			for (const uint32 index : finishedIndices)
+			{
+				if (index >= m_runners.size() || !m_runners[index].done())
+				{
+					continue;
+				}
+				if (index != m_runners.size() - 1)
+				{
+					m_runners[index] = std::move(m_runners.back());
+					m_runners[index].setTrackerIndex(index);
+				}
+				m_runners.pop_back();
+			}
+			finishedIndices.clear();
 		}
 
 		bool requestCancelAll()
@@ -912,16 +4394,18 @@ namespace cotasklib::Co
 			return anyCanceled;
 		}
 
+		// Note: 完了判定は各要素を走査せず、Backendから通知された完了数で行う
+
 		[[nodiscard]]
 		bool allDone() const
 		{
-			return std::all_of(m_runners.begin(), m_runners.end(), [](const ScopedTaskRunner& runner) { return runner.done(); });
+			return tracker().liveCount == 0;
 		}
 
 		[[nodiscard]]
 		bool anyDone() const
 		{
-			return std::any_of(m_runners.begin(), m_runners.end(), [](const ScopedTaskRunner& runner) { return runner.done(); });
+			return doneCount() > 0;
 		}
 
 		[[nodiscard]]
@@ -942,6 +4426,14 @@ namespace cotasklib::Co
 		mr.add(std::move(*this));
 	}
 
+	namespace detail
+	{
+		inline void RemoveDoneRunners(MultiRunner& mr)
+		{
+			mr.removeDone();
+		}
+	}
+
 	namespace DrawIndex
 	{
 		constexpr int32 Back = -1;
@@ -1020,8 +4512,97 @@ namespace cotasklib::Co
 				detail::Backend::SetDrawerDrawIndex(*m_drawerID, drawIndex);
 			}
 		}
+
+		// falseを指定すると、登録したまま描画を省略する
+		void setVisible(bool isVisible)
+		{
+			if (m_drawerID.has_value())
+			{
+				detail::Backend::SetDrawerVisible(*m_drawerID, isVisible);
+			}
+		}
+
+		// プロファイラ(COTASKLIB_ENABLE_PROFILERを定義した場合のみ有効)に表示する名前を指定する
+		// (指定しない場合は型名が使用されるが、関数オブジェクトを描画するScopedDrawerでは区別できないため、指定を推奨)
+		void setProfileName([[maybe_unused]] StringView name)
+		{
+#ifdef COTASKLIB_ENABLE_PROFILER
+			if (m_drawerID.has_value())
+			{
+				detail::Backend::SetDrawerProfileName(*m_drawerID, name);
+			}
+#endif
+		}
+	};
+
+	// 生存中、指定レイヤーより下のレイヤーで待機している領域へのマウス入力を遮断する
+	// (モーダルなUIの表示中に、背後のレイヤーのWaitUntilLeftClickedなどが完了しないようにするために使用)
+	class ScopedInputBlocker
+	{
+	private:
+		Optional<uint64> m_blockerID;
+
+	public:
+		// 画面全体を遮断する
+		explicit ScopedInputBlocker(Layer layer)
+			: m_blockerID(detail::Backend::AddInputBlocker(layer, none))
+		{
+		}
+
+		// 指定した領域のみを遮断する
+		ScopedInputBlocker(Layer layer, const RectF& area)
+			: m_blockerID(detail::Backend::AddInputBlocker(layer, area))
+		{
+		}
+
+		ScopedInputBlocker(const ScopedInputBlocker&) = delete;
+
+		ScopedInputBlocker& operator=(const ScopedInputBlocker&) = delete;
+
+		ScopedInputBlocker(ScopedInputBlocker&& rhs) noexcept
+			: m_blockerID(rhs.m_blockerID)
+		{
+			rhs.m_blockerID.reset();
+		}
+
+		ScopedInputBlocker& operator=(ScopedInputBlocker&& rhs) = delete;
+
+		~ScopedInputBlocker()
+		{
+			if (m_blockerID.has_value())
+			{
+				detail::Backend::RemoveInputBlocker(*m_blockerID);
+			}
+		}
 	};
 
+	// レイヤーの描画結果をキャッシュするかどうかを設定する
+	// キャッシュしたレイヤーは、無効化されるまでDrawerを呼ばずに前回の描画結果のテクスチャを描画する
+	// (Drawerの追加・削除・drawIndexの変更・表示状態の変更、シーンのサイズの変更時は自動的に無効化される。それ以外で描画内容が変わる場合はInvalidateLayerCacheを呼ぶ)
+	inline void SetLayerCached(Layer layer, bool isCached)
+	{
+		detail::Backend::SetLayerCached(layer, isCached);
+	}
+
+	[[nodiscard]]
+	inline bool IsLayerCached(Layer layer)
+	{
+		return detail::Backend::IsLayerCached(layer);
+	}
+
+	// キャッシュしたレイヤーを次回の描画時に描画し直す
+	inline void InvalidateLayerCache(Layer layer)
+	{
+		detail::Backend::InvalidateLayerCache(layer);
+	}
+
+	// 指定レイヤーより上のレイヤーのScopedInputBlockerが現在のカーソル位置を覆っているかどうか
+	[[nodiscard]]
+	inline bool IsInputBlocked(Layer layer)
+	{
+		return detail::Backend::IsInputBlocked(layer);
+	}
+
 	namespace detail
 	{
 		class ScopedDrawerInternal
@@ -1061,6 +4642,11 @@ namespace cotasklib::Co
 			{
 				Backend::SetDrawerDrawIndex(m_drawerID, drawIndex);
 			}
+
+			void setVisible(bool isVisible)
+			{
+				Backend::SetDrawerVisible(m_drawerID, isVisible);
+			}
 		};
 
 		template <typename TResult>
@@ -1097,10 +4683,56 @@ namespace cotasklib::Co
 		using result_type = TResult;
 		using finish_callback_type = FinishCallbackType<TResult>;
 
-	private:
-		handle_type m_handle;
-		Array<std::unique_ptr<ITask>> m_concurrentTasksBefore;
-		Array<std::unique_ptr<ITask>> m_concurrentTasksAfter;
+	private:
+		// Note: with()で追加した並行タスクはPromise側で保持するため、Taskはハンドルのみを持つ
+		handle_type m_handle;
+
+		template <typename TResultOther>
+		friend class detail::TaskAwaiter;
+
+		template <typename TResultOther>
+		friend class Task;
+
+		[[nodiscard]]
+		bool hasActiveConcurrentTasks() const
+		{
+			return m_handle && m_handle.promise().hasActiveCompanions();
+		}
+
+		template <typename TResultOther>
+		void addConcurrentTask(Task<TResultOther>&& task, WithTiming timing)
+		{
+			if (!task.m_handle)
+			{
+				// 空のタスクは何もしないため保持不要
+				return;
+			}
+			m_handle.promise().addCompanion(&task.m_handle.promise(), timing);
+			task.m_handle = nullptr;
+		}
+
+		[[nodiscard]]
+		detail::PromiseBase* promise() const
+		{
+			return m_handle ? &m_handle.promise() : nullptr;
+		}
+
+		[[nodiscard]]
+		detail::ISleeper* sleeper() const
+		{
+			if (!m_handle || m_handle.done())
+			{
+				return nullptr;
+			}
+
+			// 並行実行中のタスクがある場合は毎フレームのresumeが必要なため休止できない
+			if (hasActiveConcurrentTasks())
+			{
+				return nullptr;
+			}
+
+			return m_handle.promise().sleeper();
+		}
 
     public:
 		explicit Task(handle_type h)
@@ -1114,8 +4746,6 @@ namespace cotasklib::Co
 
 		Task(Task<TResult>&& rhs) noexcept
             : m_handle(rhs.m_handle)
-            , m_concurrentTasksBefore(std::move(rhs.m_concurrentTasksBefore))
-            , m_concurrentTasksAfter(std::move(rhs.m_concurrentTasksAfter))
         {
             rhs.m_handle = nullptr;
         }
@@ -1132,25 +4762,11 @@ namespace cotasklib::Co
 
 		virtual void resume() override
 		{
-			if (!m_handle || m_handle.done())
+			if (!m_handle)
 			{
 				return;
 			}
-
-			for (auto& task : m_concurrentTasksBefore)
-			{
-				task->resume();
-			}
-
-			if (!m_handle.promise().resumeSubAwaiter())
-			{
-				m_handle.resume();
-			}
-
-			for (auto& task : m_concurrentTasksAfter)
-			{
-				task->resume();
-			}
+			m_handle.promise().resumeTask();
 		}
 
 		[[nodiscard]]
@@ -1199,7 +4815,7 @@ namespace cotasklib::Co
 			{
 				return std::move(*this);
 			}
-			m_concurrentTasksAfter.push_back(std::make_unique<Task<TResultOther>>(std::move(task)));
+			addConcurrentTask(std::move(task), WithTiming::After);
 			return std::move(*this);
 		}
 
@@ -1219,11 +4835,8 @@ namespace cotasklib::Co
 			switch (timing)
 			{
 			case WithTiming::Before:
-				m_concurrentTasksBefore.push_back(std::make_unique<Task<TResultOther>>(std::move(task)));
-				break;
-
 			case WithTiming::After:
-				m_concurrentTasksAfter.push_back(std::make_unique<Task<TResultOther>>(std::move(task)));
+				addConcurrentTask(std::move(task), timing);
 				break;
 
 			default:
@@ -1253,15 +4866,43 @@ namespace cotasklib::Co
 				}(std::move(*this));
 		}
 
+		// プロファイラ(COTASKLIB_ENABLE_PROFILERを定義した場合のみ有効)に表示する名前を指定する
+		// 呼び出し位置も併せて記録される。Backendから直接実行されるタスクに対してのみ意味を持つ
+		[[nodiscard]]
+		Task<TResult> named([[maybe_unused]] StringView name, [[maybe_unused]] const std::source_location& location = std::source_location::current())&&
+		{
+#ifdef COTASKLIB_ENABLE_PROFILER
+			if (m_handle)
+			{
+				m_handle.promise().setProfileName(name, location);
+			}
+#endif
+			return std::move(*this);
+		}
+
 		[[nodiscard]]
 		ScopedTaskRunner runScoped(FinishCallbackType<TResult> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)&&
 		{
 			return ScopedTaskRunner{ std::move(*this), std::move(finishCallback), std::move(cancelCallback) };
 		}
 
+		[[nodiscard]]
+		ScopedTaskRunner runScoped(const TaskGroup& taskGroup, FinishCallbackType<TResult> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)&&
+		{
+			return ScopedTaskRunner{ std::move(*this), taskGroup, std::move(finishCallback), std::move(cancelCallback) };
+		}
+
 		void runAddTo(MultiRunner& mr, FinishCallbackType<TResult> finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)&&
 		{
-			mr.add(ScopedTaskRunner{ std::move(*this), std::move(finishCallback), std::move(cancelCallback) });
+			// Note: MultiRunnerがTaskGroupに所属している場合は、最初のresumeから所属させる
+			if (mr.m_taskGroup)
+			{
+				mr.add(ScopedTaskRunner{ std::move(*this), *mr.m_taskGroup, std::move(finishCallback), std::move(cancelCallback) });
+			}
+			else
+			{
+				mr.add(ScopedTaskRunner{ std::move(*this), std::move(finishCallback), std::move(cancelCallback) });
+			}
 		}
 
 		[[nodiscard]]
@@ -1302,71 +4943,548 @@ namespace cotasklib::Co
 		return Task<void>{ nullptr };
 	}
 
+	// コルーチンフレーム用アロケータの統計情報(スレッドごとに集計)
+	struct FrameAllocatorStats
+	{
+		// フリーリストのサイズクラスの数(サイズクラスiは(i+1)*64バイト以下のブロックを表す)
+		static constexpr std::size_t NumSizeClasses = 16;
+
+		// コルーチンフレームの確保回数
+		uint64 allocateCount = 0;
+
+		// コルーチンフレームの解放回数
+		uint64 deallocateCount = 0;
+
+		// フリーリストから確保できた回数
+		uint64 poolHitCount = 0;
+
+		// グローバルヒープから確保した回数
+		uint64 heapAllocateCount = 0;
+
+		// グローバルヒープへ返却した回数
+		uint64 heapDeallocateCount = 0;
+
+		// フリーリストに保持されているブロック数
+		uint64 cachedBlockCount = 0;
+
+		// 使用中のコルーチンフレームの数とバイト数(サイズクラスへの切り上げ後の実際の確保サイズ)、およびそれぞれの最大値
+		// Note: 確保・解放は呼び出し元スレッドの値で数えるため、別スレッドで確保されたブロックを解放した場合、確保したスレッドの値は減らず、解放したスレッドの値が負になりうる
+		//       (確保元のスレッドを記録すると全ての確保・解放でスレッド間の同期が必要になるため記録しない。全スレッドの値の合計は正しい)
+		int64 liveFrameCount = 0;
+		int64 liveFrameBytes = 0;
+		int64 peakLiveFrameCount = 0;
+		int64 peakLiveFrameBytes = 0;
+
+		// サイズクラスごとの使用中のコルーチンフレームの数(最後の要素はフリーリストの対象外の大きさのもの)
+		std::array<int64, NumSizeClasses + 1> liveFrameCountsBySizeClass{};
+
+		// 使用中の実行登録用ブロック(runScoped等で確保されるAwaiterと完了時・キャンセル時のコールバック)の数とバイト数、およびそれぞれの最大値
+		int64 liveEntryCount = 0;
+		int64 liveEntryBytes = 0;
+		int64 peakLiveEntryCount = 0;
+		int64 peakLiveEntryBytes = 0;
+
+		[[nodiscard]]
+		double poolHitRate() const noexcept
+		{
+			if (allocateCount == 0)
+			{
+				return 0.0;
+			}
+			return static_cast<double>(poolHitCount) / static_cast<double>(allocateCount);
+		}
+	};
+
 	namespace detail
 	{
+		// コルーチンフレーム用のサイズクラス別フリーリストアロケータ
+		// Note: フリーリストはスレッドごとに保持するため、ロックは不要。別スレッドで解放されたブロックはそのスレッドのフリーリストへ返却される
+		class FrameAllocator
+		{
+		public:
+			static constexpr std::size_t SizeClassGranularity = 64;
+
+			static constexpr std::size_t NumSizeClasses = FrameAllocatorStats::NumSizeClasses;
+
+			static constexpr std::size_t MaxPooledSize = SizeClassGranularity * NumSizeClasses;
+
+			static constexpr std::size_t MaxCachedBlocksPerSizeClass = 256;
+
+			// 確保するブロックの用途(統計情報の集計先)
+			enum class AllocationKind : uint8
+			{
+				// コルーチンフレーム
+				Frame,
+
+				// 実行登録用ブロック
+				Entry,
+			};
+
+		private:
+			struct FreeBlock
+			{
+				FreeBlock* pNext;
+			};
+
+			// Note: スレッド終了後(thread_localの破棄後)にも解放が呼ばれうるため、トリビアルに破棄可能な型のみで構成し、後始末はGuardのデストラクタで行う
+			struct ThreadCache
+			{
+				std::array<FreeBlock*, NumSizeClasses> freeLists{};
+				std::array<std::size_t, NumSizeClasses> freeListSizes{};
+				FrameAllocatorStats stats;
+				bool isReleased = false;
+
+				// 直前に確保したコルーチンフレームのサイズ(Promiseのコンストラクタで受け取る)
+				std::size_t lastFrameSize = 0;
+			};
+
+			struct ThreadCacheGuard
+			{
+				~ThreadCacheGuard()
+				{
+					ReleaseCache();
+					Cache().isReleased = true;
+				}
+			};
+
+			static inline std::atomic<bool> s_enabled = false;
+
+			[[nodiscard]]
+			static ThreadCache& Cache() noexcept
+			{
+				static thread_local ThreadCache cache;
+				return cache;
+			}
+
+			static void EnsureGuard() noexcept
+			{
+				static thread_local ThreadCacheGuard guard;
+				(void)guard;
+			}
+
+			[[nodiscard]]
+			static constexpr std::size_t SizeClassIndex(std::size_t size) noexcept
+			{
+				return (size + SizeClassGranularity - 1) / SizeClassGranularity - 1;
+			}
+
+			[[nodiscard]]
+			static constexpr std::size_t RoundedSize(std::size_t size) noexcept
+			{
+				// 有効・無効の切り替え前後でブロックサイズが食い違わないよう、無効時もサイズクラスに切り上げて確保する
+				return size <= MaxPooledSize ? (SizeClassIndex(size) + 1) * SizeClassGranularity : size;
+			}
+
+			static void AddLive(FrameAllocatorStats& stats, AllocationKind kind, std::size_t size, int64 sign) noexcept
+			{
+				const int64 bytes = sign * static_cast<int64>(RoundedSize(size));
+				if (kind == AllocationKind::Frame)
+				{
+					stats.liveFrameCount += sign;
+					stats.liveFrameBytes += bytes;
+					stats.peakLiveFrameCount = Max(stats.peakLiveFrameCount, stats.liveFrameCount);
+					stats.peakLiveFrameBytes = Max(stats.peakLiveFrameBytes, stats.liveFrameBytes);
+					stats.liveFrameCountsBySizeClass[size != 0 && size <= MaxPooledSize ? SizeClassIndex(size) : NumSizeClasses] += sign;
+				}
+				else
+				{
+					stats.liveEntryCount += sign;
+					stats.liveEntryBytes += bytes;
+					stats.peakLiveEntryCount = Max(stats.peakLiveEntryCount, stats.liveEntryCount);
+					stats.peakLiveEntryBytes = Max(stats.peakLiveEntryBytes, stats.liveEntryBytes);
+				}
+			}
+
+		public:
+			[[nodiscard]]
+			static void* Allocate(std::size_t size, AllocationKind kind = AllocationKind::Frame)
+			{
+				ThreadCache& cache = Cache();
+				++cache.stats.allocateCount;
+				AddLive(cache.stats, kind, size, 1);
+				if (kind == AllocationKind::Frame)
+				{
+					cache.lastFrameSize = RoundedSize(size);
+				}
+
+				// Note: 無効にした後はフリーリストに残っているブロックも使用しない(ReleaseCacheを呼ぶまでは保持したまま)
+				if (size != 0 && size <= MaxPooledSize && !cache.isReleased && s_enabled.load(std::memory_order_relaxed))
+				{
+					const std::size_t index = SizeClassIndex(size);
+					if (FreeBlock* pBlock = cache.freeLists[index])
+					{
+						cache.freeLists[index] = pBlock->pNext;
+						--cache.freeListSizes[index];
+						--cache.stats.cachedBlockCount;
+						++cache.stats.poolHitCount;
+						return pBlock;
+					}
+				}
+
+				++cache.stats.heapAllocateCount;
+				return ::operator new(RoundedSize(size));
+			}
+
+			static void Deallocate(void* p, std::size_t size, AllocationKind kind = AllocationKind::Frame) noexcept
+			{
+				if (!p)
+				{
+					return;
+				}
+
+				ThreadCache& cache = Cache();
+				++cache.stats.deallocateCount;
+				AddLive(cache.stats, kind, size, -1);
+
+				if (size != 0 && size <= MaxPooledSize && !cache.isReleased && s_enabled.load(std::memory_order_relaxed))
+				{
+					const std::size_t index = SizeClassIndex(size);
+					if (cache.freeListSizes[index] < MaxCachedBlocksPerSizeClass)
+					{
+						EnsureGuard();
+						FreeBlock* pBlock = static_cast<FreeBlock*>(p);
+						pBlock->pNext = cache.freeLists[index];
+						cache.freeLists[index] = pBlock;
+						++cache.freeListSizes[index];
+						++cache.stats.cachedBlockCount;
+						return;
+					}
+				}
+
+				++cache.stats.heapDeallocateCount;
+				::operator delete(p, RoundedSize(size));
+			}
+
+			static void SetEnabled(bool enabled) noexcept
+			{
+				s_enabled.store(enabled, std::memory_order_relaxed);
+			}
+
+			[[nodiscard]]
+			static bool IsEnabled() noexcept
+			{
+				return s_enabled.load(std::memory_order_relaxed);
+			}
+
+			// 呼び出し元スレッドのフリーリストに保持しているブロックをすべてグローバルヒープへ返却する
+			static void ReleaseCache() noexcept
+			{
+				ThreadCache& cache = Cache();
+				for (std::size_t index = 0; index < NumSizeClasses; ++index)
+				{
+					FreeBlock* pBlock = cache.freeLists[index];
+					while (pBlock)
+					{
+						FreeBlock* pNext = pBlock->pNext;
+						::operator delete(pBlock, (index + 1) * SizeClassGranularity);
+						++cache.stats.heapDeallocateCount;
+						pBlock = pNext;
+					}
+					cache.freeLists[index] = nullptr;
+					cache.freeListSizes[index] = 0;
+				}
+				cache.stats.cachedBlockCount = 0;
+			}
+
+			[[nodiscard]]
+			static const FrameAllocatorStats& Stats() noexcept
+			{
+				return Cache().stats;
+			}
+
+			// 直前に確保したコルーチンフレームのサイズを取り出す(確保が省略された場合は0)
+			[[nodiscard]]
+			static std::size_t TakeLastFrameSize() noexcept
+			{
+				return std::exchange(Cache().lastFrameSize, 0);
+			}
+
+			// Note: 使用中のブロックの値は保持し、最大値は現在の値から計測し直す
+			static void ResetStats() noexcept
+			{
+				ThreadCache& cache = Cache();
+				const FrameAllocatorStats prevStats = cache.stats;
+				cache.stats = FrameAllocatorStats{};
+				cache.stats.cachedBlockCount = prevStats.cachedBlockCount;
+				cache.stats.liveFrameCount = cache.stats.peakLiveFrameCount = prevStats.liveFrameCount;
+				cache.stats.liveFrameBytes = cache.stats.peakLiveFrameBytes = prevStats.liveFrameBytes;
+				cache.stats.liveFrameCountsBySizeClass = prevStats.liveFrameCountsBySizeClass;
+				cache.stats.liveEntryCount = cache.stats.peakLiveEntryCount = prevStats.liveEntryCount;
+				cache.stats.liveEntryBytes = cache.stats.peakLiveEntryBytes = prevStats.liveEntryBytes;
+			}
+		};
+
+		template <typename TResult>
+		class [[nodiscard]] TaskAwaiter : public detail::IAwaiter
+		{
+			static_assert(!std::is_reference_v<TResult>, "TResult must not be a reference type");
+			static_assert(std::is_move_constructible_v<TResult> || std::is_void_v<TResult>, "TResult must be move constructible");
+			static_assert(!std::is_const_v<TResult>, "TResult must not have 'const' qualifier");
+
+		private:
+			Task<TResult> m_task;
+
+		public:
+			explicit TaskAwaiter(Task<TResult>&& task)
+				: m_task(std::move(task))
+			{
+			}
+
+			TaskAwaiter(const TaskAwaiter<TResult>&) = delete;
+
+			TaskAwaiter<TResult>& operator=(const TaskAwaiter<TResult>&) = delete;
+
+			TaskAwaiter(TaskAwaiter<TResult>&& rhs) noexcept = default;
+
+			TaskAwaiter<TResult>& operator=(TaskAwaiter<TResult>&& rhs) = delete;
+
+			void resume() override
+			{
+				m_task.resume();
+			}
+
+			[[nodiscard]]
+			bool done() const override
+			{
+				return m_task.done();
+			}
+
+			[[nodiscard]]
+			ISleeper* sleeper() const override
+			{
+				return m_task.sleeper();
+			}
+
+			[[nodiscard]]
+			PromiseBase* promise() const override
+			{
+				return m_task.promise();
+			}
+
+			[[nodiscard]]
+			bool hasActiveConcurrentTasks() const override
+			{
+				return m_task.hasActiveConcurrentTasks();
+			}
+
+			[[nodiscard]]
+			bool await_ready()
+			{
+				return m_task.done();
+			}
+
+			template <typename TResultOther>
+			bool await_suspend(std::coroutine_handle<detail::Promise<TResultOther>> handle)
+			{
+				resume();
+				if (m_task.done())
+				{
+					// フレーム待ちなしで終了した場合は登録不要
+					return false;
+				}
+				handle.promise().setSubAwaiter(this);
+				m_task.promise()->setParent(&handle.promise());
+				return true;
+			}
+
+			TResult await_resume() const
+			{
+				return m_task.value();
+			}
+
+			[[nodiscard]]
+			TResult value() const
+			{
+				return m_task.value();
+			}
+		};
+
+		// 完了したAwaiterから結果を取り出し、完了時のコールバックを呼ぶ
+		template <typename TResult, typename TAwaiter>
+		void InvokeFinishCallback(TAwaiter& awaiter, const FinishCallbackType<TResult>& finishCallback, const std::function<void()>& cancelCallback)
+		{
+			const auto fnGetResult = [&]() -> TResult
+				{
+					try
+					{
+						// 結果は取り出すため右辺値として取得する
+						return std::move(awaiter).value();
+					}
+					catch (...)
+					{
+						// 例外を捕捉した場合はキャンセル扱いにした上で例外を投げ直す
+						if (cancelCallback)
+						{
+							cancelCallback();
+						}
+						throw;
+					}
+				};
+			if constexpr (std::is_void_v<TResult>)
+			{
+				fnGetResult(); // 例外伝搬のためにvoidでも呼び出す
+				if (finishCallback)
+				{
+					finishCallback();
+				}
+			}
+			else
+			{
+				auto result = fnGetResult();
+				if (finishCallback)
+				{
+					finishCallback(std::move(result));
+				}
+			}
+		}
+
+		// Backendに登録されたタスクのAwaiter
+		// (完了・キャンセル時のコールバックをAwaiterと同じブロックに保持し、ブロックはコルーチンフレーム用アロケータから確保する)
 		template <typename TResult>
-		class [[nodiscard]] TaskAwaiter : public detail::IAwaiter
+		class RegisteredTaskAwaiter final : public TaskAwaiter<TResult>
 		{
-			static_assert(!std::is_reference_v<TResult>, "TResult must not be a reference type");
-			static_assert(std::is_move_constructible_v<TResult> || std::is_void_v<TResult>, "TResult must be move constructible");
-			static_assert(!std::is_const_v<TResult>, "TResult must not have 'const' qualifier");
-
 		private:
-			Task<TResult> m_task;
+			FinishCallbackType<TResult> m_finishCallback;
+
+			std::function<void()> m_cancelCallback;
 
 		public:
-			explicit TaskAwaiter(Task<TResult>&& task)
-				: m_task(std::move(task))
+			RegisteredTaskAwaiter(TaskAwaiter<TResult>&& awaiter, FinishCallbackType<TResult>&& finishCallback, std::function<void()>&& cancelCallback)
+				: TaskAwaiter<TResult>(std::move(awaiter))
+				, m_finishCallback(std::move(finishCallback))
+				, m_cancelCallback(std::move(cancelCallback))
 			{
 			}
 
-			TaskAwaiter(const TaskAwaiter<TResult>&) = delete;
+			[[nodiscard]]
+			static void* operator new(std::size_t size)
+			{
+				return FrameAllocator::Allocate(size, FrameAllocator::AllocationKind::Entry);
+			}
 
-			TaskAwaiter<TResult>& operator=(const TaskAwaiter<TResult>&) = delete;
+			static void operator delete(void* p, std::size_t size) noexcept
+			{
+				FrameAllocator::Deallocate(p, size, FrameAllocator::AllocationKind::Entry);
+			}
 
-			TaskAwaiter(TaskAwaiter<TResult>&& rhs) noexcept = default;
+			// 完了済みの場合は結果を取り出して完了時のコールバックを、未完了の場合はキャンセル時のコールバックを呼ぶ
+			static void CallEndCallback(IAwaiter* pAwaiter)
+			{
+				// AwaiterEntryに登録される関数はawaiterの型に対応するため、static_castでキャストして問題ない
+				auto* pSelf = static_cast<RegisteredTaskAwaiter<TResult>*>(pAwaiter);
+				if (pSelf->done())
+				{
+					InvokeFinishCallback<TResult>(*pSelf, pSelf->m_finishCallback, pSelf->m_cancelCallback);
+				}
+				else if (pSelf->m_cancelCallback)
+				{
+					pSelf->m_cancelCallback();
+				}
+			}
+		};
 
-			TaskAwaiter<TResult>& operator=(TaskAwaiter<TResult>&& rhs) = delete;
+		// Task::with()で並行実行するタスクの一覧
+		// (コルーチンフレームにはポインタ1つ分のみを持つ。並行タスクが1つの場合はそのPromiseを直接指し、2つ目の追加時に初めて一覧をヒープに確保する)
+		class CompanionList
+		{
+		private:
+			struct Companion
+			{
+				PromiseBase* pPromise;
+				WithTiming timing;
+			};
 
-			void resume() override
+			// 下位ビットのタグ(Promise・Arrayはいずれも4バイト以上にアラインされるため、下位2ビットは常に0)
+			// - 並行タスクが1つの場合: そのPromiseのポインタ。WithTiming::Afterの場合はAfterBitを立てる
+			// - 並行タスクが2つ以上の場合: ヒープに確保したArray<Companion>のポインタにSpilledBitを立てる
+			static constexpr std::uintptr_t AfterBit = 0b01;
+			static constexpr std::uintptr_t SpilledBit = 0b10;
+			static constexpr std::uintptr_t TagMask = AfterBit | SpilledBit;
+
+			std::uintptr_t m_bits = 0;
+
+			[[nodiscard]]
+			bool isSpilled() const noexcept
 			{
-				m_task.resume();
+				return (m_bits & SpilledBit) != 0;
 			}
 
 			[[nodiscard]]
-			bool done() const override
+			Array<Companion>* spilledCompanions() const noexcept
 			{
-				return m_task.done();
+				return reinterpret_cast<Array<Companion>*>(m_bits & ~TagMask);
 			}
 
 			[[nodiscard]]
-			bool await_ready()
+			Companion inlineCompanion() const noexcept
 			{
-				return m_task.done();
+				return Companion{ reinterpret_cast<PromiseBase*>(m_bits & ~TagMask), (m_bits & AfterBit) ? WithTiming::After : WithTiming::Before };
 			}
 
-			template <typename TResultOther>
-			bool await_suspend(std::coroutine_handle<detail::Promise<TResultOther>> handle)
+			template <typename Fn>
+			void forEach(Fn fn) const
 			{
-				resume();
-				if (m_task.done())
+				if (m_bits == 0)
 				{
-					// フレーム待ちなしで終了した場合は登録不要
-					return false;
+					return;
+				}
+				if (!isSpilled())
+				{
+					fn(inlineCompanion());
+					return;
+				}
+				for (const Companion& companion : *spilledCompanions())
+				{
+					fn(companion);
 				}
-				handle.promise().setSubAwaiter(this);
-				return true;
 			}
 
-			TResult await_resume() const
+			void destroyAll() noexcept;
+
+		public:
+			CompanionList() = default;
+
+			CompanionList(const CompanionList&) = delete;
+
+			CompanionList& operator=(const CompanionList&) = delete;
+
+			CompanionList(CompanionList&& rhs) noexcept
+				: m_bits(std::exchange(rhs.m_bits, 0))
 			{
-				return m_task.value();
 			}
 
+			CompanionList& operator=(CompanionList&&) = delete;
+
+			~CompanionList()
+			{
+				destroyAll();
+			}
+
+			// 並行タスクのコルーチンフレームの所有権を受け取る
+			void add(PromiseBase* pPromise, WithTiming timing);
+
+			[[nodiscard]]
+			bool empty() const noexcept
+			{
+				return m_bits == 0;
+			}
+
+			void resume(WithTiming timing);
+
 			[[nodiscard]]
-			TResult value() const
+			bool hasActive() const;
+
+			template <typename Fn>
+			void forEachPromise(Fn fn) const
 			{
-				return m_task.value();
+				forEach([&fn](const Companion& companion) { fn(static_cast<const PromiseBase*>(companion.pPromise)); });
+			}
+
+			// 並行タスクの一覧のために追加で確保しているバイト数
+			[[nodiscard]]
+			std::size_t overflowBytes() const noexcept
+			{
+				return isSpilled() ? sizeof(Array<Companion>) + spilledCompanions()->capacity() * sizeof(Companion) : 0;
 			}
 		};
 
@@ -1375,6 +5493,28 @@ namespace cotasklib::Co
 		protected:
 			IAwaiter* m_pSubAwaiter = nullptr;
 
+			ISleeper* m_pSleeper = nullptr;
+
+			// このタスクをco_awaitしている親のPromise(Backendに直接登録されたタスクや、手動でresumeされるタスクの場合はnullptr)
+			PromiseBase* m_pParent = nullptr;
+
+			std::coroutine_handle<> m_handle;
+
+			// Task::with()で追加された並行タスク
+			CompanionList m_companions;
+
+			// このPromiseを含むコルーチンフレームの確保サイズ(確保が省略された場合は0)
+			// Note: コルーチンフレームの確保直後にPromiseが構築されるため、直前の確保サイズをアロケータから受け取る
+			std::size_t m_frameSize = FrameAllocator::TakeLastFrameSize();
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+			// Task::named()で指定されたプロファイラ用の名前と記述位置
+			String m_profileName;
+			Optional<std::source_location> m_profileLocation;
+#endif
+
+			friend class CompanionList;
+
 		public:
 			PromiseBase() = default;
 
@@ -1384,14 +5524,70 @@ namespace cotasklib::Co
 
 			PromiseBase(PromiseBase&& rhs) noexcept
 				: m_pSubAwaiter(rhs.m_pSubAwaiter)
+				, m_pSleeper(rhs.m_pSleeper)
+				, m_pParent(rhs.m_pParent)
+				, m_handle(rhs.m_handle)
+				, m_companions(std::move(rhs.m_companions))
+				, m_frameSize(rhs.m_frameSize)
+#ifdef COTASKLIB_ENABLE_PROFILER
+				, m_profileName(std::move(rhs.m_profileName))
+				, m_profileLocation(rhs.m_profileLocation)
+#endif
 			{
 				rhs.m_pSubAwaiter = nullptr;
+				rhs.m_pSleeper = nullptr;
+				rhs.m_pParent = nullptr;
+				rhs.m_handle = nullptr;
 			}
 
 			PromiseBase& operator=(PromiseBase&& rhs) = delete;
 
 			virtual ~PromiseBase() = 0;
 
+			[[nodiscard]]
+			std::size_t frameSize() const noexcept
+			{
+				return m_frameSize;
+			}
+
+			[[nodiscard]]
+			const CompanionList& companions() const noexcept
+			{
+				return m_companions;
+			}
+#ifdef COTASKLIB_ENABLE_PROFILER
+
+			void setProfileName(StringView name, const std::source_location& location)
+			{
+				m_profileName = name;
+				m_profileLocation = location;
+			}
+
+			[[nodiscard]]
+			const String& profileName() const noexcept
+			{
+				return m_profileName;
+			}
+
+			[[nodiscard]]
+			const Optional<std::source_location>& profileLocation() const noexcept
+			{
+				return m_profileLocation;
+			}
+#endif
+
+			// コルーチンフレームの確保・解放(Co::SetFrameAllocatorEnabledで有効にした場合はフリーリストを使用)
+			[[nodiscard]]
+			static void* operator new(std::size_t size)
+			{
+				return FrameAllocator::Allocate(size);
+			}
+
+			static void operator delete(void* p, std::size_t size) noexcept
+			{
+				FrameAllocator::Deallocate(p, size);
+			}
+
 			auto initial_suspend() noexcept
 			{
 				// suspend_neverにすれば関数呼び出し時点で実行開始されるが、
@@ -1428,10 +5624,142 @@ namespace cotasklib::Co
 			{
 				m_pSubAwaiter = pSubAwaiter;
 			}
+
+			// 子のタスクが完了した後に自身のコルーチンを再開する(Task::resumeでresumeSubAwaiterがfalseを返した場合と同等)
+			void resumeAfterSubAwaiterDone()
+			{
+				m_pSubAwaiter = nullptr;
+				m_handle.resume();
+			}
+
+			[[nodiscard]]
+			IAwaiter* subAwaiter() const noexcept
+			{
+				return m_pSubAwaiter;
+			}
+
+			[[nodiscard]]
+			PromiseBase* parent() const noexcept
+			{
+				return m_pParent;
+			}
+
+			void setParent(PromiseBase* pParent) noexcept
+			{
+				m_pParent = pParent;
+			}
+
+			void setSleeper(ISleeper* pSleeper) noexcept
+			{
+				m_pSleeper = pSleeper;
+			}
+
+			[[nodiscard]]
+			ISleeper* sleeper() const
+			{
+				if (m_pSubAwaiter)
+				{
+					return m_pSubAwaiter->sleeper();
+				}
+				return m_pSleeper;
+			}
+
+			void addCompanion(PromiseBase* pPromise, WithTiming timing)
+			{
+				m_companions.add(pPromise, timing);
+			}
+
+			[[nodiscard]]
+			bool hasActiveCompanions() const
+			{
+				return !m_companions.empty() && m_companions.hasActive();
+			}
+
+			// 並行タスクを含めてタスクを1フレーム分進める(Task::resumeの実体。並行タスクもこの関数で再開するため仮想呼び出しは発生しない)
+			void resumeTask()
+			{
+				if (m_handle.done())
+				{
+					return;
+				}
+
+				const bool hasCompanions = !m_companions.empty();
+				if (hasCompanions)
+				{
+					m_companions.resume(WithTiming::Before);
+				}
+
+				if (!resumeSubAwaiter())
+				{
+					m_handle.resume();
+				}
+
+				if (hasCompanions)
+				{
+					m_companions.resume(WithTiming::After);
+				}
+			}
+
+			[[nodiscard]]
+			bool handleDone() const
+			{
+				return m_handle.done();
+			}
 		};
 
 		inline PromiseBase::~PromiseBase() = default;
 
+		inline void CompanionList::destroyAll() noexcept
+		{
+			// Note: 並行タスクのPromiseは自身のコルーチンフレーム上にあるため、ハンドルを取り出してから破棄する
+			forEach([](const Companion& companion) { std::coroutine_handle<> handle = companion.pPromise->m_handle; handle.destroy(); });
+			if (isSpilled())
+			{
+				delete spilledCompanions();
+			}
+			m_bits = 0;
+		}
+
+		inline void CompanionList::add(PromiseBase* pPromise, WithTiming timing)
+		{
+			static_assert(alignof(PromiseBase) > TagMask && alignof(Array<Companion>) > TagMask, "CompanionList requires the low 2 bits of pointers to be free for tags");
+
+			if (m_bits == 0)
+			{
+				// 1つ目は追加確保せずに直接保持する
+				m_bits = reinterpret_cast<std::uintptr_t>(pPromise) | (timing == WithTiming::After ? AfterBit : 0);
+				return;
+			}
+			if (!isSpilled())
+			{
+				auto pCompanions = std::make_unique<Array<Companion>>();
+				pCompanions->reserve(2);
+				pCompanions->push_back(inlineCompanion());
+				pCompanions->push_back(Companion{ pPromise, timing });
+				m_bits = reinterpret_cast<std::uintptr_t>(pCompanions.release()) | SpilledBit;
+				return;
+			}
+			spilledCompanions()->push_back(Companion{ pPromise, timing });
+		}
+
+		inline void CompanionList::resume(WithTiming timing)
+		{
+			forEach([timing](const Companion& companion)
+				{
+					if (companion.timing == timing)
+					{
+						companion.pPromise->resumeTask();
+					}
+				});
+		}
+
+		inline bool CompanionList::hasActive() const
+		{
+			bool isActive = false;
+			forEach([&](const Companion& companion) { isActive = isActive || !companion.pPromise->handleDone(); });
+			return isActive;
+		}
+
 		template <typename TResult>
 		class Promise : public PromiseBase
 		{
@@ -1440,7 +5768,8 @@ namespace cotasklib::Co
 			static_assert(!std::is_const_v<TResult>, "TResult must not have 'const' qualifier");
 
 		private:
-			std::unique_ptr<TResult> m_value;
+			// Note: 戻り値はヒープに確保せずPromise(コルーチンフレーム)内に直接保持する
+			Optional<TResult> m_value;
 			std::exception_ptr m_exception;
 			bool m_resultConsumed = false;
 
@@ -1453,12 +5782,12 @@ namespace cotasklib::Co
 
 			void return_value(const TResult& v) requires std::is_copy_constructible_v<TResult>
 			{
-				m_value = std::make_unique<TResult>(v);
+				m_value.emplace(v);
 			}
 
 			void return_value(TResult&& v)
 			{
-				m_value = std::make_unique<TResult>(std::move(v));
+				m_value.emplace(std::move(v));
 			}
 
 			[[nodiscard]]
@@ -1483,7 +5812,9 @@ namespace cotasklib::Co
 			[[nodiscard]]
 			Task<TResult> get_return_object()
 			{
-				return Task<TResult>{ Task<TResult>::handle_type::from_promise(*this) };
+				const auto handle = Task<TResult>::handle_type::from_promise(*this);
+				m_handle = handle;
+				return Task<TResult>{ handle };
 			}
 
 			void unhandled_exception()
@@ -1505,64 +5836,192 @@ namespace cotasklib::Co
 
 			Promise(Promise<void>&&) noexcept = default;
 
-			Promise<void>& operator=(Promise<void>&&) = delete;
+			Promise<void>& operator=(Promise<void>&&) = delete;
+
+			void return_void()
+			{
+				m_isResultSet = true;
+			}
+
+			void value()
+			{
+				if (!m_isResultSet && !m_exception)
+				{
+					throw Error{ U"Task is not completed." };
+				}
+				if (m_resultConsumed)
+				{
+					throw Error{ U"Task result can be get only once." };
+				}
+				m_resultConsumed = true;
+				if (m_exception)
+				{
+					std::rethrow_exception(m_exception);
+				}
+			}
+
+			[[nodiscard]]
+			Task<void> get_return_object()
+			{
+				const auto handle = Task<void>::handle_type::from_promise(*this);
+				m_handle = handle;
+				return Task<void>{ handle };
+			}
+
+			void unhandled_exception()
+			{
+				m_exception = std::current_exception();
+			}
+		};
+
+		// 並行タスクを持たず子のタスクを待っているだけの階層を下り、最も内側のAwaiterを求める
+		// (タスク以外のAwaiterは親子関係を持たないため、それを待っているタスクの階層で止める)
+		[[nodiscard]]
+		inline IAwaiter* FindLeafAwaiter(IAwaiter* pAwaiter)
+		{
+			while (!pAwaiter->done() && !pAwaiter->hasActiveConcurrentTasks())
+			{
+				const PromiseBase* const pPromise = pAwaiter->promise();
+				if (!pPromise || !pPromise->subAwaiter() || !pPromise->subAwaiter()->promise())
+				{
+					break;
+				}
+				pAwaiter = pPromise->subAwaiter();
+			}
+			return pAwaiter;
+		}
+
+		// Note: 並行タスクは完了後も親のタスクが完了するまで破棄されないため、完了済みのものも含めて数える
+		inline void AddPromiseMemoryUsage(const PromiseBase* pPromise, TaskMemoryUsage& usage, bool isCompanion)
+		{
+			for (; pPromise; pPromise = pPromise->subAwaiter() ? pPromise->subAwaiter()->promise() : nullptr)
+			{
+				++usage.frameCount;
+				usage.frameBytes += pPromise->frameSize();
+				if (isCompanion)
+				{
+					++usage.companionCount;
+					usage.companionBytes += pPromise->frameSize();
+				}
+				usage.companionBytes += pPromise->companions().overflowBytes();
+				pPromise->companions().forEachPromise([&usage](const PromiseBase* pCompanion) { AddPromiseMemoryUsage(pCompanion, usage, true); });
+			}
+		}
+
+		inline void AddTaskMemoryUsage(const IAwaiter* pAwaiter, TaskMemoryUsage& usage)
+		{
+			AddPromiseMemoryUsage(pAwaiter->promise(), usage, false);
+		}
+
+#ifdef COTASKLIB_ENABLE_PROFILER
+		inline void InitProfileRecord(AwaiterEntry::ProfileRecord& record, const IAwaiter* pAwaiter)
+		{
+			const PromiseBase* const pPromise = pAwaiter->promise();
+			if (!pPromise)
+			{
+				return;
+			}
+			record.name = pPromise->profileName();
+			if (const auto& location = pPromise->profileLocation(); location && location->line() != 0)
+			{
+				record.location = *location;
+				record.hasLocation = true;
+			}
+		}
+
+#endif
+		// Note: 末端より外側の階層は子のタスクを待っているだけなので、ルートからTask::resumeを辿る場合と同じ順で実行される
+		inline IAwaiter* ResumeFromLeaf(IAwaiter* pRootAwaiter, IAwaiter* pLeafAwaiter)
+		{
+			IAwaiter* pAwaiter = pLeafAwaiter ? pLeafAwaiter : FindLeafAwaiter(pRootAwaiter);
+			pAwaiter->resume();
+
+			// 完了した場合のみ親へ遡って再開する
+			while (pAwaiter->done() && pAwaiter != pRootAwaiter)
+			{
+				PromiseBase* const pParent = pAwaiter->promise()->parent();
+				const PromiseBase* const pGrandParent = pParent->parent();
+				IAwaiter* const pParentAwaiter = pGrandParent ? pGrandParent->subAwaiter() : pRootAwaiter;
+
+				// Note: 親の再開によりpAwaiter(親のコルーチンフレーム上にあるTaskAwaiter)は破棄される
+				pParent->resumeAfterSubAwaiterDone();
+				pAwaiter = pParentAwaiter;
+			}
+
+			return FindLeafAwaiter(pAwaiter);
+		}
+
+		// 休止可能な待機対象をawaitする
+		class [[nodiscard]] SleepAwaiter
+		{
+		private:
+			ISleeper* m_pSleeper;
+			PromiseBase* m_pPromise = nullptr;
 
-			void return_void()
+		public:
+			explicit SleepAwaiter(ISleeper* pSleeper) noexcept
+				: m_pSleeper(pSleeper)
 			{
-				m_isResultSet = true;
 			}
 
-			void value()
+			[[nodiscard]]
+			bool await_ready() const noexcept
 			{
-				if (!m_isResultSet && !m_exception)
-				{
-					throw Error{ U"Task is not completed." };
-				}
-				if (m_resultConsumed)
-				{
-					throw Error{ U"Task result can be get only once." };
-				}
-				m_resultConsumed = true;
-				if (m_exception)
-				{
-					std::rethrow_exception(m_exception);
-				}
+				return false;
 			}
 
-			[[nodiscard]]
-			Task<void> get_return_object()
+			template <typename TResult>
+			void await_suspend(std::coroutine_handle<Promise<TResult>> handle) noexcept
 			{
-				return Task<void>{ Task<void>::handle_type::from_promise(*this) };
+				m_pPromise = &handle.promise();
+				m_pPromise->setSleeper(m_pSleeper);
+				Backend::RequestSleepCheck();
 			}
 
-			void unhandled_exception()
+			void await_resume() noexcept
 			{
-				m_exception = std::current_exception();
+				if (m_pPromise)
+				{
+					m_pPromise->setSleeper(nullptr);
+				}
 			}
 		};
 	}
 
+	// Note: 以下の待機はBackendから直接実行されている場合、完了の通知があるまで毎フレームのresumeが省略される
+
 	inline Task<void> ScopedTaskRunner::waitUntilDone() const&
 	{
+		detail::SignalSleeper sleeper;
+		detail::WaiterNode node;
 		while (!done())
 		{
-			co_await NextFrame();
+			addFinishWaiter(node, &sleeper);
+			co_await detail::SleepAwaiter{ &sleeper };
 		}
 	}
 
 	inline Task<void> MultiRunner::waitUntilAllDone() const&
 	{
+		detail::SignalSleeper sleeper;
+		detail::WaiterNode node;
 		while (!allDone())
 		{
-			co_await NextFrame();
+			// 要素の完了・追加時に通知される
+			tracker().waiters.push(node, &sleeper);
+			co_await detail::SleepAwaiter{ &sleeper };
 		}
 	}
 
 	inline Task<void> MultiRunner::waitUntilAnyDone() const&
 	{
+		detail::SignalSleeper sleeper;
+		detail::WaiterNode node;
 		while (!anyDone())
 		{
-			co_await NextFrame();
+			// 要素の完了・追加時に通知される
+			tracker().waiters.push(node, &sleeper);
+			co_await detail::SleepAwaiter{ &sleeper };
 		}
 	}
 
@@ -1574,9 +6033,17 @@ namespace cotasklib::Co
 		static_assert(!std::is_const_v<TResult>, "TResult must not have 'const' qualifier");
 
 	private:
-		std::unique_ptr<TResult> m_result;
+		template <typename F>
+		friend class Updater;
+
+		Optional<TResult> m_result;
 		bool m_resultConsumed = false;
 
+		// ムーブのみ可能な型の結果をwaitForResultでムーブ済みかどうか
+		bool m_resultMovedOut = false;
+
+		mutable detail::WaiterList m_waiters;
+
 	public:
 		TaskFinishSource() = default;
 
@@ -1596,7 +6063,8 @@ namespace cotasklib::Co
 			{
 				return false;
 			}
-			m_result = std::make_unique<TResult>(result);
+			m_result.emplace(result);
+			m_waiters.notifyAll();
 			return true;
 		}
 
@@ -1606,14 +6074,15 @@ namespace cotasklib::Co
 			{
 				return false;
 			}
-			m_result = std::make_unique<TResult>(std::move(result));
+			m_result.emplace(std::move(result));
+			m_waiters.notifyAll();
 			return true;
 		}
 
 		[[nodiscard]]
 		bool hasResult() const noexcept
 		{
-			return m_result != nullptr;
+			return m_result.has_value();
 		}
 
 		// hasResult()がtrueを返す場合のみ呼び出し可能。1回だけ取得でき、2回目以降の呼び出しは例外を投げる
@@ -1624,7 +6093,7 @@ namespace cotasklib::Co
 			{
 				throw Error{ U"TaskFinishSource: result can be get only once. Make sure to check if hasResult() returns true before calling result()." };
 			}
-			if (m_result == nullptr)
+			if (!m_result.has_value())
 			{
 				throw Error{ U"TaskFinishSource: TaskFinishSource does not have a result. Make sure to check if hasResult() returns true before calling result()." };
 			}
@@ -1638,27 +6107,49 @@ namespace cotasklib::Co
 		[[nodiscard]]
 		Task<TResult> waitForResult()
 		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
 			while (!hasResult())
 			{
-				co_await NextFrame();
+				m_waiters.push(node, &sleeper);
+				co_await detail::SleepAwaiter{ &sleeper };
 			}
 			m_resultConsumed = true;
-			co_return *m_result;
+
+			// コピー可能な型は待機しているタスクごとにコピーを返す
+			// (hasResult()の戻り値は変えないよう値は保持したままにする)
+			if constexpr (std::is_copy_constructible_v<TResult>)
+			{
+				co_return *m_result;
+			}
+			else
+			{
+				// ムーブのみ可能な型は1回だけ取得でき、2回目以降の取得は例外を投げる
+				if (m_resultMovedOut)
+				{
+					throw Error{ U"TaskFinishSource: move-only result can be get only once by waitForResult()" };
+				}
+				m_resultMovedOut = true;
+				co_return std::move(*m_result);
+			}
 		}
 
 		[[nodiscard]]
 		Task<void> waitUntilDone() const
 		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
 			while (!done())
 			{
-				co_await NextFrame();
+				m_waiters.push(node, &sleeper);
+				co_await detail::SleepAwaiter{ &sleeper };
 			}
 		}
 
 		[[nodiscard]]
 		bool done() const noexcept
 		{
-			return m_result != nullptr || m_resultConsumed;
+			return m_result.has_value() || m_resultConsumed;
 		}
 	};
 
@@ -1667,6 +6158,7 @@ namespace cotasklib::Co
 	{
 	private:
 		bool m_finishRequested = false;
+		mutable detail::WaiterList m_waiters;
 
 	public:
 		TaskFinishSource() = default;
@@ -1688,15 +6180,19 @@ namespace cotasklib::Co
 				return false;
 			}
 			m_finishRequested = true;
+			m_waiters.notifyAll();
 			return true;
 		}
 
 		[[nodiscard]]
 		Task<void> waitUntilDone() const
 		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
 			while (!done())
 			{
-				co_await NextFrame();
+				m_waiters.push(node, &sleeper);
+				co_await detail::SleepAwaiter{ &sleeper };
 			}
 		}
 
@@ -1751,18 +6247,415 @@ namespace cotasklib::Co
 		}
 	}
 
-	template <typename TResult>
-	auto operator co_await(Task<TResult>&& rhs)
+	namespace detail
+	{
+		template <typename TMemberFunc>
+		struct UpdaterFinishSourceArgTrait;
+
+		template <typename C, typename R, typename TResult>
+		struct UpdaterFinishSourceArgTrait<R (C::*)(TaskFinishSource<TResult>&)>
+		{
+			using type = TResult;
+		};
+
+		template <typename C, typename R, typename TResult>
+		struct UpdaterFinishSourceArgTrait<R (C::*)(TaskFinishSource<TResult>&) const>
+		{
+			using type = TResult;
+		};
+
+		// Updaterに渡す関数オブジェクトの種類(TaskFinishSourceを受け取る場合は、その型から結果の型を決める)
+		template <typename F>
+		struct UpdaterFuncTrait
+		{
+			using result_type = typename UpdaterFinishSourceArgTrait<decltype(&F::operator())>::type;
+			static constexpr bool HasFinishSource = true;
+		};
+
+		template <typename F>
+			requires std::invocable<F&>
+		struct UpdaterFuncTrait<F>
+		{
+			using result_type = void;
+			static constexpr bool HasFinishSource = false;
+		};
+
+		template <typename R, typename TResult>
+		struct UpdaterFuncTrait<R (*)(TaskFinishSource<TResult>&)>
+		{
+			using result_type = TResult;
+			static constexpr bool HasFinishSource = true;
+		};
+	}
+
+	// 毎フレーム関数オブジェクトを呼び出すタスク
+	// (UpdaterTaskと異なり、コルーチンフレームやstd::functionを介さず関数オブジェクトを直接保持して呼び出す)
+	// Note: 関数オブジェクトがTaskFinishSourceを受け取る場合、ジェネリックラムダではなく引数の型を明示する必要がある
+	template <typename F>
+	class [[nodiscard]] Updater : public detail::IAwaiter
+	{
+	public:
+		using function_type = F;
+		using result_type = typename detail::UpdaterFuncTrait<F>::result_type;
+		using finish_callback_type = FinishCallbackType<result_type>;
+
+	private:
+		static constexpr bool HasFinishSource = detail::UpdaterFuncTrait<F>::HasFinishSource;
+
+		F m_func;
+
+		std::conditional_t<HasFinishSource, TaskFinishSource<result_type>, std::monostate> m_finishSource;
+
+		std::exception_ptr m_exception;
+
+	public:
+		explicit Updater(F func)
+			: m_func(std::move(func))
+		{
+		}
+
+		Updater(const Updater&) = delete;
+
+		Updater& operator=(const Updater&) = delete;
+
+		Updater(Updater&&) = default;
+
+		Updater& operator=(Updater&&) = delete;
+
+		void resume() override
+		{
+			if (done())
+			{
+				return;
+			}
+			try
+			{
+				if constexpr (HasFinishSource)
+				{
+					m_func(m_finishSource);
+				}
+				else
+				{
+					m_func();
+				}
+			}
+			catch (...)
+			{
+				// Taskと同様に、例外は結果の取得時に投げ直す
+				m_exception = std::current_exception();
+			}
+		}
+
+		[[nodiscard]]
+		bool done() const override
+		{
+			if (m_exception)
+			{
+				return true;
+			}
+			if constexpr (HasFinishSource)
+			{
+				return m_finishSource.done();
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// 結果を参照する(戻り値ありの場合はconst参照を返し、何度呼んでも同じ結果を参照できる)
+		[[nodiscard]]
+		decltype(auto) value() const&
+		{
+			if (m_exception)
+			{
+				std::rethrow_exception(m_exception);
+			}
+			if constexpr (!std::is_void_v<result_type>)
+			{
+				if (!m_finishSource.m_result.has_value())
+				{
+					throw Error{ U"Updater::value() called before the result is set" };
+				}
+				return static_cast<const result_type&>(*m_finishSource.m_result);
+			}
+		}
+
+		// 結果を取り出す(ムーブのみ可能な型の結果もこちらで取得できる。1回だけ取得できる)
+		[[nodiscard]]
+		result_type value()&&
+		{
+			if (m_exception)
+			{
+				std::rethrow_exception(m_exception);
+			}
+			if constexpr (!std::is_void_v<result_type>)
+			{
+				return m_finishSource.result();
+			}
+		}
+
+		[[nodiscard]]
+		bool await_ready() const
+		{
+			return done();
+		}
+
+		template <typename TResultOther>
+		bool await_suspend(std::coroutine_handle<detail::Promise<TResultOther>> handle)
+		{
+			resume();
+			if (done())
+			{
+				// フレーム待ちなしで終了した場合は待機不要
+				return false;
+			}
+			handle.promise().setSubAwaiter(this);
+			return true;
+		}
+
+		result_type await_resume()
+		{
+			return std::move(*this).value();
+		}
+
+		[[nodiscard]]
+		ScopedTaskRunner runScoped(finish_callback_type finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)&&
+		{
+			return ScopedTaskRunner{ std::move(*this), std::move(finishCallback), std::move(cancelCallback) };
+		}
+
+		[[nodiscard]]
+		ScopedTaskRunner runScoped(const TaskGroup& taskGroup, finish_callback_type finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)&&
+		{
+			return ScopedTaskRunner{ std::move(*this), taskGroup, std::move(finishCallback), std::move(cancelCallback) };
+		}
+
+		void runAddTo(MultiRunner& mr, finish_callback_type finishCallback = nullptr, std::function<void()> cancelCallback = nullptr)&&
+		{
+			// Note: MultiRunnerがTaskGroupに所属している場合は、最初のresumeから所属させる
+			if (mr.m_taskGroup)
+			{
+				mr.add(ScopedTaskRunner{ std::move(*this), *mr.m_taskGroup, std::move(finishCallback), std::move(cancelCallback) });
+			}
+			else
+			{
+				mr.add(ScopedTaskRunner{ std::move(*this), std::move(finishCallback), std::move(cancelCallback) });
+			}
+		}
+	};
+
+	namespace detail
+	{
+		// Backendに直接登録されたUpdater
+		// (完了・キャンセル時のコールバックを同じブロックに保持し、ブロックはコルーチンフレーム用アロケータから確保する)
+		template <typename F>
+		class RegisteredUpdater final : public Updater<F>
+		{
+		private:
+			using result_type = typename Updater<F>::result_type;
+
+			FinishCallbackType<result_type> m_finishCallback;
+
+			std::function<void()> m_cancelCallback;
+
+		public:
+			RegisteredUpdater(Updater<F>&& updater, FinishCallbackType<result_type>&& finishCallback, std::function<void()>&& cancelCallback)
+				: Updater<F>(std::move(updater))
+				, m_finishCallback(std::move(finishCallback))
+				, m_cancelCallback(std::move(cancelCallback))
+			{
+			}
+
+			[[nodiscard]]
+			static void* operator new(std::size_t size)
+			{
+				return FrameAllocator::Allocate(size, FrameAllocator::AllocationKind::Entry);
+			}
+
+			static void operator delete(void* p, std::size_t size) noexcept
+			{
+				FrameAllocator::Deallocate(p, size, FrameAllocator::AllocationKind::Entry);
+			}
+
+			// 完了済みの場合は結果を取り出して完了時のコールバックを、未完了の場合はキャンセル時のコールバックを呼ぶ
+			static void CallEndCallback(IAwaiter* pAwaiter)
+			{
+				// AwaiterEntryに登録される関数はawaiterの型に対応するため、static_castでキャストして問題ない
+				auto* pSelf = static_cast<RegisteredUpdater<F>*>(pAwaiter);
+				if (pSelf->done())
+				{
+					InvokeFinishCallback<result_type>(*pSelf, pSelf->m_finishCallback, pSelf->m_cancelCallback);
+				}
+				else if (pSelf->m_cancelCallback)
+				{
+					pSelf->m_cancelCallback();
+				}
+			}
+		};
+	}
+
+	template <typename TResult>
+	auto operator co_await(Task<TResult>&& rhs)
+	{
+		return detail::TaskAwaiter<TResult>{ std::move(rhs) };
+	}
+
+	template <typename TResult>
+	auto operator co_await(const Task<TResult>& rhs) = delete;
+
+	inline void Init()
+	{
+		detail::Backend::Init();
+	}
+
+	// コルーチンフレームの確保にサイズクラス別のフリーリストを使用するかどうかを設定(デフォルトは無効)
+	inline void SetFrameAllocatorEnabled(bool enabled) noexcept
+	{
+		detail::FrameAllocator::SetEnabled(enabled);
+	}
+
+	[[nodiscard]]
+	inline bool IsFrameAllocatorEnabled() noexcept
+	{
+		return detail::FrameAllocator::IsEnabled();
+	}
+
+	// 呼び出し元スレッドにおけるコルーチンフレーム確保の統計情報を取得
+	[[nodiscard]]
+	inline FrameAllocatorStats GetFrameAllocatorStats() noexcept
+	{
+		return detail::FrameAllocator::Stats();
+	}
+
+	inline void ResetFrameAllocatorStats() noexcept
+	{
+		detail::FrameAllocator::ResetStats();
+	}
+
+	// 呼び出し元スレッドのフリーリストに保持しているメモリをすべて解放
+	inline void ReleaseFrameAllocatorCache() noexcept
+	{
+		detail::FrameAllocator::ReleaseCache();
+	}
+
+	// COTASKLIB_ENABLE_PROFILERが定義されているかどうか
+	[[nodiscard]]
+	constexpr bool IsProfilerEnabled() noexcept
+	{
+#ifdef COTASKLIB_ENABLE_PROFILER
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// プロファイラの計測結果の出力先を設定する(nullptrで解除)
+	// (COTASKLIB_ENABLE_PROFILERを定義していない場合は何もしない。出力先は解除するまで生存している必要がある)
+	inline void SetProfilerSink(IProfilerSink* pProfilerSink)
+	{
+		detail::Backend::SetProfilerSink(pProfilerSink);
+	}
+
+	// 実行中のタスクごとの計測結果を取得する
+	// (COTASKLIB_ENABLE_PROFILERを定義していない場合は空の配列を返す)
+	[[nodiscard]]
+	inline Array<TaskProfile> GetTaskProfiles()
+	{
+		return detail::Backend::TaskProfiles();
+	}
+
+	// 直近の描画で指定レイヤーの描画に要した時間を取得する
+	// (COTASKLIB_ENABLE_PROFILERを定義していない場合は常に0を返す)
+	[[nodiscard]]
+	inline Duration GetLastLayerDrawTime(Layer layer)
+	{
+		return detail::Backend::LastLayerDrawTime(layer);
+	}
+
+	// Backgroundの優先度のタスクを実行する際のフレーム予算を設定する(0の場合は制限なし)
+	// update開始からの経過時間が予算に達した時点で、残りのBackgroundのタスクは次のフレームへ持ち越される
+	// (pSteadyClockを指定した場合は経過時間の計測にその時計を使用する)
+	inline void SetFrameBudget(Duration budget, ISteadyClock* pSteadyClock = nullptr)
+	{
+		detail::Backend::SetFrameBudget(budget, pSteadyClock);
+	}
+
+	// 持ち越しがこの回数続いたBackgroundのタスクは、フレーム予算を超えていても実行される(デフォルトは8)
+	inline void SetMaxDeferredUpdates(uint32 maxDeferredUpdates)
+	{
+		detail::Backend::SetMaxDeferredUpdates(maxDeferredUpdates);
+	}
+
+	[[nodiscard]]
+	inline TaskPriorityStats GetTaskPriorityStats(TaskPriority priority)
+	{
+		return detail::Backend::PriorityStats(priority);
+	}
+
+	inline void ResetTaskPriorityStats()
+	{
+		detail::Backend::ResetPriorityStats();
+	}
+
+	// 描画せずに、フレーム数と時刻を1フレームあたりdeltaTimeずつ進めながら、タスクの実行をframesフレーム分まとめて行う
+	// (System::Update()を待たないため、リプレイの検証やAI同士の対戦などを実時間より高速にシミュレーションできる)
+	// Note: タスクの実行中には呼び出せない
+	inline void FastForward(int32 frames, Duration deltaTime = Duration{ 1.0 / 60 })
+	{
+		detail::Backend::FastForward(frames, deltaTime);
+	}
+
+	// Backendのフレーム数を取得する(FastForwardで進めたフレーム数を含む)
+	[[nodiscard]]
+	inline int32 GetFrameCount()
+	{
+		return detail::Backend::FrameCount();
+	}
+
+	// Backendの時刻を取得する(FastForwardで進めた時間を含む)
+	// (Delay・Tweenerなどの時間経過はこの時刻を元に計算されるため、FastForwardを使用する場合はScene::Time()の代わりにこの関数を使用する)
+	[[nodiscard]]
+	inline double GetSceneTime()
+	{
+		return detail::Backend::SceneTime();
+	}
+
+	// 実行中のタスクとDrawerが保持しているメモリを集計する
+	[[nodiscard]]
+	inline MemoryCensus GetMemoryCensus()
 	{
-		return detail::TaskAwaiter<TResult>{ std::move(rhs) };
+		return detail::Backend::Census();
 	}
 
-	template <typename TResult>
-	auto operator co_await(const Task<TResult>& rhs) = delete;
+	// Backendから直接実行されているタスクの一覧を取得する
+	// (シーン遷移をまたいで残り続けているWaitForeverやforget済みのタスクを調べるために使用)
+	[[nodiscard]]
+	inline Array<LiveTaskInfo> GetLiveTasks()
+	{
+		return detail::Backend::LiveTasks();
+	}
 
-	inline void Init()
+	// Backendから直接実行されているタスクの一覧を1タスク1行の文字列として取得する
+	[[nodiscard]]
+	inline String DumpLiveTasks()
 	{
-		detail::Backend::Init();
+		String dump;
+		for (const LiveTaskInfo& info : GetLiveTasks())
+		{
+			dump.append(info.name.isEmpty() ? String{ U"(unnamed)" } : info.name);
+			if (!info.fileName.isEmpty())
+			{
+				dump.append(U" ({}:{})"_fmt(info.fileName, info.line));
+			}
+			dump.append(U" age={} frames={} bytes={}"_fmt(info.ageUpdateCount, info.frameCount, info.frameBytes));
+			if (info.isParked)
+			{
+				dump.append(U" parked");
+			}
+			dump.push_back(U'\n');
+		}
+		return dump;
 	}
 
 	[[nodiscard]]
@@ -1808,14 +6701,6 @@ namespace cotasklib::Co
 		co_return result;
 	}
 
-	[[nodiscard]]
-	inline Task<void> DelayFrame(int32 frames)
-	{
-		for (int32 i = 0; i < frames; ++i)
-		{
-			co_await NextFrame();
-		}
-	}
 
 	namespace detail
 	{
@@ -1832,10 +6717,10 @@ namespace cotasklib::Co
 		public:
 			using InnerDurationRep = typename TInnerDuration::rep;
 
-			DeltaAggregateTimerImpl(Duration duration, InnerDurationRep initialTime)
+			DeltaAggregateTimerImpl(Duration duration, InnerDurationRep initialTime, int32 frameCount)
 				: m_duration(DurationCast<TInnerDuration>(duration))
 				, m_prevTime(initialTime)
-				, m_prevFrameCount(Scene::FrameCount())
+				, m_prevFrameCount(frameCount)
 			{
 			}
 
@@ -1845,9 +6730,8 @@ namespace cotasklib::Co
 				return m_elapsed >= m_duration;
 			}
 
-			void update(InnerDurationRep timeRep)
+			void update(InnerDurationRep timeRep, int32 frameCount)
 			{
-				const int32 frameCount = Scene::FrameCount();
 				const TInnerDuration time = TInnerDuration{ timeRep };
 
 				// ポーズ中や同一フレーム内での多重更新は時間を進行させない
@@ -1861,6 +6745,23 @@ namespace cotasklib::Co
 				m_prevTime = time;
 			}
 
+			// 残り時間を経過し終える時刻
+			[[nodiscard]]
+			InnerDurationRep deadline() const
+			{
+				return (m_prevTime + (m_duration - m_elapsed)).count();
+			}
+
+			// 休止からの復帰時に、休止中のフレームも連続して更新されたものとして扱う
+			// (休止するのはBackendから毎フレームresumeされるタスクに限られ、ポーズにより時間が止まることはないため)
+			void onWake(int32 frameCount)
+			{
+				if (frameCount != m_prevFrameCount)
+				{
+					m_prevFrameCount = frameCount - 1;
+				}
+			}
+
 			[[nodiscard]]
 			double progress0_1() const
 			{
@@ -1875,63 +6776,220 @@ namespace cotasklib::Co
 		class DeltaAggregateTimer
 		{
 		private:
-			std::variant<DeltaAggregateTimerImpl<SecondsF>, DeltaAggregateTimerImpl<std::chrono::duration<uint64, std::micro>>> m_impl;
+			using SteadyClockTimerImpl = DeltaAggregateTimerImpl<std::chrono::duration<uint64, std::micro>>;
+
+			using SceneTimeTimerImpl = DeltaAggregateTimerImpl<SecondsF>;
+
+			// Note: m_implの初期化に使用するため、先に宣言する
 			ISteadyClock* m_pSteadyClock;
 
+			std::variant<SceneTimeTimerImpl, SteadyClockTimerImpl> m_impl;
+
+			// Note: 時計の種類はコンストラクタで決まるため、std::visitではなくm_pSteadyClockの有無で分岐する
+			[[nodiscard]]
+			SteadyClockTimerImpl& steadyClockImpl() noexcept
+			{
+				return *std::get_if<SteadyClockTimerImpl>(&m_impl);
+			}
+
+			[[nodiscard]]
+			const SteadyClockTimerImpl& steadyClockImpl() const noexcept
+			{
+				return *std::get_if<SteadyClockTimerImpl>(&m_impl);
+			}
+
+			[[nodiscard]]
+			SceneTimeTimerImpl& sceneTimeImpl() noexcept
+			{
+				return *std::get_if<SceneTimeTimerImpl>(&m_impl);
+			}
+
+			[[nodiscard]]
+			const SceneTimeTimerImpl& sceneTimeImpl() const noexcept
+			{
+				return *std::get_if<SceneTimeTimerImpl>(&m_impl);
+			}
+
 		public:
+			// Note: 時刻はBackendのスナップショットから取得するため、同じupdate内の全タイマーが同じ時刻を参照する
+			// (時計の指定がなく、TaskGroupに所属するタスク内で構築された場合は、TaskGroupの時計を使用する)
 			DeltaAggregateTimer(Duration duration, ISteadyClock* pSteadyClock)
-				: m_impl(pSteadyClock
-					? decltype(m_impl){ DeltaAggregateTimerImpl<std::chrono::duration<uint64, std::micro>>{ duration, pSteadyClock->getMicrosec() } }
-					: decltype(m_impl){ DeltaAggregateTimerImpl<SecondsF>{ duration, Scene::Time() } })
-				, m_pSteadyClock(pSteadyClock)
+				: m_pSteadyClock(pSteadyClock ? pSteadyClock : Backend::CurrentTaskGroupClock())
+				, m_impl(m_pSteadyClock
+					? decltype(m_impl){ SteadyClockTimerImpl{ duration, Backend::SteadyClockMicrosec(m_pSteadyClock), Backend::FrameCount() } }
+					: decltype(m_impl){ SceneTimeTimerImpl{ duration, Backend::SceneTime(), Backend::FrameCount() } })
 			{
 			}
 
 			[[nodiscard]]
 			bool reachedZero() const
 			{
-				return std::visit([](const auto& impl) { return impl.reachedZero(); }, m_impl);
+				return m_pSteadyClock ? steadyClockImpl().reachedZero() : sceneTimeImpl().reachedZero();
 			}
 
 			void update()
 			{
 				if (m_pSteadyClock)
 				{
-					std::get<DeltaAggregateTimerImpl<std::chrono::duration<uint64, std::micro>>>(m_impl).update(m_pSteadyClock->getMicrosec());
+					steadyClockImpl().update(Backend::SteadyClockMicrosec(m_pSteadyClock), Backend::FrameCount());
 				}
 				else
 				{
-					std::get<DeltaAggregateTimerImpl<SecondsF>>(m_impl).update(Scene::Time());
+					sceneTimeImpl().update(Backend::SceneTime(), Backend::FrameCount());
 				}
 			}
 
 			[[nodiscard]]
 			double progress0_1() const
 			{
-				return std::visit([](const auto& impl) { return impl.progress0_1(); }, m_impl);
+				return m_pSteadyClock ? steadyClockImpl().progress0_1() : sceneTimeImpl().progress0_1();
+			}
+
+			[[nodiscard]]
+			WakeCondition wakeCondition() const
+			{
+				if (m_pSteadyClock)
+				{
+					return WakeAtSteadyClockTime{ m_pSteadyClock, steadyClockImpl().deadline() };
+				}
+				else
+				{
+					return WakeAtSceneTime{ sceneTimeImpl().deadline() };
+				}
+			}
+
+			void onWake()
+			{
+				if (m_pSteadyClock)
+				{
+					steadyClockImpl().onWake(Backend::FrameCount());
+				}
+				else
+				{
+					sceneTimeImpl().onWake(Backend::FrameCount());
+				}
+			}
+		};
+
+		// Delay用の待機対象
+		class DelaySleeper : public ISleeper
+		{
+		private:
+			DeltaAggregateTimer m_timer;
+
+		public:
+			DelaySleeper(Duration duration, ISteadyClock* pSteadyClock)
+				: m_timer(duration, pSteadyClock)
+			{
+			}
+
+			[[nodiscard]]
+			bool reachedZero() const
+			{
+				return m_timer.reachedZero();
+			}
+
+			void update()
+			{
+				m_timer.update();
+			}
+
+			[[nodiscard]]
+			WakeCondition wakeCondition() const override
+			{
+				return m_timer.wakeCondition();
+			}
+
+			void onWake(uint64) override
+			{
+				m_timer.onWake();
+			}
+		};
+
+		// DelayFrame用の待機対象
+		// (DelayFrameはフレーム数ではなくresume回数を数えるため、休止中に省略したupdate回数をそのまま差し引く)
+		class FrameSleeper : public ISleeper
+		{
+		private:
+			int64 m_remainingCount;
+
+		public:
+			explicit FrameSleeper(int32 frames) noexcept
+				: m_remainingCount(frames)
+			{
+			}
+
+			[[nodiscard]]
+			bool reachedZero() const noexcept
+			{
+				return m_remainingCount <= 0;
+			}
+
+			void update() noexcept
+			{
+				--m_remainingCount;
+			}
+
+			[[nodiscard]]
+			WakeCondition wakeCondition() const override
+			{
+				return WakeAfterUpdateCount{ static_cast<uint64>(m_remainingCount) };
+			}
+
+			void onWake(uint64 skippedUpdateCount) override
+			{
+				m_remainingCount -= static_cast<int64>(skippedUpdateCount);
+			}
+		};
+
+		// WaitForever用の待機対象
+		class ForeverSleeper : public ISleeper
+		{
+		public:
+			[[nodiscard]]
+			WakeCondition wakeCondition() const override
+			{
+				return WakeNever{};
+			}
+
+			void onWake(uint64) override
+			{
 			}
 		};
 	}
 
+	// Note: 以下の待機はBackendから直接実行されている場合、起床条件を満たすまで毎フレームのresumeが省略される
+
+	[[nodiscard]]
+	inline Task<void> DelayFrame(int32 frames)
+	{
+		detail::FrameSleeper sleeper{ frames };
+		while (!sleeper.reachedZero())
+		{
+			co_await detail::SleepAwaiter{ &sleeper };
+			sleeper.update();
+		}
+	}
+
 	[[nodiscard]]
 	inline Task<void> Delay(const Duration duration)
 	{
-		detail::DeltaAggregateTimerImpl<SecondsF> timer{ duration, Scene::Time() };
-		while (!timer.reachedZero())
+		detail::DelaySleeper sleeper{ duration, nullptr };
+		while (!sleeper.reachedZero())
 		{
-			co_await NextFrame();
-			timer.update(Scene::Time());
+			co_await detail::SleepAwaiter{ &sleeper };
+			sleeper.update();
 		}
 	}
 
 	[[nodiscard]]
 	inline Task<void> Delay(const Duration duration, ISteadyClock* pSteadyClock)
 	{
-		detail::DeltaAggregateTimer timer{ duration, pSteadyClock };
-		while (!timer.reachedZero())
+		detail::DelaySleeper sleeper{ duration, pSteadyClock };
+		while (!sleeper.reachedZero())
 		{
-			co_await NextFrame();
-			timer.update();
+			co_await detail::SleepAwaiter{ &sleeper };
+			sleeper.update();
 		}
 	}
 
@@ -1960,9 +7018,10 @@ namespace cotasklib::Co
 	[[nodiscard]]
 	inline Task<void> WaitForever()
 	{
+		detail::ForeverSleeper sleeper;
 		while (true)
 		{
-			co_await NextFrame();
+			co_await detail::SleepAwaiter{ &sleeper };
 		}
 	}
 
@@ -2074,39 +7133,76 @@ namespace cotasklib::Co
 		}
 	}
 
-	template <class TArea>
-	[[nodiscard]]
-	Task<void> WaitUntilLeftClicked(const TArea area)
+	namespace detail
 	{
-		while (!area.leftClicked())
+		template <class TArea>
+		[[nodiscard]]
+		bool IsAreaInputTriggered(const TArea& area, InputWaitKind kind)
 		{
-			co_await NextFrame();
+			switch (kind)
+			{
+			case InputWaitKind::LeftClicked:
+				return area.leftClicked();
+			case InputWaitKind::LeftReleased:
+				return area.leftReleased();
+			case InputWaitKind::RightClicked:
+				return area.rightClicked();
+			case InputWaitKind::RightReleased:
+				return area.rightReleased();
+			default:
+				return area.mouseOver();
+			}
+		}
+
+		// 領域へのマウス入力を待つ
+		// (Backendから直接実行されている場合、InputRouterによりカーソルが当たるまで毎フレームのresumeが省略される)
+		template <class TArea>
+		[[nodiscard]]
+		Task<void> WaitUntilAreaInput(const TArea area, Layer layer, InputWaitKind kind)
+		{
+			if (IsAreaInputTriggered(area, kind) && !Backend::IsInputBlocked(layer))
+			{
+				co_return;
+			}
+
+			SignalSleeper sleeper;
+			InputWaiterNode node{ &area, layer, kind, &sleeper };
+			Backend::AddInputWaiter(node);
+			do
+			{
+				co_await SleepAwaiter{ &sleeper };
+			} while (!IsAreaInputTriggered(area, kind) || Backend::IsInputBlocked(layer));
 		}
 	}
 
+	// Note: 以下の領域へのマウス入力の待機は、指定したレイヤーより上のレイヤーのScopedInputBlockerがカーソル位置を覆っている間は完了しない
+
+	template <class TArea>
+	[[nodiscard]]
+	Task<void> WaitUntilLeftClicked(const TArea area, Layer layer = Layer::Default)
+	{
+		return detail::WaitUntilAreaInput(area, layer, detail::InputWaitKind::LeftClicked);
+	}
+
 	template <class TArea>
 	[[nodiscard]]
-	Task<void> WaitUntilLeftReleased(const TArea area)
+	Task<void> WaitUntilLeftReleased(const TArea area, Layer layer = Layer::Default)
 	{
-		while (!area.leftReleased())
-		{
-			co_await NextFrame();
-		}
+		return detail::WaitUntilAreaInput(area, layer, detail::InputWaitKind::LeftReleased);
 	}
 
 	template <class TArea>
 	[[nodiscard]]
-	Task<void> WaitUntilLeftClickedThenReleased(const TArea area)
+	Task<void> WaitUntilLeftClickedThenReleased(const TArea area, Layer layer = Layer::Default)
 	{
 		while (true)
 		{
-			if (area.leftClicked())
+			co_await WaitUntilLeftClicked(area, layer);
+
+			const auto [releasedInArea, _] = co_await Any(WaitUntilLeftReleased(area, layer), WaitUntilUp(MouseL));
+			if (releasedInArea.has_value())
 			{
-				const auto [releasedInArea, _] = co_await Any(WaitUntilLeftReleased(area), WaitUntilUp(MouseL));
-				if (releasedInArea.has_value())
-				{
-					break;
-				}
+				break;
 			}
 			co_await NextFrame();
 		}
@@ -2114,37 +7210,30 @@ namespace cotasklib::Co
 
 	template <class TArea>
 	[[nodiscard]]
-	Task<void> WaitUntilRightClicked(const TArea area)
+	Task<void> WaitUntilRightClicked(const TArea area, Layer layer = Layer::Default)
 	{
-		while (!area.rightClicked())
-		{
-			co_await NextFrame();
-		}
+		return detail::WaitUntilAreaInput(area, layer, detail::InputWaitKind::RightClicked);
 	}
 
 	template <class TArea>
 	[[nodiscard]]
-	Task<void> WaitUntilRightReleased(const TArea area)
+	Task<void> WaitUntilRightReleased(const TArea area, Layer layer = Layer::Default)
 	{
-		while (!area.rightReleased())
-		{
-			co_await NextFrame();
-		}
+		return detail::WaitUntilAreaInput(area, layer, detail::InputWaitKind::RightReleased);
 	}
 
 	template <class TArea>
 	[[nodiscard]]
-	Task<void> WaitUntilRightClickedThenReleased(const TArea area)
+	Task<void> WaitUntilRightClickedThenReleased(const TArea area, Layer layer = Layer::Default)
 	{
 		while (true)
 		{
-			if (area.rightClicked())
+			co_await WaitUntilRightClicked(area, layer);
+
+			const auto [releasedInArea, _] = co_await Any(WaitUntilRightReleased(area, layer), WaitUntilUp(MouseR));
+			if (releasedInArea.has_value())
 			{
-				const auto [releasedInArea, _] = co_await Any(WaitUntilRightReleased(area), WaitUntilUp(MouseR));
-				if (releasedInArea.has_value())
-				{
-					break;
-				}
+				break;
 			}
 			co_await NextFrame();
 		}
@@ -2152,12 +7241,9 @@ namespace cotasklib::Co
 
 	template <class TArea>
 	[[nodiscard]]
-	Task<void> WaitUntilMouseOver(const TArea area)
+	Task<void> WaitUntilMouseOver(const TArea area, Layer layer = Layer::Default)
 	{
-		while (!area.mouseOver())
-		{
-			co_await NextFrame();
-		}
+		return detail::WaitUntilAreaInput(area, layer, detail::InputWaitKind::MouseOver);
 	}
 
 	// voidの参照やvoidを含むタプルは使用できないため、voidの代わりに戻り値として返すための空の構造体を用意
@@ -2170,49 +7256,57 @@ namespace cotasklib::Co
 		template <typename TResult>
 		using VoidResultTypeReplace = std::conditional_t<std::is_void_v<TResult>, VoidResult, TResult>;
 
-		template <typename TResult>
+		template <typename TTask>
 		[[nodiscard]]
-		auto ConvertVoidResult(const Task<TResult>& task) -> VoidResultTypeReplace<TResult>
+		auto ConvertVoidResult(TTask& task) -> VoidResultTypeReplace<typename TTask::result_type>
 		{
-			if constexpr (std::is_void_v<TResult>)
+			if constexpr (std::is_void_v<typename TTask::result_type>)
 			{
 				task.value(); // 例外伝搬のためにvoidでも呼び出す
 				return VoidResult{};
 			}
 			else
 			{
-				return task.value();
+				// 結果は取り出すため右辺値として取得する
+				return std::move(task).value();
 			}
 		}
 
-		template <typename TResult>
+		template <typename TTask>
 		[[nodiscard]]
-		auto ConvertOptionalVoidResult(const Task<TResult>& task) -> Optional<VoidResultTypeReplace<TResult>>
+		auto ConvertOptionalVoidResult(TTask& task) -> Optional<VoidResultTypeReplace<typename TTask::result_type>>
 		{
 			if (!task.done())
 			{
 				return none;
 			}
 
-			if constexpr (std::is_void_v<TResult>)
+			if constexpr (std::is_void_v<typename TTask::result_type>)
 			{
 				task.value(); // 例外伝搬のためにvoidでも呼び出す
 				return MakeOptional(VoidResult{});
 			}
 			else
 			{
-				return MakeOptional(task.value());
+				return MakeOptional(std::move(task).value());
 			}
 		}
 
 		template <typename TTask>
 		concept TaskConcept = std::is_same_v<TTask, Task<typename TTask::result_type>>;
 
+		template <typename TUpdater>
+		concept UpdaterConcept = std::is_same_v<TUpdater, Updater<typename TUpdater::function_type>>;
+
+		// Co::All・Co::Anyに渡せる型
+		template <typename TTask>
+		concept TaskOrUpdaterConcept = TaskConcept<TTask> || UpdaterConcept<TTask>;
+
 		template <typename TScene>
 		concept SceneConcept = std::derived_from<TScene, SceneBase>;
 	}
 
-	template <detail::TaskConcept... TTasks>
+	template <detail::TaskOrUpdaterConcept... TTasks>
 	auto All(TTasks... args) -> Task<std::tuple<detail::VoidResultTypeReplace<typename TTasks::result_type>...>>
 	{
 		if ((args.done() && ...))
@@ -2231,7 +7325,7 @@ namespace cotasklib::Co
 		}
 	}
 
-	template <detail::TaskConcept... TTasks>
+	template <detail::TaskOrUpdaterConcept... TTasks>
 	auto Any(TTasks... args) -> Task<std::tuple<Optional<detail::VoidResultTypeReplace<typename TTasks::result_type>>...>>
 	{
 		static_assert(
@@ -2253,6 +7347,107 @@ namespace cotasklib::Co
 			co_await NextFrame();
 		}
 	}
+
+	template <typename TResult>
+	using AllOfResultType = std::conditional_t<std::is_void_v<TResult>, void, Array<TResult>>;
+
+	template <typename TResult>
+	using AnyOfResultType = std::conditional_t<std::is_void_v<TResult>, std::size_t, std::pair<std::size_t, TResult>>;
+
+	// 個数が実行時に決まるタスクを全て完了するまで実行する
+	// (完了したタスクは次フレーム以降のresume対象から外し、結果はコピーせずムーブで取り出す)
+	template <typename TResult>
+	auto AllOf(Array<Task<TResult>> tasks) -> Task<AllOfResultType<TResult>>
+	{
+		Array<std::size_t> runningIndices;
+		runningIndices.reserve(tasks.size());
+		for (std::size_t i = 0; i < tasks.size(); ++i)
+		{
+			if (!tasks[i].done())
+			{
+				runningIndices.push_back(i);
+			}
+		}
+
+		while (!runningIndices.empty())
+		{
+			for (const std::size_t index : runningIndices)
+			{
+				tasks[index].resume();
+			}
+			runningIndices.remove_if([&tasks](std::size_t index) { return tasks[index].done(); });
+			if (runningIndices.empty())
+			{
+				break;
+			}
+			co_await NextFrame();
+		}
+
+		if constexpr (std::is_void_v<TResult>)
+		{
+			for (const auto& task : tasks)
+			{
+				task.value(); // 例外伝搬のためにvoidでも呼び出す
+			}
+		}
+		else
+		{
+			Array<TResult> results;
+			results.reserve(tasks.size());
+			for (const auto& task : tasks)
+			{
+				results.push_back(task.value());
+			}
+			co_return std::move(results);
+		}
+	}
+
+	// 個数が実行時に決まるタスクのいずれかが完了するまで実行し、完了したタスクのインデックスと結果を返す
+	// (同じフレームで複数のタスクが完了した場合はインデックスが最も小さいものを返す。結果はコピーせずムーブで取り出す)
+	template <typename TResult>
+	auto AnyOf(Array<Task<TResult>> tasks) -> Task<AnyOfResultType<TResult>>
+	{
+		if (tasks.empty())
+		{
+			throw Error{ U"Co::AnyOf: tasks must not be empty" };
+		}
+
+		const auto fnResult = [&tasks](std::size_t index) -> AnyOfResultType<TResult>
+			{
+				if constexpr (std::is_void_v<TResult>)
+				{
+					tasks[index].value(); // 例外伝搬のためにvoidでも呼び出す
+					return index;
+				}
+				else
+				{
+					return { index, tasks[index].value() };
+				}
+			};
+
+		while (true)
+		{
+			for (std::size_t i = 0; i < tasks.size(); ++i)
+			{
+				if (tasks[i].done())
+				{
+					co_return fnResult(i);
+				}
+			}
+			for (auto& task : tasks)
+			{
+				task.resume();
+			}
+			for (std::size_t i = 0; i < tasks.size(); ++i)
+			{
+				if (tasks[i].done())
+				{
+					co_return fnResult(i);
+				}
+			}
+			co_await NextFrame();
+		}
+	}
 }
 
 #ifndef NO_COTASKLIB_USING
@@ -60,14 +60,24 @@ namespace cotasklib::Co
 			return a.lerp(b, t);
 		}
 
+		// EaseTaskBuilder::play()の実体
+		// (イージング関数の型をテンプレート引数で受け取ることで、コンパイル時に指定された場合は毎フレームの処理がインライン化される)
+		template <typename T, typename TEase>
 		[[nodiscard]]
-		inline Task<void> EaseTask(std::function<void(double)> callback, const Duration duration, double easeFunc(double), ISteadyClock* pSteadyClock)
+		Task<void> EaseTask(T* pTarget, std::function<void(T)> callback, T from, T to, const Duration duration, TEase ease, ISteadyClock* pSteadyClock)
 		{
 			detail::DeltaAggregateTimer timer{ duration, pSteadyClock };
 			while (true)
 			{
 				const double progress = timer.progress0_1();
-				callback(easeFunc(progress));
+				if (pTarget)
+				{
+					*pTarget = GenericLerp(from, to, ease(progress));
+				}
+				else if (callback)
+				{
+					callback(GenericLerp(from, to, ease(progress)));
+				}
 				if (progress >= 1.0)
 				{
 					co_return;
@@ -77,6 +87,34 @@ namespace cotasklib::Co
 			}
 		}
 
+		using EaseFuncPtr = double(*)(double);
+
+		// コンパイル時に指定されたイージング関数を呼び出す関数オブジェクト
+		template <EaseFuncPtr EaseFunc>
+		struct StaticEase
+		{
+			[[nodiscard]]
+			double operator()(double t) const
+			{
+				return EaseFunc(t);
+			}
+		};
+
+		template <EaseFuncPtr EaseFunc, std::size_t N>
+		[[nodiscard]]
+		std::array<double, N + 1> MakeEaseLUT()
+		{
+			std::array<double, N + 1> table;
+			for (std::size_t i = 0; i <= N; ++i)
+			{
+				table[i] = EaseFunc(static_cast<double>(i) / static_cast<double>(N));
+			}
+			return table;
+		}
+
+		template <EaseFuncPtr EaseFunc, std::size_t N>
+		inline const std::array<double, N + 1> EaseLUT = MakeEaseLUT<EaseFunc, N>();
+
 		template<typename T>
 		struct IsVector2D : std::false_type {};
 
@@ -98,25 +136,61 @@ namespace cotasklib::Co
 		template <typename T, typename U>
 		concept VectorConvertibleFrom = (detail::IsVector2D<T>::value || detail::IsVector3D<T>::value) && std::is_convertible_v<U, typename T::value_type>;
 	}
-		
-	template <typename T>
+
+	// イージング関数を事前にN区間でサンプリングし、線形補間で近似するイージング関数
+	// (EaseOutElastic・EaseInOutBounceなど計算負荷の高いイージング関数を多数の値に適用する場合用。関数ポインタとして通常のイージング関数と同様に指定できる)
+	template <double(*EaseFunc)(double), std::size_t N = 256>
+	[[nodiscard]]
+	double LUTEase(double t)
+	{
+		static_assert(N > 0, "N must be greater than 0");
+
+		const auto& table = detail::EaseLUT<EaseFunc, N>;
+		if (t <= 0.0)
+		{
+			return table.front();
+		}
+		if (t >= 1.0)
+		{
+			return table.back();
+		}
+		const double x = t * static_cast<double>(N);
+		const std::size_t index = Min(static_cast<std::size_t>(x), N - 1);
+		const double frac = x - static_cast<double>(index);
+		return table[index] + (table[index + 1] - table[index]) * frac;
+	}
+
+	// TEaseにdouble(*)(double)以外を指定した場合、イージング関数はコンパイル時に決定される(Co::Ease<EaseFunc>()で生成)
+	template <typename T, typename TEase = detail::EaseFuncPtr>
 	class [[nodiscard]] EaseTaskBuilder
 	{
 	private:
+		T* m_pTarget = nullptr;
 		std::function<void(T)> m_callback;
 		Duration m_duration;
 		T m_from;
 		T m_to;
-		double(*m_easeFunc)(double);
+		TEase m_ease;
 		ISteadyClock* m_pSteadyClock;
 
 	public:
-		explicit EaseTaskBuilder(std::function<void(T)> callback, Duration duration, T from, T to, double(*easeFunc)(double), ISteadyClock* pSteadyClock)
+		explicit EaseTaskBuilder(std::function<void(T)> callback, Duration duration, T from, T to, TEase ease, ISteadyClock* pSteadyClock)
 			: m_callback(std::move(callback))
 			, m_duration(duration)
 			, m_from(std::move(from))
 			, m_to(std::move(to))
-			, m_easeFunc(easeFunc)
+			, m_ease(ease)
+			, m_pSteadyClock(pSteadyClock)
+		{
+		}
+
+		// 変数へ直接代入する場合(コールバック関数の呼び出しを経由しない)
+		explicit EaseTaskBuilder(T* pTarget, Duration duration, T from, T to, TEase ease, ISteadyClock* pSteadyClock)
+			: m_pTarget(pTarget)
+			, m_duration(duration)
+			, m_from(std::move(from))
+			, m_to(std::move(to))
+			, m_ease(ease)
 			, m_pSteadyClock(pSteadyClock)
 		{
 		}
@@ -193,9 +267,9 @@ namespace cotasklib::Co
 			return *this;
 		}
 
-		EaseTaskBuilder& setEase(double(*easeFunc)(double))
+		EaseTaskBuilder& setEase(double(*easeFunc)(double)) requires std::is_same_v<TEase, detail::EaseFuncPtr>
 		{
-			m_easeFunc = easeFunc;
+			m_ease = easeFunc;
 			return *this;
 		}
 
@@ -207,11 +281,7 @@ namespace cotasklib::Co
 
 		Task<void> play()
 		{
-			auto lerpedCallback = [from = m_from, to = m_to, callback = m_callback](double t)
-				{
-					callback(detail::GenericLerp(from, to, t));
-				};
-			return detail::EaseTask(std::move(lerpedCallback), m_duration, m_easeFunc, m_pSteadyClock);
+			return detail::EaseTask<T, TEase>(m_pTarget, m_callback, m_from, m_to, m_duration, m_ease, m_pSteadyClock);
 		}
 
 		ScopedTaskRunner playScoped()
@@ -229,7 +299,15 @@ namespace cotasklib::Co
 	[[nodiscard]]
 	EaseTaskBuilder<T> Ease(T* pValue, Duration duration = 0s, double easeFunc(double) = EaseOutQuad, ISteadyClock* pSteadyClock = nullptr)
 	{
-		return EaseTaskBuilder<T>([pValue](T value) { *pValue = value; }, duration, *pValue, *pValue, easeFunc, pSteadyClock);
+		return EaseTaskBuilder<T>(pValue, duration, *pValue, *pValue, easeFunc, pSteadyClock);
+	}
+
+	// イージング関数をテンプレート引数で指定する場合(例: Co::Ease<EaseOutQuad>(&value, 1s))
+	template <double(*EaseFunc)(double), detail::Lerpable T>
+	[[nodiscard]]
+	EaseTaskBuilder<T, detail::StaticEase<EaseFunc>> Ease(T* pValue, Duration duration = 0s, ISteadyClock* pSteadyClock = nullptr)
+	{
+		return EaseTaskBuilder<T, detail::StaticEase<EaseFunc>>(pValue, duration, *pValue, *pValue, detail::StaticEase<EaseFunc>{}, pSteadyClock);
 	}
 
 	template <detail::Lerpable T>
@@ -243,7 +321,7 @@ namespace cotasklib::Co
 	[[nodiscard]]
 	EaseTaskBuilder<T> LinearEase(T* pValue, Duration duration = 0s, ISteadyClock* pSteadyClock = nullptr)
 	{
-		return EaseTaskBuilder<T>([pValue](T value) { *pValue = value; }, duration, *pValue, *pValue, Easing::Linear, pSteadyClock);
+		return EaseTaskBuilder<T>(pValue, duration, *pValue, *pValue, Easing::Linear, pSteadyClock);
 	}
 
 	template <detail::Lerpable T>
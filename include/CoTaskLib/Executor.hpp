@@ -0,0 +1,625 @@
+﻿//----------------------------------------------------------------------------------------
+//
+//  CoTaskLib
+//
+//  Copyright (c) 2024 masaka
+//
+//  Licensed under the MIT License.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//----------------------------------------------------------------------------------------
+
+#pragma once
+#include "Core.hpp"
+#include "Worker.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cotasklib::Co
+{
+	namespace detail
+	{
+		// Executorで実行するタスクのジョブ
+		// (投入側・Executor側・完了キューの三者から参照カウントで保持され、最後に手放した側が破棄する)
+		class ExecutorJobBase : public ICompletionNode
+		{
+		private:
+			std::atomic<uint32> m_refCount = 1;
+
+			// 投入側のBackendの完了キュー
+			std::shared_ptr<CompletionQueue> m_pCompletionQueue;
+
+			// 待機側のタスクが破棄された場合に立てる
+			std::atomic<bool> m_isAborted = false;
+
+			// 以下はExecutorのスレッドからのみ参照する
+			Optional<ScopedTaskRunner> m_runner;
+
+			bool m_isPushed = false;
+
+			// 以下は投入側のスレッドからのみ参照する
+			SignalSleeper* m_pSleeper = nullptr;
+
+			bool m_isCompleted = false;
+
+			// 完了キューへ積み、投入側のBackendのupdate開始時に完了を通知させる
+			void pushCompletion()
+			{
+				if (m_isPushed)
+				{
+					return;
+				}
+				m_isPushed = true;
+
+				// キューがジョブを、ジョブがキューを保持し続けないよう、積む前にキューへの参照を手放す
+				const std::shared_ptr<CompletionQueue> pCompletionQueue = std::move(m_pCompletionQueue);
+				addRef();
+				pCompletionQueue->push(this);
+			}
+
+		protected:
+			// Executorのスレッドで書き込み、完了の通知後に投入側のスレッドで読み出す
+			std::exception_ptr m_exception;
+
+			// Executorのスレッドで実行するタスク(結果はメンバ変数へ書き込む)
+			[[nodiscard]]
+			virtual Task<void> runTask() = 0;
+
+			void rethrowIfFailed()
+			{
+				if (m_exception)
+				{
+					std::rethrow_exception(m_exception);
+				}
+			}
+
+		public:
+			explicit ExecutorJobBase(std::shared_ptr<CompletionQueue> pCompletionQueue)
+				: m_pCompletionQueue(std::move(pCompletionQueue))
+			{
+			}
+
+			ExecutorJobBase(const ExecutorJobBase&) = delete;
+
+			ExecutorJobBase& operator=(const ExecutorJobBase&) = delete;
+
+			void addRef() noexcept
+			{
+				m_refCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			void release() noexcept override
+			{
+				if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					delete this;
+				}
+			}
+
+			// 以下はExecutorのスレッドで、Executorのバックエンドへ切り替えた状態で呼び出す
+
+			void start()
+			{
+				if (m_isAborted.load(std::memory_order_acquire))
+				{
+					pushCompletion();
+					return;
+				}
+
+				m_runner.emplace(runTask().runScoped(
+					[this] { pushCompletion(); },
+					[this] { cancel(); }));
+			}
+
+			// 開始前・実行中のタスクを取りやめ、完了を通知する
+			void cancel()
+			{
+				if (m_isPushed)
+				{
+					return;
+				}
+				m_exception = std::make_exception_ptr(Error{ U"RunOnExecutor: The task was canceled because the executor was destroyed" });
+				pushCompletion();
+			}
+
+			// Executorが保持し続ける必要がなくなったかどうか
+			[[nodiscard]]
+			bool isFinished() const noexcept
+			{
+				return m_isPushed || m_isAborted.load(std::memory_order_acquire);
+			}
+
+			void resetRunner()
+			{
+				m_runner.reset();
+			}
+
+			void onCompleted() override
+			{
+				m_isCompleted = true;
+				if (m_pSleeper)
+				{
+					m_pSleeper->notify();
+				}
+			}
+
+			// 以下は投入側のスレッドからのみ呼び出す
+
+			void setSleeper(SignalSleeper* pSleeper) noexcept
+			{
+				m_pSleeper = pSleeper;
+			}
+
+			[[nodiscard]]
+			bool isCompleted() const noexcept
+			{
+				return m_isCompleted;
+			}
+
+			void abort() noexcept
+			{
+				m_pSleeper = nullptr;
+				m_isAborted.store(true, std::memory_order_release);
+			}
+		};
+
+		template <typename TResult>
+		class ExecutorTaskJob : public ExecutorJobBase
+		{
+		private:
+			Optional<Task<TResult>> m_task;
+
+			Optional<std::conditional_t<std::is_void_v<TResult>, std::monostate, TResult>> m_result;
+
+		protected:
+			Task<void> runTask() override
+			{
+				Task<TResult> task = std::move(*m_task);
+				m_task.reset();
+				try
+				{
+					if constexpr (std::is_void_v<TResult>)
+					{
+						co_await std::move(task);
+						m_result.emplace();
+					}
+					else
+					{
+						m_result.emplace(co_await std::move(task));
+					}
+				}
+				catch (...)
+				{
+					m_exception = std::current_exception();
+				}
+			}
+
+		public:
+			ExecutorTaskJob(Task<TResult>&& task, std::shared_ptr<CompletionQueue> pCompletionQueue)
+				: ExecutorJobBase(std::move(pCompletionQueue))
+				, m_task(std::move(task))
+			{
+			}
+
+			[[nodiscard]]
+			TResult takeResult()
+			{
+				rethrowIfFailed();
+				if constexpr (!std::is_void_v<TResult>)
+				{
+					return std::move(*m_result);
+				}
+			}
+		};
+
+		// Executorへ投入したジョブの完了を待つ
+		template <typename TExecutor, typename TResult>
+		auto AwaitExecutorJob(TExecutor& executor, WorkerJobRef<ExecutorTaskJob<TResult>> job) -> Task<TResult>
+		{
+			SignalSleeper sleeper;
+			job->setSleeper(&sleeper);
+			executor.post(job.get());
+
+			// Note: Backendから直接実行されている場合、完了が通知されるまで毎フレームのresumeが省略される
+			while (!job->isCompleted())
+			{
+				co_await SleepAwaiter{ &sleeper };
+			}
+			job->setSleeper(nullptr);
+			co_return job->takeResult();
+		}
+	}
+
+	class Executor;
+
+	// 呼び出し元スレッドでのタスクの実行先を、スコープを抜けるまでExecutorへ切り替える
+	class ScopedExecutorBinding
+	{
+	private:
+		detail::Backend* m_pPrevBackend;
+
+	public:
+		explicit ScopedExecutorBinding(Executor& executor);
+
+		ScopedExecutorBinding(const ScopedExecutorBinding&) = delete;
+
+		ScopedExecutorBinding& operator=(const ScopedExecutorBinding&) = delete;
+
+		~ScopedExecutorBinding()
+		{
+			detail::Backend::BindCurrent(m_pPrevBackend);
+		}
+	};
+
+	// メインのBackendとは別にタスクを実行する実行器
+	// (任意のスレッドで生成・updateでき、そのスレッドで開始したタスクはこのExecutorに所属して実行される)
+	// Note: Siv3Dの描画・入力・時計は使用しないため、Siv3Dの機能を使用するタスクやシーケンス・シーンは実行できない
+	class Executor
+	{
+	private:
+		friend class ScopedExecutorBinding;
+
+		// Note: ScopedTaskRunnerが所有者として弱参照を持つため、shared_ptrで持つ
+		std::shared_ptr<detail::Backend> m_pBackend;
+
+		std::mutex m_inboxMutex;
+
+		// 他のスレッドから投入され、まだ開始していないジョブ
+		std::deque<detail::ExecutorJobBase*> m_inbox;
+
+		// 開始済みのジョブ(Executorのスレッドからのみ参照する)
+		Array<detail::ExecutorJobBase*> m_runningJobs;
+
+		void startInboxJobs()
+		{
+			std::deque<detail::ExecutorJobBase*> jobs;
+			{
+				const std::lock_guard lock{ m_inboxMutex };
+				jobs.swap(m_inbox);
+			}
+			for (detail::ExecutorJobBase* const pJob : jobs)
+			{
+				m_runningJobs.push_back(pJob);
+				pJob->start();
+			}
+		}
+
+		void releaseFinishedJobs()
+		{
+			m_runningJobs.remove_if([](detail::ExecutorJobBase* pJob)
+				{
+					if (!pJob->isFinished())
+					{
+						return false;
+					}
+					pJob->resetRunner();
+					pJob->release();
+					return true;
+				});
+		}
+
+	public:
+		Executor()
+			: m_pBackend(std::make_shared<detail::Backend>(false))
+		{
+		}
+
+		Executor(const Executor&) = delete;
+
+		Executor& operator=(const Executor&) = delete;
+
+		~Executor()
+		{
+			{
+				const ScopedExecutorBinding binding{ *this };
+
+				// 実行中のジョブはキャンセルし、投入側へ完了を通知する
+				for (detail::ExecutorJobBase* const pJob : m_runningJobs)
+				{
+					pJob->resetRunner();
+					pJob->cancel();
+					pJob->release();
+				}
+				m_runningJobs.clear();
+
+				// 未着手のジョブは開始せずに完了を通知する
+				for (detail::ExecutorJobBase* const pJob : m_inbox)
+				{
+					pJob->cancel();
+					pJob->release();
+				}
+				m_inbox.clear();
+			}
+
+			// Note: メインのBackendの破棄時と同様、破棄中のBackendへタスクの削除が行われないよう、実行先を外した状態で破棄する
+			detail::Backend* const pPrevBackend = detail::Backend::BindCurrent(nullptr);
+			m_pBackend.reset();
+			detail::Backend::BindCurrent(pPrevBackend);
+		}
+
+		// 呼び出し元スレッドでのタスクの実行先を、戻り値のスコープを抜けるまでこのExecutorへ切り替える
+		// (切り替え中にrunScoped等で開始したタスクはこのExecutorに所属する。ScopedTaskRunnerは切り替えの外で破棄・参照してもこのExecutorに対して操作する)
+		[[nodiscard]]
+		ScopedExecutorBinding bind()
+		{
+			return ScopedExecutorBinding{ *this };
+		}
+
+		// 投入されたタスクを開始してから、フレーム数と時刻を1フレーム分進めて所属するタスクを実行する
+		// (DelayやTweenerはdeltaTimeを1フレームの経過時間として進行する)
+		void update(Duration deltaTime = Duration{ 1.0 / 60 })
+		{
+			if (m_pBackend->isUpdating())
+			{
+				throw Error{ U"Executor::update must not be called during its own update" };
+			}
+			if (deltaTime < Duration::zero())
+			{
+				throw Error{ U"Executor::update: deltaTime must not be negative" };
+			}
+
+			const ScopedExecutorBinding binding{ *this };
+			startInboxJobs();
+			m_pBackend->advanceFrame(deltaTime.count());
+			releaseFinishedJobs();
+		}
+
+		// 所属するタスク(休止中を含む)があるかどうか
+		// Note: Executorのスレッドからのみ呼び出せる
+		[[nodiscard]]
+		bool hasTasks() const noexcept
+		{
+			return m_pBackend->hasAwaiters() || !m_runningJobs.empty();
+		}
+
+		// 投入されたまま開始されていないタスクがあるかどうか(任意のスレッドから呼び出せる)
+		[[nodiscard]]
+		bool hasPendingTasks()
+		{
+			const std::lock_guard lock{ m_inboxMutex };
+			return !m_inbox.empty();
+		}
+
+		// 次回のupdateで開始するジョブを投入する(任意のスレッドから呼び出せる)
+		// Note: ライブラリ内部用。タスクの投入にはCo::RunOnExecutorを使用する
+		void post(detail::ExecutorJobBase* pJob)
+		{
+			pJob->addRef();
+			const std::lock_guard lock{ m_inboxMutex };
+			m_inbox.push_back(pJob);
+		}
+	};
+
+	inline ScopedExecutorBinding::ScopedExecutorBinding(Executor& executor)
+		: m_pPrevBackend(detail::Backend::BindCurrent(executor.m_pBackend.get()))
+	{
+	}
+
+	// 複数のスレッドでExecutorを1つずつ駆動し、投入されたタスクを分散して実行する
+	// (スレッドごとにキューを持ち、実行中のタスクがなくなったスレッドは他のスレッドのキューから未着手のタスクを奪って実行する)
+	// Note: 開始済みのタスクは、開始したスレッドのExecutorで完了まで実行される
+	class ExecutorGroup
+	{
+	private:
+		struct JobQueue
+		{
+			std::mutex mutex;
+			std::deque<detail::ExecutorJobBase*> jobs;
+		};
+
+		Duration m_deltaTime;
+
+		Array<std::unique_ptr<JobQueue>> m_queues;
+
+		Array<std::thread> m_threads;
+
+		std::atomic<std::size_t> m_pendingCount = 0;
+
+		std::atomic<std::size_t> m_nextQueueIndex = 0;
+
+		std::mutex m_sleepMutex;
+
+		std::condition_variable m_sleepCondition;
+
+		bool m_isStopping = false;
+
+		// 自身のキューのジョブを全て取り出す
+		[[nodiscard]]
+		std::deque<detail::ExecutorJobBase*> takeOwnJobs(std::size_t threadIndex)
+		{
+			std::deque<detail::ExecutorJobBase*> jobs;
+			JobQueue& queue = *m_queues[threadIndex];
+			const std::lock_guard lock{ queue.mutex };
+			jobs.swap(queue.jobs);
+			return jobs;
+		}
+
+		// 他のスレッドのキューの先頭から1つ奪う
+		[[nodiscard]]
+		detail::ExecutorJobBase* trySteal(std::size_t threadIndex)
+		{
+			for (std::size_t i = 1; i < m_queues.size(); ++i)
+			{
+				JobQueue& queue = *m_queues[(threadIndex + i) % m_queues.size()];
+				const std::lock_guard lock{ queue.mutex };
+				if (!queue.jobs.empty())
+				{
+					detail::ExecutorJobBase* const pJob = queue.jobs.front();
+					queue.jobs.pop_front();
+					return pJob;
+				}
+			}
+			return nullptr;
+		}
+
+		void threadMain(std::size_t threadIndex)
+		{
+			Executor executor;
+			const auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_deltaTime);
+			auto nextTick = std::chrono::steady_clock::now();
+
+			while (true)
+			{
+				std::deque<detail::ExecutorJobBase*> jobs = takeOwnJobs(threadIndex);
+				if (jobs.empty() && !executor.hasTasks())
+				{
+					if (detail::ExecutorJobBase* const pJob = trySteal(threadIndex))
+					{
+						jobs.push_back(pJob);
+					}
+				}
+				m_pendingCount.fetch_sub(jobs.size(), std::memory_order_relaxed);
+				for (detail::ExecutorJobBase* const pJob : jobs)
+				{
+					executor.post(pJob);
+					pJob->release();
+				}
+
+				if (!executor.hasTasks() && !executor.hasPendingTasks())
+				{
+					// 実行するタスクがない間は、投入されるまで待機する
+					std::unique_lock lock{ m_sleepMutex };
+					m_sleepCondition.wait(lock, [this] { return m_isStopping || m_pendingCount.load(std::memory_order_relaxed) > 0; });
+					if (m_isStopping)
+					{
+						return;
+					}
+					nextTick = std::chrono::steady_clock::now();
+					continue;
+				}
+
+				executor.update(m_deltaTime);
+
+				// 1フレームの経過時間ごとに実行する(処理が遅れている場合は待たずに次のフレームを実行する)
+				nextTick = Max(nextTick + tickDuration, std::chrono::steady_clock::now() - tickDuration);
+				std::unique_lock lock{ m_sleepMutex };
+				if (m_sleepCondition.wait_until(lock, nextTick, [this] { return m_isStopping; }))
+				{
+					return;
+				}
+			}
+		}
+
+	public:
+		// deltaTimeは各スレッドのExecutorの1フレームの経過時間
+		explicit ExecutorGroup(std::size_t threadCount, Duration deltaTime = Duration{ 1.0 / 60 })
+			: m_deltaTime(deltaTime)
+		{
+			if (deltaTime <= Duration::zero())
+			{
+				throw Error{ U"ExecutorGroup: deltaTime must be greater than 0" };
+			}
+
+			threadCount = Max<std::size_t>(threadCount, 1);
+			m_queues.reserve(threadCount);
+			for (std::size_t i = 0; i < threadCount; ++i)
+			{
+				m_queues.push_back(std::make_unique<JobQueue>());
+			}
+			m_threads.reserve(threadCount);
+			for (std::size_t i = 0; i < threadCount; ++i)
+			{
+				m_threads.emplace_back([this, i] { threadMain(i); });
+			}
+		}
+
+		ExecutorGroup(const ExecutorGroup&) = delete;
+
+		ExecutorGroup& operator=(const ExecutorGroup&) = delete;
+
+		// 実行中のタスクはキャンセルされ、待機側には例外が送出される
+		~ExecutorGroup()
+		{
+			{
+				const std::lock_guard lock{ m_sleepMutex };
+				m_isStopping = true;
+			}
+			m_sleepCondition.notify_all();
+			for (std::thread& thread : m_threads)
+			{
+				thread.join();
+			}
+
+			// 未着手のジョブは開始せずに完了を通知する
+			for (const auto& pQueue : m_queues)
+			{
+				for (detail::ExecutorJobBase* const pJob : pQueue->jobs)
+				{
+					pJob->cancel();
+					pJob->release();
+				}
+			}
+		}
+
+		[[nodiscard]]
+		std::size_t threadCount() const noexcept
+		{
+			return m_threads.size();
+		}
+
+		// 次に空いたスレッドで開始するジョブを投入する(任意のスレッドから呼び出せる)
+		// Note: ライブラリ内部用。タスクの投入にはCo::RunOnExecutorを使用する
+		void post(detail::ExecutorJobBase* pJob)
+		{
+			pJob->addRef();
+
+			// Note: キューへ積んだ直後にスレッドが取り出して減算しうるため、積む前に加算する
+			//       (後から加算すると一時的に0を下回り、size_tの値が巨大になって待機中のスレッドが空回りする)
+			{
+				const std::lock_guard lock{ m_sleepMutex };
+				m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			{
+				JobQueue& queue = *m_queues[m_nextQueueIndex.fetch_add(1, std::memory_order_relaxed) % m_queues.size()];
+				const std::lock_guard lock{ queue.mutex };
+				queue.jobs.push_back(pJob);
+			}
+			m_sleepCondition.notify_all();
+		}
+	};
+
+	// タスクを指定したExecutorで実行し、結果を待つ
+	// (完了の通知は呼び出し元のBackendの完了キューへ積まれ、呼び出し元のupdate開始時に待機側のタスクが再開される)
+	// (待機側のタスクが破棄された場合、Executor側のタスクは次回のupdateで破棄される)
+	template <typename TResult>
+	[[nodiscard]]
+	Task<TResult> RunOnExecutor(Executor& executor, Task<TResult> task)
+	{
+		using Job = detail::ExecutorTaskJob<TResult>;
+		return detail::AwaitExecutorJob(executor, detail::WorkerJobRef<Job>{ new Job{ std::move(task), detail::Backend::WorkerCompletionQueue() } });
+	}
+
+	// タスクをExecutorGroupのいずれかのスレッドで実行し、結果を待つ
+	template <typename TResult>
+	[[nodiscard]]
+	Task<TResult> RunOnExecutor(ExecutorGroup& executorGroup, Task<TResult> task)
+	{
+		using Job = detail::ExecutorTaskJob<TResult>;
+		return detail::AwaitExecutorJob(executorGroup, detail::WorkerJobRef<Job>{ new Job{ std::move(task), detail::Backend::WorkerCompletionQueue() } });
+	}
+}
+
+#ifndef NO_COTASKLIB_USING
+using namespace cotasklib;
+#endif
@@ -0,0 +1,203 @@
+﻿//----------------------------------------------------------------------------------------
+//
+//  CoTaskLib
+//
+//  Copyright (c) 2024 masaka
+//
+//  Licensed under the MIT License.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//----------------------------------------------------------------------------------------
+
+#pragma once
+#include "Core.hpp"
+#if defined(TRACY_ENABLE) && __has_include(<tracy/TracyC.h>)
+#include <cstring>
+#include <tracy/TracyC.h>
+#endif
+
+namespace cotasklib::Co
+{
+	// 計測区間をChrome Trace Event形式(chrome://tracingやPerfettoで表示可能なJSON)で記録する出力先
+	class ChromeTraceProfilerSink : public IProfilerSink
+	{
+	private:
+		struct Event
+		{
+			ProfileZoneKind kind;
+			String name;
+			uint64 beginNanosec;
+			uint64 durationNanosec = 0;
+		};
+
+		// 終了済みの計測区間
+		Array<Event> m_events;
+
+		// 開始済みで未終了の計測区間
+		Array<Event> m_openEvents;
+
+		[[nodiscard]]
+		static StringView CategoryName(ProfileZoneKind kind) noexcept
+		{
+			switch (kind)
+			{
+			case ProfileZoneKind::Task:
+				return U"task";
+
+			case ProfileZoneKind::Layer:
+				return U"layer";
+
+			case ProfileZoneKind::Drawer:
+				return U"drawer";
+
+			default:
+				return U"unknown";
+			}
+		}
+
+		static void AppendEscaped(String& out, StringView str)
+		{
+			constexpr StringView HexDigits = U"0123456789abcdef";
+			for (const char32 ch : str)
+			{
+				if (ch == U'"' || ch == U'\\')
+				{
+					out.push_back(U'\\');
+					out.push_back(ch);
+				}
+				else if (ch < 0x20)
+				{
+					out.append(U"\\u00");
+					out.push_back(HexDigits[ch >> 4]);
+					out.push_back(HexDigits[ch & 0xF]);
+				}
+				else
+				{
+					out.push_back(ch);
+				}
+			}
+		}
+
+		// ナノ秒をマイクロ秒単位の小数として追加する
+		static void AppendMicrosec(String& out, uint64 nanosec)
+		{
+			out.append(U"{}"_fmt(nanosec / 1000));
+			const uint64 fraction = nanosec % 1000;
+			out.push_back(U'.');
+			out.push_back(static_cast<char32>(U'0' + fraction / 100));
+			out.push_back(static_cast<char32>(U'0' + fraction / 10 % 10));
+			out.push_back(static_cast<char32>(U'0' + fraction % 10));
+		}
+
+	public:
+		ChromeTraceProfilerSink() = default;
+
+		void beginZone(const ProfileZone& zone, uint64 timestampNanosec) override
+		{
+			m_openEvents.push_back(Event{ .kind = zone.kind, .name = String{ zone.name }, .beginNanosec = timestampNanosec });
+		}
+
+		void endZone(uint64 timestampNanosec) override
+		{
+			if (m_openEvents.empty())
+			{
+				return;
+			}
+			Event event = std::move(m_openEvents.back());
+			m_openEvents.pop_back();
+			event.durationNanosec = timestampNanosec - event.beginNanosec;
+			m_events.push_back(std::move(event));
+		}
+
+		// 記録済みの計測区間の数
+		[[nodiscard]]
+		std::size_t size() const noexcept
+		{
+			return m_events.size();
+		}
+
+		void clear()
+		{
+			m_events.clear();
+			m_openEvents.clear();
+		}
+
+		// 記録済みの計測区間をJSON文字列として取得する
+		// (ファイルへ保存する場合はTextWriterなどで書き出す)
+		[[nodiscard]]
+		String toJSON() const
+		{
+			String json = U"{\"traceEvents\":[";
+			for (std::size_t i = 0; i < m_events.size(); ++i)
+			{
+				const Event& event = m_events[i];
+				if (i != 0)
+				{
+					json.push_back(U',');
+				}
+				json.append(U"{\"name\":\"");
+				AppendEscaped(json, event.name);
+				json.append(U"\",\"cat\":\"");
+				json.append(CategoryName(event.kind));
+				json.append(U"\",\"ph\":\"X\",\"ts\":");
+				AppendMicrosec(json, event.beginNanosec);
+				json.append(U",\"dur\":");
+				AppendMicrosec(json, event.durationNanosec);
+				json.append(U",\"pid\":1,\"tid\":1}");
+			}
+			json.append(U"]}");
+			return json;
+		}
+	};
+
+#if defined(TRACY_ENABLE) && __has_include(<tracy/TracyC.h>)
+	// 計測区間をTracyのゾーンとして送信する出力先
+	class TracyProfilerSink : public IProfilerSink
+	{
+	private:
+		Array<TracyCZoneCtx> m_zoneContexts;
+
+	public:
+		TracyProfilerSink() = default;
+
+		void beginZone(const ProfileZone& zone, [[maybe_unused]] uint64 timestampNanosec) override
+		{
+			const std::string name = Unicode::ToUTF8(zone.name);
+			const char* const fileName = zone.fileName ? zone.fileName : "";
+			const uint64_t sourceLocation = ___tracy_alloc_srcloc_name(zone.line, fileName, std::strlen(fileName), "", 0, name.data(), name.size(), 0);
+			m_zoneContexts.push_back(___tracy_emit_zone_begin_alloc(sourceLocation, 1));
+		}
+
+		void endZone([[maybe_unused]] uint64 timestampNanosec) override
+		{
+			if (m_zoneContexts.empty())
+			{
+				return;
+			}
+			___tracy_emit_zone_end(m_zoneContexts.back());
+			m_zoneContexts.pop_back();
+		}
+	};
+#endif
+}
+
+#ifndef NO_COTASKLIB_USING
+using namespace cotasklib;
+#endif
@@ -156,6 +156,229 @@ namespace cotasklib::Co
 				return m_asyncHTTPTask.getResponse();
 			}
 		};
+
+		template <typename TAsyncTask>
+		struct S3dAsyncTaskTraits;
+
+		template <typename TResult>
+		struct S3dAsyncTaskTraits<AsyncTask<TResult>>
+		{
+			using result_type = TResult;
+
+			static TResult Get(AsyncTask<TResult>& asyncTask)
+			{
+				return asyncTask.get();
+			}
+
+			static void Cancel(AsyncTask<TResult>&)
+			{
+				// AsyncTaskは外部から中断できないため、CancellationTokenでのみ通知する
+			}
+		};
+
+		template <>
+		struct S3dAsyncTaskTraits<AsyncHTTPTask>
+		{
+			using result_type = HTTPResponse;
+
+			static HTTPResponse Get(AsyncHTTPTask& asyncHTTPTask)
+			{
+				return asyncHTTPTask.getResponse();
+			}
+
+			static void Cancel(AsyncHTTPTask& asyncHTTPTask)
+			{
+				asyncHTTPTask.cancel();
+			}
+		};
+
+		// 複数の非同期タスクを1つのAwaiterでまとめて待機する
+		// (完了したものは次フレーム以降の確認対象から外す。破棄時やAnyOfの完了時に未完了のものが残っていればキャンセルを要求する)
+		template <typename TAsyncTask, bool IsAny>
+		class S3dAsyncTaskArrayAwaiter : public IAwaiter
+		{
+		private:
+			using Traits = S3dAsyncTaskTraits<TAsyncTask>;
+
+			using ElementResult = typename Traits::result_type;
+
+			Array<TAsyncTask> m_asyncTasks;
+
+			// 未完了のもののインデックス(昇順)
+			Array<std::size_t> m_pendingIndices;
+
+			Optional<CancellationToken> m_cancellationToken;
+
+			Optional<std::size_t> m_firstReadyIndex;
+
+			bool m_isDone = false;
+
+			void cancelPending()
+			{
+				if (m_pendingIndices.empty())
+				{
+					return;
+				}
+				if (m_cancellationToken)
+				{
+					m_cancellationToken->requestCancel();
+				}
+				for (const std::size_t index : m_pendingIndices)
+				{
+					Traits::Cancel(m_asyncTasks[index]);
+				}
+				m_pendingIndices.clear();
+			}
+
+		public:
+			S3dAsyncTaskArrayAwaiter(Array<TAsyncTask>&& asyncTasks, Optional<CancellationToken>&& cancellationToken)
+				: m_asyncTasks(std::move(asyncTasks))
+				, m_cancellationToken(std::move(cancellationToken))
+			{
+				m_pendingIndices.reserve(m_asyncTasks.size());
+				for (std::size_t i = 0; i < m_asyncTasks.size(); ++i)
+				{
+					m_pendingIndices.push_back(i);
+				}
+			}
+
+			S3dAsyncTaskArrayAwaiter(const S3dAsyncTaskArrayAwaiter&) = delete;
+
+			S3dAsyncTaskArrayAwaiter& operator=(const S3dAsyncTaskArrayAwaiter&) = delete;
+
+			S3dAsyncTaskArrayAwaiter(S3dAsyncTaskArrayAwaiter&&) = delete;
+
+			S3dAsyncTaskArrayAwaiter& operator=(S3dAsyncTaskArrayAwaiter&&) = delete;
+
+			~S3dAsyncTaskArrayAwaiter()
+			{
+				cancelPending();
+			}
+
+			void resume() override
+			{
+				if (m_isDone)
+				{
+					return;
+				}
+
+				m_pendingIndices.remove_if([this](std::size_t index)
+					{
+						if (!m_asyncTasks[index].isReady())
+						{
+							return false;
+						}
+						if (!m_firstReadyIndex)
+						{
+							m_firstReadyIndex = index;
+						}
+						return true;
+					});
+
+				if constexpr (IsAny)
+				{
+					m_isDone = m_firstReadyIndex.has_value();
+					if (m_isDone)
+					{
+						// 残りの結果は不要なため中断させる
+						cancelPending();
+					}
+				}
+				else
+				{
+					m_isDone = m_pendingIndices.empty();
+				}
+			}
+
+			bool done() const override
+			{
+				return m_isDone;
+			}
+
+			bool await_ready()
+			{
+				resume();
+				return m_isDone;
+			}
+
+			template <typename TResultOther>
+			void await_suspend(std::coroutine_handle<detail::Promise<TResultOther>> handle)
+			{
+				handle.promise().setSubAwaiter(this);
+			}
+
+			auto await_resume() -> std::conditional_t<IsAny, AnyOfResultType<ElementResult>, AllOfResultType<ElementResult>>
+			{
+				if constexpr (IsAny)
+				{
+					const std::size_t index = *m_firstReadyIndex;
+					if constexpr (std::is_void_v<ElementResult>)
+					{
+						Traits::Get(m_asyncTasks[index]); // 例外伝搬のためにvoidでも呼び出す
+						return index;
+					}
+					else
+					{
+						return std::pair<std::size_t, ElementResult>{ index, Traits::Get(m_asyncTasks[index]) };
+					}
+				}
+				else if constexpr (std::is_void_v<ElementResult>)
+				{
+					for (TAsyncTask& asyncTask : m_asyncTasks)
+					{
+						Traits::Get(asyncTask);
+					}
+				}
+				else
+				{
+					Array<ElementResult> results;
+					results.reserve(m_asyncTasks.size());
+					for (TAsyncTask& asyncTask : m_asyncTasks)
+					{
+						results.push_back(Traits::Get(asyncTask));
+					}
+					return results;
+				}
+			}
+		};
+	}
+
+	// 複数のAsyncTaskを全て完了するまで待機し、結果を順に並べた配列を返す
+	// (CancellationTokenを指定した場合、完了前にタスクが破棄されるとキャンセルが要求される)
+	template <typename TResult>
+	auto AllOf(Array<AsyncTask<TResult>> asyncTasks, Optional<CancellationToken> cancellationToken = none) -> Task<AllOfResultType<TResult>>
+	{
+		co_return co_await detail::S3dAsyncTaskArrayAwaiter<AsyncTask<TResult>, false>{ std::move(asyncTasks), std::move(cancellationToken) };
+	}
+
+	// 複数のAsyncTaskのいずれかが完了するまで待機し、最初に完了したもののインデックスと結果を返す
+	// (CancellationTokenを指定した場合、完了時または完了前にタスクが破棄された際にキャンセルが要求される)
+	template <typename TResult>
+	auto AnyOf(Array<AsyncTask<TResult>> asyncTasks, Optional<CancellationToken> cancellationToken = none) -> Task<AnyOfResultType<TResult>>
+	{
+		if (asyncTasks.empty())
+		{
+			throw Error{ U"Co::AnyOf: asyncTasks must not be empty" };
+		}
+		co_return co_await detail::S3dAsyncTaskArrayAwaiter<AsyncTask<TResult>, true>{ std::move(asyncTasks), std::move(cancellationToken) };
+	}
+
+	// 複数のAsyncHTTPTaskを全て完了するまで待機し、レスポンスを順に並べた配列を返す
+	// (完了前にタスクが破棄された場合、未完了の通信はキャンセルされる)
+	inline Task<Array<HTTPResponse>> AllOf(Array<AsyncHTTPTask> asyncHTTPTasks)
+	{
+		co_return co_await detail::S3dAsyncTaskArrayAwaiter<AsyncHTTPTask, false>{ std::move(asyncHTTPTasks), none };
+	}
+
+	// 複数のAsyncHTTPTaskのいずれかが完了するまで待機し、最初に完了したもののインデックスとレスポンスを返す
+	// (完了時または完了前にタスクが破棄された際、未完了の通信はキャンセルされる)
+	inline Task<std::pair<std::size_t, HTTPResponse>> AnyOf(Array<AsyncHTTPTask> asyncHTTPTasks)
+	{
+		if (asyncHTTPTasks.empty())
+		{
+			throw Error{ U"Co::AnyOf: asyncHTTPTasks must not be empty" };
+		}
+		co_return co_await detail::S3dAsyncTaskArrayAwaiter<AsyncHTTPTask, true>{ std::move(asyncHTTPTasks), none };
 	}
 }
 
@@ -64,12 +64,25 @@ namespace cotasklib::Co
 		return [=] { return std::make_unique<TScene>(args...); };
 	}
 
+	// 次のシーンを生成し、preloadを実行するタイミング
+	enum class ScenePreloadMode : uint8
+	{
+		// 現在のシーンを破棄してから次のシーンを生成し、preloadを実行する
+		// (2つのシーンが同時に存在しないため、メモリ使用量のピークを抑えられる)
+		Sequential,
+
+		// 現在のシーンのfadeOut開始時に次のシーンを生成し、現在のシーンのfadeOut・postFadeOutと並行してpreloadを実行する
+		// (シーンの切り替え時は生成済みのシーンへの差し替えのみとなる)
+		Overlapped,
+	};
+
 	class [[nodiscard]] SceneBase : public detail::IDrawerInternal
 	{
 	private:
 		Layer m_layer;
 		int32 m_drawIndex;
 		detail::ScopedDrawerInternal* m_pCurrentScopedDrawer = nullptr;
+		bool m_isVisible = true;
 		bool m_isPreStart = true;
 		bool m_isFadingIn = false;
 		bool m_isFadingOut = false;
@@ -77,10 +90,48 @@ namespace cotasklib::Co
 
 		TaskFinishSource<SceneFactory> m_taskFinishSource;
 
+		ScenePreloadMode m_nextScenePreloadMode = ScenePreloadMode::Sequential;
+
+		// ScenePreloadMode::Overlappedで指定された次のシーンのファクトリ
+		SceneFactory m_overlappedSceneFactory;
+
+		bool m_isPreloaded = false;
+
+		// fadeOutと並行して次のシーンを生成したかどうか(ファクトリがnullptrを返した場合も含む)
+		bool m_isNextSceneCreated = false;
+
+		// fadeOutと並行して生成・preload中の次のシーン
+		// (Note: preloadの実行が先に破棄されるよう、シーンより後に宣言する)
+		std::unique_ptr<SceneBase> m_pPreloadedNextScene;
+		Optional<ScopedTaskRunner> m_preloadRunner;
+
+		[[nodiscard]]
+		Task<void> preloadInternal()
+		{
+			co_await preload();
+			m_isPreloaded = true;
+		}
+
+		// 次のシーンの生成とpreloadを開始する(ScenePreloadMode::Overlappedが指定されている場合のみ)
+		void beginOverlappedPreload()
+		{
+			if (m_nextScenePreloadMode != ScenePreloadMode::Overlapped || !m_overlappedSceneFactory || !detail::Backend::IsOverlappedScenePreloadAllowed())
+			{
+				return;
+			}
+			m_pPreloadedNextScene = m_overlappedSceneFactory();
+			m_isNextSceneCreated = true;
+			if (m_pPreloadedNextScene)
+			{
+				m_preloadRunner.emplace(m_pPreloadedNextScene->preloadInternal().runScoped());
+			}
+		}
+
 		[[nodiscard]]
 		Task<void> startAndFadeOut()
 		{
 			co_await start();
+			beginOverlappedPreload();
 			m_isFadingOut = true;
 			co_await fadeOut();
 			m_isFadingOut = false;
@@ -111,6 +162,14 @@ namespace cotasklib::Co
 		}
 
 	protected:
+		// シーンの描画開始前に、重いリソースの読み込みなどを行う
+		// (ScenePreloadMode::Overlappedで遷移した場合は前のシーンのfadeOut・postFadeOutと並行して実行されるため、前のシーンが破棄済みであることを前提としないこと)
+		[[nodiscard]]
+		virtual Task<void> preload()
+		{
+			return EmptyTask();
+		}
+
 		[[nodiscard]]
 		virtual Task<void> preStart()
 		{
@@ -180,6 +239,27 @@ namespace cotasklib::Co
 			return m_taskFinishSource.requestFinish(std::move(sceneFactory));
 		}
 
+		bool requestNextScene(SceneFactory sceneFactory, ScenePreloadMode preloadMode)
+		{
+			if (!m_taskFinishSource.requestFinish(sceneFactory))
+			{
+				return false;
+			}
+			m_nextScenePreloadMode = preloadMode;
+			if (preloadMode == ScenePreloadMode::Overlapped)
+			{
+				m_overlappedSceneFactory = std::move(sceneFactory);
+			}
+			return true;
+		}
+
+		// 現在のシーンのfadeOut開始時に次のシーンを生成し、fadeOut・postFadeOutと並行してpreloadを実行する
+		template <class TScene, typename... Args>
+		bool requestNextScenePreloaded(Args&&... args)
+		{
+			return requestNextScene(MakeSceneFactory<TScene>(std::forward<Args>(args)...), ScenePreloadMode::Overlapped);
+		}
+
 		bool requestSceneFinish()
 		{
 			return m_taskFinishSource.requestFinish(nullptr);
@@ -209,6 +289,16 @@ namespace cotasklib::Co
 			}
 		}
 
+		// falseを指定すると、実行中のまま描画を省略する
+		void setVisible(bool isVisible)
+		{
+			m_isVisible = isVisible;
+			if (m_pCurrentScopedDrawer)
+			{
+				m_pCurrentScopedDrawer->setVisible(isVisible);
+			}
+		}
+
 	public:
 		explicit SceneBase(Layer layer = Layer::Default, int32 drawIndex = DrawIndex::Default)
 			: m_layer(layer)
@@ -242,14 +332,28 @@ namespace cotasklib::Co
 			return m_isFadingOut;
 		}
 
+		[[nodiscard]]
+		bool isVisible() const
+		{
+			return m_isVisible;
+		}
+
 		// ライブラリ内部で使用するためのタスク実行関数
 		[[nodiscard]]
 		Task<SceneFactory> playInternal()&
 		{
 			detail::ScopedDrawerInternal drawer{ this, m_layer, m_drawIndex, &m_pCurrentScopedDrawer };
+			if (!m_isVisible)
+			{
+				drawer.setVisible(false);
+			}
 
 			{
 				m_isPreStart = true;
+				if (!m_isPreloaded)
+				{
+					co_await preloadInternal();
+				}
 				co_await preStart();
 				m_isPreStart = false;
 			}
@@ -262,6 +366,12 @@ namespace cotasklib::Co
 				m_isPostFadeOut = false;
 			}
 
+			// 並行して実行中の次のシーンのpreloadを待つ
+			if (m_preloadRunner)
+			{
+				co_await m_preloadRunner->waitUntilDone();
+			}
+
 			if (m_taskFinishSource.hasResult())
 			{
 				co_return m_taskFinishSource.result();
@@ -274,6 +384,22 @@ namespace cotasklib::Co
 
 		// 右辺値参照の場合はタスク実行中にthisがダングリングポインタになるため、使用しようとした場合はコンパイルエラーとする
 		Task<SceneFactory> playInternal() && = delete;
+
+		// ライブラリ内部で使用するための関数(fadeOutと並行して次のシーンを生成済みかどうか)
+		[[nodiscard]]
+		bool hasPreloadedNextScene() const
+		{
+			return m_isNextSceneCreated;
+		}
+
+		// ライブラリ内部で使用するための関数(fadeOutと並行して生成した次のシーンを取り出す)
+		[[nodiscard]]
+		std::unique_ptr<SceneBase> takePreloadedNextScene()
+		{
+			m_preloadRunner.reset();
+			m_isNextSceneCreated = false;
+			return std::move(m_pPreloadedNextScene);
+		}
 	};
 
 	// 毎フレーム呼ばれるupdate関数を記述するタイプのシーン基底クラス
@@ -335,9 +461,17 @@ namespace cotasklib::Co
 					break;
 				}
 
-				// 次シーンを生成
-				currentScene.reset(); // 前シーンのデストラクタを次シーンのコンストラクタより先に呼ぶため、先にresetが必要
-				currentScene = nextSceneFactory();
+				if (currentScene->hasPreloadedNextScene())
+				{
+					// fadeOutと並行して生成済みの次シーンへ差し替える(前シーンのデストラクタは差し替え時に呼ばれる)
+					currentScene = currentScene->takePreloadedNextScene();
+				}
+				else
+				{
+					// 次シーンを生成
+					currentScene.reset(); // 前シーンのデストラクタを次シーンのコンストラクタより先に呼ぶため、先にresetが必要
+					currentScene = nextSceneFactory();
+				}
 				if (!currentScene)
 				{
 					break;
@@ -359,6 +493,13 @@ namespace cotasklib::Co
 		return detail::ScenePtrToTask(std::move(scenePtr));
 	}
 
+	// ScenePreloadMode::Overlappedを許可するかどうかを設定する(デフォルトはtrue)
+	// (falseの場合はScenePreloadMode::Overlappedの指定はScenePreloadMode::Sequentialとして扱われ、2つのシーンが同時に存在しなくなるため、メモリの少ない環境でピークを抑えられる)
+	inline void SetOverlappedScenePreloadAllowed(bool isAllowed)
+	{
+		detail::Backend::SetOverlappedScenePreloadAllowed(isAllowed);
+	}
+
 #ifdef __cpp_deleted_function_with_reason
 	template <detail::SceneConcept TScene>
 	auto operator co_await(TScene&& scene) = delete("To co_await a Scene, use Co::PlaySceneFrom<TScene>() instead.");
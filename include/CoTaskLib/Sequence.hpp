@@ -47,6 +47,7 @@ namespace cotasklib::Co
 		Layer m_layer;
 		int32 m_drawIndex;
 		detail::ScopedDrawerInternal* m_pCurrentScopedDrawer = nullptr;
+		bool m_isVisible = true;
 		bool m_onceRun = false;
 		bool m_isPreStart = true;
 		bool m_isFadingIn = false;
@@ -177,6 +178,16 @@ namespace cotasklib::Co
 			}
 		}
 
+		// falseを指定すると、実行中のまま描画を省略する
+		void setVisible(bool isVisible)
+		{
+			m_isVisible = isVisible;
+			if (m_pCurrentScopedDrawer)
+			{
+				m_pCurrentScopedDrawer->setVisible(isVisible);
+			}
+		}
+
 	public:
 		explicit SequenceBase(Layer layer = Layer::Default, int32 drawIndex = DrawIndex::Default)
 			: m_layer(layer)
@@ -228,6 +239,12 @@ namespace cotasklib::Co
 			return m_drawIndex;
 		}
 
+		[[nodiscard]]
+		bool isVisible() const
+		{
+			return m_isVisible;
+		}
+
 		[[nodiscard]]
 		Task<TResult> play()&
 		{
@@ -239,6 +256,10 @@ namespace cotasklib::Co
 			m_onceRun = true;
 
 			detail::ScopedDrawerInternal drawer{ this, m_layer, m_drawIndex, &m_pCurrentScopedDrawer };
+			if (!m_isVisible)
+			{
+				drawer.setVisible(false);
+			}
 
 			{
 				m_isPreStart = true;
@@ -311,7 +332,12 @@ namespace cotasklib::Co
 	Task<typename TSequence::result_type> Play(Args&&... args)
 	{
 		std::unique_ptr<SequenceBase<typename TSequence::result_type>> sequence = std::make_unique<TSequence>(std::forward<Args>(args)...);
+#ifdef COTASKLIB_ENABLE_PROFILER
+		// プロファイラにはシーケンスの型名を表示する(記述位置はこの関数内になるため記録しない)
+		return detail::SequencePtrToTask(std::move(sequence)).named(detail::ProfileTypeName(typeid(TSequence)), std::source_location{});
+#else
 		return detail::SequencePtrToTask(std::move(sequence));
+#endif
 	}
 
 	// 毎フレーム呼ばれるupdate関数を記述するタイプのシーケンス基底クラス
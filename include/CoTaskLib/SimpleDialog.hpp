@@ -55,10 +55,58 @@ namespace cotasklib::Co
 		constexpr ColorF TextColor = Palette::Black;
 		constexpr Duration FadeDuration = 0.25s;
 
+		// SimpleDialogのフォントでプリロード済みの文字
+		// (全てのダイアログで共有し、プリロード済みの文字は再度プリロードしない。フォントが変わった場合は空に戻す)
+		[[nodiscard]]
+		inline HashSet<char32>& PreloadedDialogGlyphs()
+		{
+			static Optional<Font::IDType> fontID;
+			static HashSet<char32> glyphs;
+			const Font::IDType currentFontID = SimpleGUI::GetFont().id();
+			if (fontID != currentFontID)
+			{
+				fontID = currentFontID;
+				glyphs.clear();
+			}
+			return glyphs;
+		}
+
+		// プリロードしていない文字を重複なしで返す
+		[[nodiscard]]
+		inline String UnloadedDialogGlyphs(StringView text)
+		{
+			const HashSet<char32>& preloadedGlyphs = PreloadedDialogGlyphs();
+			HashSet<char32> unloadedGlyphSet;
+			String unloadedGlyphs;
+			for (const char32 ch : text)
+			{
+				if (!preloadedGlyphs.contains(ch) && unloadedGlyphSet.insert(ch).second)
+				{
+					unloadedGlyphs.push_back(ch);
+				}
+			}
+			return unloadedGlyphs;
+		}
+
+		inline void PreloadDialogGlyphs(StringView glyphs)
+		{
+			if (glyphs.isEmpty())
+			{
+				return;
+			}
+			SimpleGUI::GetFont().preload(glyphs);
+			HashSet<char32>& preloadedGlyphs = PreloadedDialogGlyphs();
+			for (const char32 ch : glyphs)
+			{
+				preloadedGlyphs.insert(ch);
+			}
+		}
+
 		struct SimpleButton
 		{
 		private:
 			String m_text;
+			DrawableText m_drawableText;
 			RectF m_rect;
 			s3d::RoundRect m_roundRect;
 			bool m_interactable;
@@ -68,6 +116,7 @@ namespace cotasklib::Co
 		public:
 			SimpleButton(StringView text, RectF rect, bool interactable = true)
 				: m_text(text)
+				, m_drawableText(SimpleGUI::GetFont()(m_text))
 				, m_rect(rect)
 				, m_roundRect(rect.rounded(ButtonRoundSize))
 				, m_interactable(interactable)
@@ -138,8 +187,7 @@ namespace cotasklib::Co
 					.draw(color)
 					.drawFrame(m_isPressed ? ButtonFrameThicknessPressed : ButtonFrameThickness, 0, FrameColor);
 
-				const auto& font = SimpleGUI::GetFont();
-				font(m_text).drawAt(m_rect.center(), ButtonTextColor);
+				m_drawableText.drawAt(m_rect.center(), ButtonTextColor);
 			}
 
 			[[nodiscard]]
@@ -171,8 +219,17 @@ namespace cotasklib::Co
 		private:
 			String m_text;
 			Array<SimpleButton> m_buttons;
+
+			// 毎フレームの描画でレイアウトを計算し直さないよう、構築時に計算しておく
+			DrawableText m_drawableText;
+			s3d::RoundRect m_boxBodyRect;
+			s3d::RoundRect m_boxFooterRect;
+			Vec2 m_textCenter;
 			Tweener m_tweener;
 
+			// 表示中は下のレイヤーへのマウス入力の待機を遮断する
+			ScopedInputBlocker m_inputBlocker;
+
 			void update() override
 			{
 				for (auto& button : m_buttons)
@@ -198,13 +255,11 @@ namespace cotasklib::Co
 
 				// メッセージボックス本体を上下に分けて描画
 				const auto scopedTween = m_tweener.applyScoped();
-				const auto boxPos = BoxPos();
-				RectF{ boxPos, { SimpleDialogSize.x, SimpleDialogSize.y - FooterOffsetY } }.rounded(SimpleDialogRoundSize, SimpleDialogRoundSize, 0, 0).draw(BackgroundColor);
-				RectF{ boxPos + Vec2{ 0, SimpleDialogSize.y - FooterOffsetY }, { SimpleDialogSize.x, FooterOffsetY } }.rounded(0, 0, SimpleDialogRoundSize, SimpleDialogRoundSize).draw(BackgroundColorFooter);
+				m_boxBodyRect.draw(BackgroundColor);
+				m_boxFooterRect.draw(BackgroundColorFooter);
 
 				// メッセージ
-				const auto& font = SimpleGUI::GetFont();
-				font(m_text).drawAt(boxPos + (SimpleDialogSize - Vec2{ 0, FooterOffsetY }) / 2, TextColor);
+				m_drawableText.drawAt(m_textCenter, TextColor);
 
 				// ボタン
 				for (const auto& button : m_buttons)
@@ -271,17 +326,65 @@ namespace cotasklib::Co
 				: UpdaterSequenceBase<String>(layer, drawIndex)
 				, m_text(text)
 				, m_buttons(CreateButtons(buttonTexts))
+				, m_drawableText(SimpleGUI::GetFont()(m_text))
+				, m_boxBodyRect(RectF{ BoxPos(), { SimpleDialogSize.x, SimpleDialogSize.y - FooterOffsetY } }.rounded(SimpleDialogRoundSize, SimpleDialogRoundSize, 0, 0))
+				, m_boxFooterRect(RectF{ BoxPos() + Vec2{ 0, SimpleDialogSize.y - FooterOffsetY }, { SimpleDialogSize.x, FooterOffsetY } }.rounded(0, 0, SimpleDialogRoundSize, SimpleDialogRoundSize))
+				, m_textCenter(BoxPos() + (SimpleDialogSize - Vec2{ 0, FooterOffsetY }) / 2)
+				, m_inputBlocker(layer)
 			{
 				// フォントのテクスチャ生成にかかる時間によりフェードインアニメーションが飛ばないよう、プリロードしておく
-				SimpleGUI::GetFont().preload(m_text);
+				// (Co::PreloadDialogTextで事前にプリロード済みの文字はプリロードしない)
+				String allText = m_text;
 				for (const auto& buttonText : buttonTexts)
 				{
-					SimpleGUI::GetFont().preload(buttonText);
+					allText.append(buttonText);
 				}
+				PreloadDialogGlyphs(UnloadedDialogGlyphs(allText));
 			}
 		};
 	}
 
+	// SimpleDialogで表示する文字列のグリフを、1フレームあたりglyphsPerFrame文字ずつプリロードする
+	// (ダイアログの表示前に実行しておくことで、ダイアログを開く際のフォントのテクスチャ生成による停止を防ぐ。プリロード済みの文字は全てのダイアログで共有される)
+	[[nodiscard]]
+	inline Task<void> PreloadDialogText(String text, std::size_t glyphsPerFrame = 8)
+	{
+		if (glyphsPerFrame == 0)
+		{
+			throw Error{ U"PreloadDialogText: glyphsPerFrame must be greater than 0" };
+		}
+
+		const String unloadedGlyphs = detail::UnloadedDialogGlyphs(text);
+		for (std::size_t offset = 0; offset < unloadedGlyphs.size(); offset += glyphsPerFrame)
+		{
+			if (offset > 0)
+			{
+				co_await NextFrame();
+			}
+
+			// Note: 待機中に他のダイアログなどでプリロードされた文字は除く
+			detail::PreloadDialogGlyphs(detail::UnloadedDialogGlyphs(StringView{ unloadedGlyphs }.substr(offset, glyphsPerFrame)));
+		}
+	}
+
+	[[nodiscard]]
+	inline Task<void> PreloadDialogText(const Array<String>& texts, std::size_t glyphsPerFrame = 8)
+	{
+		String text;
+		for (const auto& t : texts)
+		{
+			text.append(t);
+		}
+		return PreloadDialogText(std::move(text), glyphsPerFrame);
+	}
+
+	// SimpleDialogで表示する文字列のグリフが全てプリロード済みかどうか
+	[[nodiscard]]
+	inline bool IsDialogTextPreloaded(StringView text)
+	{
+		return detail::UnloadedDialogGlyphs(text).isEmpty();
+	}
+
 	[[nodiscard]]
 	inline Task<String> SimpleDialog(StringView text, const Array<String>& buttonTexts, Layer layer = Layer::Modal, int32 drawIndex = DrawIndex::Default)
 	{
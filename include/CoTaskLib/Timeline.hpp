@@ -0,0 +1,492 @@
+﻿//----------------------------------------------------------------------------------------
+//
+//  CoTaskLib
+//
+//  Copyright (c) 2024 masaka
+//
+//  Licensed under the MIT License.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//----------------------------------------------------------------------------------------
+
+#pragma once
+#include "Core.hpp"
+#include "Ease.hpp"
+#include "Tween.hpp"
+
+namespace cotasklib::Co
+{
+	namespace detail
+	{
+		template <typename T>
+		concept TimelineValue = std::same_as<T, double> || std::same_as<T, Vec2> || std::same_as<T, ColorF>;
+
+		// Timelineに登録された、ある型の値の区間の一覧
+		// (区間を開始時刻順に並べ、再生中は開始済みで未終了の区間と新たに開始した区間のみを更新する)
+		template <TimelineValue T>
+		class TimelineSegmentList
+		{
+		private:
+			using EaseFunc = double(*)(double);
+
+			struct Segment
+			{
+				T* pTarget;
+				T from;
+				T to;
+				double startSec;
+				double endSec;
+				double invDurationSec;
+				EaseFunc easeFunc;
+
+				// 同じ対象に対して次に開始する区間の開始時刻(この時刻以降は値を書き込まない)
+				double supersededSec;
+			};
+
+			Array<Segment> m_segments;
+
+			bool m_isSorted = true;
+
+			// 対象ごとの開始時刻順で最後の区間のインデックス(並べ替え済みの場合のみ有効)
+			HashTable<T*, uint32> m_lastIndexByTarget;
+
+			// まだ開始していない最初の区間
+			std::size_t m_nextIndex = 0;
+
+			// 開始済みで未終了の区間(開始時刻順)
+			Array<uint32> m_activeIndices;
+
+			// Note: 開始済みの区間に対してのみ呼ぶため、長さ0の区間は常に終了済みとして扱う
+			[[nodiscard]]
+			static double ProgressAt(const Segment& segment, double timeSec)
+			{
+				if (segment.invDurationSec == 0.0)
+				{
+					return 1.0;
+				}
+				return Min(Max((timeSec - segment.startSec) * segment.invDurationSec, 0.0), 1.0);
+			}
+
+			static void Apply(const Segment& segment, double progress)
+			{
+				const double t = (segment.easeFunc == Easing::Linear) ? progress : segment.easeFunc(progress);
+				*segment.pTarget = GenericLerp(segment.from, segment.to, t);
+			}
+
+			// 同じ対象の直前の区間を、この区間の開始時刻で打ち切る
+			// (同じ対象の区間が重なる場合、開始時刻が後の区間(同じ開始時刻の場合は追加順で後の区間)が優先される)
+			void linkToPreviousSegment(std::size_t index)
+			{
+				Segment& segment = m_segments[index];
+				segment.supersededSec = std::numeric_limits<double>::infinity();
+
+				const auto [it, isInserted] = m_lastIndexByTarget.try_emplace(segment.pTarget, static_cast<uint32>(index));
+				if (!isInserted)
+				{
+					m_segments[it->second].supersededSec = segment.startSec;
+					it->second = static_cast<uint32>(index);
+				}
+			}
+
+			void sortIfNeeded()
+			{
+				if (m_isSorted)
+				{
+					return;
+				}
+				// Note: 同じ開始時刻の区間同士は追加順に書き込むよう、安定ソートを使用する
+				std::stable_sort(m_segments.begin(), m_segments.end(), [](const Segment& a, const Segment& b) { return a.startSec < b.startSec; });
+				m_isSorted = true;
+
+				m_lastIndexByTarget.clear();
+				for (std::size_t index = 0; index < m_segments.size(); ++index)
+				{
+					linkToPreviousSegment(index);
+				}
+			}
+
+		public:
+			void add(T* pTarget, double startSec, double endSec, T from, T to, EaseFunc easeFunc)
+			{
+				const double durationSec = endSec - startSec;
+				m_segments.push_back(Segment{
+					.pTarget = pTarget,
+					.from = std::move(from),
+					.to = std::move(to),
+					.startSec = startSec,
+					.endSec = endSec,
+					.invDurationSec = durationSec > 0.0 ? 1.0 / durationSec : 0.0,
+					.easeFunc = easeFunc,
+					.supersededSec = std::numeric_limits<double>::infinity(),
+				});
+				if (m_segments.size() >= 2 && m_segments[m_segments.size() - 2].startSec > startSec)
+				{
+					m_isSorted = false;
+				}
+				if (m_isSorted)
+				{
+					linkToPreviousSegment(m_segments.size() - 1);
+				}
+			}
+
+			void clear()
+			{
+				m_segments.clear();
+				m_isSorted = true;
+				m_lastIndexByTarget.clear();
+				m_nextIndex = 0;
+				m_activeIndices.clear();
+			}
+
+			[[nodiscard]]
+			std::size_t size() const noexcept
+			{
+				return m_segments.size();
+			}
+
+			[[nodiscard]]
+			double endSec() const
+			{
+				double endSec = 0.0;
+				for (const Segment& segment : m_segments)
+				{
+					endSec = Max(endSec, segment.endSec);
+				}
+				return endSec;
+			}
+
+			// 任意の時刻の値を書き込む(全区間を走査する)
+			// (まだ開始していない区間の対象には、その対象の最初の区間の開始値を書き込む)
+			// Note: 同じ対象の区間が重なる場合の優先順位はadvanceと同じ(開始済みのうち開始時刻が最も後の区間のみを書き込む)
+			void seek(double timeSec)
+			{
+				sortIfNeeded();
+
+				for (std::size_t i = m_segments.size(); i > 0; --i)
+				{
+					const Segment& segment = m_segments[i - 1];
+					if (segment.startSec <= timeSec)
+					{
+						break;
+					}
+					Apply(segment, 0.0);
+				}
+
+				m_activeIndices.clear();
+				std::size_t index = 0;
+				for (; index < m_segments.size() && m_segments[index].startSec <= timeSec; ++index)
+				{
+					const Segment& segment = m_segments[index];
+					if (segment.supersededSec <= timeSec)
+					{
+						continue;
+					}
+					Apply(segment, ProgressAt(segment, timeSec));
+					if (timeSec < segment.endSec)
+					{
+						m_activeIndices.push_back(static_cast<uint32>(index));
+					}
+				}
+				m_nextIndex = index;
+			}
+
+			// 前回の時刻から進めて値を書き込む(時刻は前回以上である必要がある)
+			void advance(double timeSec)
+			{
+				if (!m_isSorted)
+				{
+					// 再生中に区間が追加された場合は並べ直して全区間から求め直す
+					seek(timeSec);
+					return;
+				}
+
+				for (; m_nextIndex < m_segments.size() && m_segments[m_nextIndex].startSec <= timeSec; ++m_nextIndex)
+				{
+					m_activeIndices.push_back(static_cast<uint32>(m_nextIndex));
+				}
+
+				std::size_t writeIndex = 0;
+				for (const uint32 index : m_activeIndices)
+				{
+					const Segment& segment = m_segments[index];
+					if (segment.supersededSec <= timeSec)
+					{
+						// 同じ対象に対して後から開始した区間に引き継ぐ
+						continue;
+					}
+					Apply(segment, ProgressAt(segment, timeSec));
+					if (timeSec < segment.endSec)
+					{
+						m_activeIndices[writeIndex++] = index;
+					}
+				}
+				m_activeIndices.resize(writeIndex);
+			}
+
+			[[nodiscard]]
+			std::size_t activeCount() const noexcept
+			{
+				return m_activeIndices.size();
+			}
+		};
+	}
+
+	// 多数のキーフレームを1つのタイマーと1つのコルーチンでまとめて再生するタイムライン
+	// (値ごとにEaseのタスクを生成してAllやDelayで組み合わせる代わりに、対象・開始時刻・終了時刻・開始値・目標値・イージング関数を区間として登録する)
+	// Note: 登録した値のポインタ・Tweenerは、Timelineの破棄またはclear()まで有効である必要がある
+	class Timeline
+	{
+	private:
+		std::tuple<
+			detail::TimelineSegmentList<double>,
+			detail::TimelineSegmentList<Vec2>,
+			detail::TimelineSegmentList<ColorF>> m_segmentLists;
+
+		ISteadyClock* m_pSteadyClock;
+
+		double m_positionSec = 0.0;
+
+		// seekされるたびに進め、再生中のplay()に時刻の基準を取り直させる
+		uint64 m_seekCount = 0;
+
+		bool m_isPlaying = false;
+
+		struct PlayingScope
+		{
+			bool& isPlaying;
+
+			explicit PlayingScope(bool& isPlaying)
+				: isPlaying(isPlaying)
+			{
+				isPlaying = true;
+			}
+
+			~PlayingScope()
+			{
+				isPlaying = false;
+			}
+		};
+
+		template <typename TFunc>
+		void forEachSegmentList(TFunc func)
+		{
+			std::apply([&](auto&... segmentLists) { (func(segmentLists), ...); }, m_segmentLists);
+		}
+
+		template <typename TFunc>
+		void forEachSegmentList(TFunc func) const
+		{
+			std::apply([&](const auto&... segmentLists) { (func(segmentLists), ...); }, m_segmentLists);
+		}
+
+		[[nodiscard]]
+		double lengthSec() const
+		{
+			double lengthSec = 0.0;
+			forEachSegmentList([&](const auto& segmentList) { lengthSec = Max(lengthSec, segmentList.endSec()); });
+			return lengthSec;
+		}
+
+		void seekInternal(double positionSec)
+		{
+			m_positionSec = positionSec;
+			forEachSegmentList([&](auto& segmentList) { segmentList.seek(positionSec); });
+		}
+
+		void advance(double positionSec)
+		{
+			m_positionSec = positionSec;
+			forEachSegmentList([&](auto& segmentList) { segmentList.advance(positionSec); });
+		}
+
+	public:
+		explicit Timeline(ISteadyClock* pSteadyClock = nullptr)
+			: m_pSteadyClock(pSteadyClock)
+		{
+		}
+
+		// 登録した値のポインタや再生中のタスクから参照されるためコピー・ムーブ禁止
+		Timeline(const Timeline&) = delete;
+		Timeline& operator=(const Timeline&) = delete;
+		Timeline(Timeline&&) = delete;
+		Timeline& operator=(Timeline&&) = delete;
+
+		~Timeline() = default;
+
+		// startからendまでの間に、値をfromからtoへ推移させる区間を登録する
+		// (同じ値に対して複数の区間を登録した場合、開始時刻が後の区間の値が優先される)
+		template <detail::TimelineValue T>
+		Timeline& add(T* pTarget, Duration start, Duration end, T from, T to, double easeFunc(double) = EaseOutQuad)
+		{
+			if (!pTarget)
+			{
+				throw Error{ U"Timeline: pTarget must not be nullptr" };
+			}
+			if (start < Duration::zero() || end < start)
+			{
+				throw Error{ U"Timeline: Invalid time range" };
+			}
+			std::get<detail::TimelineSegmentList<T>>(m_segmentLists).add(pTarget, start.count(), end.count(), std::move(from), std::move(to), easeFunc);
+			return *this;
+		}
+
+		// キーフレームの時刻と値の組を時刻順に指定し、隣り合うキーフレームの間を区間として登録する
+		template <detail::TimelineValue T>
+		Timeline& addKeyframes(T* pTarget, std::initializer_list<std::pair<Duration, T>> keyframes, double easeFunc(double) = EaseOutQuad)
+		{
+			if (keyframes.size() == 1)
+			{
+				const auto& [time, value] = *keyframes.begin();
+				return add(pTarget, time, time, value, value, easeFunc);
+			}
+			for (auto it = keyframes.begin(); it != keyframes.end() && std::next(it) != keyframes.end(); ++it)
+			{
+				const auto& [startTime, fromValue] = *it;
+				const auto& [endTime, toValue] = *std::next(it);
+				add(pTarget, startTime, endTime, fromValue, toValue, easeFunc);
+			}
+			return *this;
+		}
+
+		Timeline& addPosition(Tweener& tweener, Duration start, Duration end, Vec2 from, Vec2 to, double easeFunc(double) = EaseOutQuad)
+		{
+			return add(&tweener.m_position, start, end, from, to, easeFunc);
+		}
+
+		Timeline& addScale(Tweener& tweener, Duration start, Duration end, Vec2 from, Vec2 to, double easeFunc(double) = EaseOutQuad)
+		{
+			return add(&tweener.m_scale, start, end, from, to, easeFunc);
+		}
+
+		Timeline& addRotation(Tweener& tweener, Duration start, Duration end, double from, double to, double easeFunc(double) = EaseOutQuad)
+		{
+			return add(&tweener.m_rotation, start, end, from, to, easeFunc);
+		}
+
+		Timeline& addColor(Tweener& tweener, Duration start, Duration end, ColorF from, ColorF to, double easeFunc(double) = EaseOutQuad)
+		{
+			return add(&tweener.m_color, start, end, from, to, easeFunc);
+		}
+
+		Timeline& addColorAdd(Tweener& tweener, Duration start, Duration end, ColorF from, ColorF to, double easeFunc(double) = EaseOutQuad)
+		{
+			return add(&tweener.m_colorAdd, start, end, from, to, easeFunc);
+		}
+
+		Timeline& addAlpha(Tweener& tweener, Duration start, Duration end, double from, double to, double easeFunc(double) = EaseOutQuad)
+		{
+			return add(&tweener.m_alpha, start, end, from, to, easeFunc);
+		}
+
+		// 全ての区間を削除し、再生位置を先頭に戻す
+		void clear()
+		{
+			forEachSegmentList([](auto& segmentList) { segmentList.clear(); });
+			m_positionSec = 0.0;
+			++m_seekCount;
+		}
+
+		// 登録されている区間の数
+		[[nodiscard]]
+		std::size_t size() const
+		{
+			std::size_t size = 0;
+			forEachSegmentList([&](const auto& segmentList) { size += segmentList.size(); });
+			return size;
+		}
+
+		// 直近の更新で値を書き込んだ区間のうち、まだ終了していない区間の数
+		[[nodiscard]]
+		std::size_t activeCount() const
+		{
+			std::size_t count = 0;
+			forEachSegmentList([&](const auto& segmentList) { count += segmentList.activeCount(); });
+			return count;
+		}
+
+		// 全区間の終了時刻のうち最も遅いもの
+		[[nodiscard]]
+		Duration length() const
+		{
+			return Duration{ lengthSec() };
+		}
+
+		[[nodiscard]]
+		Duration position() const noexcept
+		{
+			return Duration{ m_positionSec };
+		}
+
+		[[nodiscard]]
+		bool isPlaying() const noexcept
+		{
+			return m_isPlaying;
+		}
+
+		// 再生位置を移動し、その時刻の値を書き込む(0からlength()の範囲に丸められる)
+		// (毎フレーム呼ぶことで、スクラブ再生にも使用できる。再生中に呼んだ場合は移動先から再生を続ける)
+		void seek(Duration position)
+		{
+			seekInternal(Clamp(position.count(), 0.0, lengthSec()));
+			++m_seekCount;
+		}
+
+		// 現在の再生位置からlength()まで再生し、完了まで待機する
+		// (再生位置がすでにlength()の場合は、値を書き込んで即座に完了する)
+		[[nodiscard]]
+		Task<void> play()
+		{
+			if (m_isPlaying)
+			{
+				throw Error{ U"Timeline: play() is already running" };
+			}
+			const PlayingScope playingScope{ m_isPlaying };
+
+			seekInternal(m_positionSec);
+			while (m_positionSec < lengthSec())
+			{
+				// 再生開始時・seek時から残りの区間を1つのタイマーで計測する
+				const uint64 seekCount = m_seekCount;
+				const double startSec = m_positionSec;
+				const double remainingSec = lengthSec() - startSec;
+				detail::DeltaAggregateTimer timer{ Duration{ remainingSec }, m_pSteadyClock };
+				while (true)
+				{
+					co_await NextFrame();
+					if (m_seekCount != seekCount)
+					{
+						break;
+					}
+					timer.update();
+					const double progress = timer.progress0_1();
+					advance(progress >= 1.0 ? startSec + remainingSec : startSec + remainingSec * progress);
+					if (progress >= 1.0)
+					{
+						break;
+					}
+				}
+			}
+		}
+	};
+}
+
+#ifndef NO_COTASKLIB_USING
+using namespace cotasklib;
+#endif
@@ -42,9 +42,14 @@ namespace cotasklib::Co
 	};
 #pragma warning(pop)
 
+	class Timeline;
+
 	class Tweener
 	{
 	private:
+		// Timelineから各プロパティへ直接書き込むため
+		friend class Timeline;
+
 		Vec2 m_pivot = Vec2::Zero();
 		Vec2 m_position = Vec2::Zero();
 		double(*m_easeFuncPosition)(double);
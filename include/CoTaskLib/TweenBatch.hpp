@@ -0,0 +1,486 @@
+﻿//----------------------------------------------------------------------------------------
+//
+//  CoTaskLib
+//
+//  Copyright (c) 2024 masaka
+//
+//  Licensed under the MIT License.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//----------------------------------------------------------------------------------------
+
+#pragma once
+#include "Core.hpp"
+#include "Ease.hpp"
+
+namespace cotasklib::Co
+{
+	using TweenID = uint64;
+
+	using TweenGroupID = uint32;
+
+	// 多数の値のイージングを1つのタスクでまとめて毎フレーム進めるバッチ
+	// (1つ1つにコルーチンを生成するEaseと異なり、各値の開始値・目標値・経過時間などを配列ごとに保持し、まとめて更新する)
+	// Note: 登録した値のポインタは、完了またはキャンセルまで有効である必要がある
+	template <detail::Lerpable T>
+	class TweenBatch
+	{
+	private:
+		using EaseFunc = double(*)(double);
+
+		struct Slot
+		{
+			uint32 generation = 0;
+			uint32 denseIndex = 0;
+			bool inUse = false;
+
+			// このスロットの要素の完了・キャンセルを待つ待機
+			mutable detail::WaiterList finishWaiters;
+		};
+
+		struct GroupState
+		{
+			// 未完了数
+			std::size_t liveCount = 0;
+
+			// グループ内の要素が全て完了・キャンセルされるのを待つ待機
+			mutable detail::WaiterList finishWaiters;
+		};
+
+		// Note: 毎フレームのループで連続して読み書きするため、要素ごとではなくメンバごとに配列で保持する
+		Array<T*> m_targets;
+		Array<T> m_froms;
+		Array<T> m_tos;
+		Array<double> m_elapsedSecs;
+		Array<double> m_invDurationSecs;
+		Array<EaseFunc> m_easeFuncs;
+		Array<TweenGroupID> m_groups;
+		Array<uint32> m_slotIndices;
+
+		// 更新時の作業用配列
+		Array<double> m_progresses;
+
+		Array<Slot> m_slots;
+		Array<uint32> m_freeSlotIndices;
+
+		// グループごとの未完了数と待機(未完了のものがないグループは含まない)
+		HashTable<TweenGroupID, GroupState> m_groupStates;
+
+		// 削除フラグが立ったまま配列に残っている要素の数
+		std::size_t m_removedCount = 0;
+
+		ISteadyClock* m_pSteadyClock;
+		double m_prevTimeSec = 0.0;
+		int32 m_prevFrameCount = 0;
+
+		// 追加を待つ待機(run()が休止から復帰するために使用)
+		detail::WaiterList m_addWaiters;
+
+		// 全ての要素の完了・キャンセルを待つ待機
+		// Note: 待機の種類ごとにリストを分け、完了した要素に関係する待機のみに通知する
+		mutable detail::WaiterList m_allDoneWaiters;
+
+		[[nodiscard]]
+		double currentTimeSec() const
+		{
+			if (m_pSteadyClock)
+			{
+				return static_cast<double>(detail::Backend::SteadyClockMicrosec(m_pSteadyClock)) / 1'000'000.0;
+			}
+			return detail::Backend::SceneTime();
+		}
+
+		[[nodiscard]]
+		static TweenID MakeID(uint32 slotIndex, uint32 generation) noexcept
+		{
+			return (static_cast<TweenID>(generation) << 32) | slotIndex;
+		}
+
+		[[nodiscard]]
+		const Slot* findSlot(TweenID id) const noexcept
+		{
+			const uint32 slotIndex = static_cast<uint32>(id & 0xFFFFFFFFu);
+			if (slotIndex >= m_slots.size())
+			{
+				return nullptr;
+			}
+			const Slot& slot = m_slots[slotIndex];
+			if (!slot.inUse || slot.generation != static_cast<uint32>(id >> 32))
+			{
+				return nullptr;
+			}
+			return &slot;
+		}
+
+		void releaseGroupMember(TweenGroupID group)
+		{
+			const auto it = m_groupStates.find(group);
+			if (it != m_groupStates.end() && --it->second.liveCount == 0)
+			{
+				it->second.finishWaiters.notifyAll();
+				m_groupStates.erase(it);
+			}
+		}
+
+		// 削除フラグ(スロット番号が無効値)の立った要素を詰める
+		// (同じ値を対象とする要素同士の書き込み順が変わらないよう、末尾との入れ替えではなく順序を保って詰める)
+		void compact()
+		{
+			std::size_t writeIndex = 0;
+			for (std::size_t readIndex = 0; readIndex < m_slotIndices.size(); ++readIndex)
+			{
+				const uint32 slotIndex = m_slotIndices[readIndex];
+				if (slotIndex == InvalidSlotIndex)
+				{
+					continue;
+				}
+				if (writeIndex != readIndex)
+				{
+					m_targets[writeIndex] = m_targets[readIndex];
+					m_froms[writeIndex] = std::move(m_froms[readIndex]);
+					m_tos[writeIndex] = std::move(m_tos[readIndex]);
+					m_elapsedSecs[writeIndex] = m_elapsedSecs[readIndex];
+					m_invDurationSecs[writeIndex] = m_invDurationSecs[readIndex];
+					m_easeFuncs[writeIndex] = m_easeFuncs[readIndex];
+					m_groups[writeIndex] = m_groups[readIndex];
+					m_slotIndices[writeIndex] = slotIndex;
+					m_slots[slotIndex].denseIndex = static_cast<uint32>(writeIndex);
+				}
+				++writeIndex;
+			}
+			m_targets.resize(writeIndex);
+			m_froms.erase(m_froms.begin() + writeIndex, m_froms.end());
+			m_tos.erase(m_tos.begin() + writeIndex, m_tos.end());
+			m_elapsedSecs.resize(writeIndex);
+			m_invDurationSecs.resize(writeIndex);
+			m_easeFuncs.resize(writeIndex);
+			m_groups.resize(writeIndex);
+			m_slotIndices.resize(writeIndex);
+			m_removedCount = 0;
+		}
+
+		// 削除フラグの立った要素が一定数を超えた場合のみ詰める
+		// (キャンセルのたびに詰めるとk個のキャンセルでO(k・n)となるため、要素数の半分を超えるまでは次回のupdateでまとめて詰める)
+		void compactIfManyRemoved()
+		{
+			if (m_removedCount >= Max(CompactThreshold, m_slotIndices.size() / 2))
+			{
+				compact();
+			}
+		}
+
+		// 要素に削除フラグを立て、その要素に関係する待機に通知する(配列からの削除はcompactで行う)
+		void markRemoved(std::size_t denseIndex)
+		{
+			const uint32 slotIndex = m_slotIndices[denseIndex];
+			Slot& slot = m_slots[slotIndex];
+			slot.inUse = false;
+			++slot.generation;
+			slot.finishWaiters.notifyAll();
+			m_freeSlotIndices.push_back(slotIndex);
+			releaseGroupMember(m_groups[denseIndex]);
+			m_slotIndices[denseIndex] = InvalidSlotIndex;
+			++m_removedCount;
+			if (allDone())
+			{
+				m_allDoneWaiters.notifyAll();
+			}
+		}
+
+		static constexpr uint32 InvalidSlotIndex = std::numeric_limits<uint32>::max();
+
+		static constexpr std::size_t CompactThreshold = 64;
+
+	public:
+		explicit TweenBatch(ISteadyClock* pSteadyClock = nullptr)
+			: m_pSteadyClock(pSteadyClock)
+		{
+		}
+
+		// 登録した値のポインタや待機側から参照されるためコピー・ムーブ禁止
+		TweenBatch(const TweenBatch&) = delete;
+		TweenBatch& operator=(const TweenBatch&) = delete;
+		TweenBatch(TweenBatch&&) = delete;
+		TweenBatch& operator=(TweenBatch&&) = delete;
+
+		~TweenBatch() = default;
+
+		// イージングを登録し、開始値を即座に書き込む(時間が0の場合は目標値を書き込み、登録せずに完了済みのIDを返す)
+		TweenID add(T* pTarget, T from, T to, Duration duration, double easeFunc(double) = EaseOutQuad, TweenGroupID group = 0)
+		{
+			if (!pTarget)
+			{
+				throw Error{ U"TweenBatch: pTarget must not be nullptr" };
+			}
+
+			const double durationSec = duration.count();
+			if (durationSec <= 0.0)
+			{
+				*pTarget = detail::GenericLerp(from, to, easeFunc(1.0));
+				return 0;
+			}
+
+			*pTarget = detail::GenericLerp(from, to, easeFunc(0.0));
+
+			// 経過時間の基準を揃える
+			// (このフレームの更新がまだの場合は次回の更新で前フレームからの経過時間が加算されるため、その分を差し引いておく)
+			const int32 frameCount = detail::Backend::FrameCount();
+			const double timeSec = currentTimeSec();
+			double elapsedSec = 0.0;
+			if (allDone())
+			{
+				m_prevFrameCount = frameCount;
+				m_prevTimeSec = timeSec;
+			}
+			else if (frameCount - m_prevFrameCount == 1)
+			{
+				elapsedSec = m_prevTimeSec - timeSec;
+			}
+
+			uint32 slotIndex;
+			if (m_freeSlotIndices.empty())
+			{
+				slotIndex = static_cast<uint32>(m_slots.size());
+				m_slots.emplace_back();
+				// Note: 世代0のID(=0)は完了済みのIDとして使用するため、世代1から始める
+				m_slots.back().generation = 1;
+			}
+			else
+			{
+				slotIndex = m_freeSlotIndices.back();
+				m_freeSlotIndices.pop_back();
+			}
+			Slot& slot = m_slots[slotIndex];
+			slot.inUse = true;
+			slot.denseIndex = static_cast<uint32>(m_slotIndices.size());
+
+			m_targets.push_back(pTarget);
+			m_froms.push_back(std::move(from));
+			m_tos.push_back(std::move(to));
+			m_elapsedSecs.push_back(elapsedSec);
+			m_invDurationSecs.push_back(1.0 / durationSec);
+			m_easeFuncs.push_back(easeFunc);
+			m_groups.push_back(group);
+			m_slotIndices.push_back(slotIndex);
+			++m_groupStates[group].liveCount;
+
+			m_addWaiters.notifyAll();
+			return MakeID(slotIndex, slot.generation);
+		}
+
+		// 値を書き込まずにイージングを中止する
+		bool cancel(TweenID id)
+		{
+			const Slot* pSlot = findSlot(id);
+			if (!pSlot)
+			{
+				return false;
+			}
+			markRemoved(pSlot->denseIndex);
+			compactIfManyRemoved();
+			return true;
+		}
+
+		// 指定グループのイージングを全て中止する
+		void cancelGroup(TweenGroupID group)
+		{
+			if (!m_groupStates.contains(group))
+			{
+				return;
+			}
+			for (std::size_t i = 0; i < m_groups.size(); ++i)
+			{
+				if (m_groups[i] == group && m_slotIndices[i] != InvalidSlotIndex)
+				{
+					markRemoved(i);
+				}
+			}
+			compact();
+		}
+
+		// 全てのイージングを中止する
+		void clear()
+		{
+			for (std::size_t i = 0; i < m_slotIndices.size(); ++i)
+			{
+				if (m_slotIndices[i] != InvalidSlotIndex)
+				{
+					markRemoved(i);
+				}
+			}
+			compact();
+		}
+
+		[[nodiscard]]
+		bool isDone(TweenID id) const noexcept
+		{
+			return findSlot(id) == nullptr;
+		}
+
+		[[nodiscard]]
+		bool isGroupDone(TweenGroupID group) const
+		{
+			return !m_groupStates.contains(group);
+		}
+
+		[[nodiscard]]
+		bool allDone() const noexcept
+		{
+			return size() == 0;
+		}
+
+		[[nodiscard]]
+		std::size_t size() const noexcept
+		{
+			return m_slotIndices.size() - m_removedCount;
+		}
+
+		// 経過時間を進めて値を書き込み、完了したものを取り除く
+		// (通常はrun()で毎フレーム呼ばれる。ポーズ中や同一フレーム内での多重呼び出しでは時間を進行させない)
+		void update()
+		{
+			const int32 frameCount = detail::Backend::FrameCount();
+			const double timeSec = currentTimeSec();
+			const double deltaSec = (frameCount - m_prevFrameCount == 1) ? (timeSec - m_prevTimeSec) : 0.0;
+			m_prevFrameCount = frameCount;
+			m_prevTimeSec = timeSec;
+
+			// 前回の更新以降にキャンセルされた要素を詰める(以降のループでは削除フラグを調べない)
+			if (m_removedCount > 0)
+			{
+				compact();
+			}
+
+			const std::size_t count = m_slotIndices.size();
+			if (count == 0 || deltaSec <= 0.0)
+			{
+				// 値は前回から変化しないため書き込み不要
+				return;
+			}
+
+			// 経過時間と進行度の計算(分岐を含まないループに分けて自動ベクトル化されやすくする)
+			double* const pElapsedSecs = m_elapsedSecs.data();
+			const double* const pInvDurationSecs = m_invDurationSecs.data();
+			m_progresses.resize(count);
+			double* const pProgresses = m_progresses.data();
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				pElapsedSecs[i] += deltaSec;
+			}
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				pProgresses[i] = Min(Max(pElapsedSecs[i] * pInvDurationSecs[i], 0.0), 1.0);
+			}
+
+			// イージング関数の適用と書き込み
+			std::size_t finishedCount = 0;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const double progress = pProgresses[i];
+				const EaseFunc easeFunc = m_easeFuncs[i];
+				const double t = (easeFunc == Easing::Linear) ? progress : easeFunc(progress);
+				*m_targets[i] = detail::GenericLerp(m_froms[i], m_tos[i], t);
+				if (progress >= 1.0)
+				{
+					markRemoved(i);
+					++finishedCount;
+				}
+			}
+
+			if (finishedCount > 0)
+			{
+				compact();
+			}
+		}
+
+		// 毎フレームupdate()を呼ぶタスク(登録されたイージングがない間は休止する)
+		[[nodiscard]]
+		Task<void> run()
+		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
+			while (true)
+			{
+				if (allDone())
+				{
+					// 追加されるまで休止し、復帰したフレームから更新する
+					m_addWaiters.push(node, &sleeper);
+					co_await detail::SleepAwaiter{ &sleeper };
+				}
+				else
+				{
+					co_await NextFrame();
+				}
+				update();
+			}
+		}
+
+		[[nodiscard]]
+		ScopedTaskRunner runScoped()
+		{
+			return run().runScoped();
+		}
+
+		[[nodiscard]]
+		Task<void> waitUntilDone(TweenID id) const
+		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
+			while (const Slot* pSlot = findSlot(id))
+			{
+				pSlot->finishWaiters.push(node, &sleeper);
+				co_await detail::SleepAwaiter{ &sleeper };
+			}
+		}
+
+		[[nodiscard]]
+		Task<void> waitUntilGroupDone(TweenGroupID group) const
+		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
+			while (true)
+			{
+				const auto it = m_groupStates.find(group);
+				if (it == m_groupStates.end())
+				{
+					break;
+				}
+				it->second.finishWaiters.push(node, &sleeper);
+				co_await detail::SleepAwaiter{ &sleeper };
+			}
+		}
+
+		[[nodiscard]]
+		Task<void> waitUntilAllDone() const
+		{
+			detail::SignalSleeper sleeper;
+			detail::WaiterNode node;
+			while (!allDone())
+			{
+				m_allDoneWaiters.push(node, &sleeper);
+				co_await detail::SleepAwaiter{ &sleeper };
+			}
+		}
+	};
+}
+
+#ifndef NO_COTASKLIB_USING
+using namespace cotasklib;
+#endif
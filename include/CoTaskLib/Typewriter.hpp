@@ -34,18 +34,37 @@ namespace cotasklib::Co
 {
 	namespace detail
 	{
+		// 表示文字数が変化した際に呼ばれる出力先
+		// textはタスクが所有する全文、prevLengthは前回の表示文字数(初回は0)、lengthは今回の表示文字数
+		using TypewriterSink = std::function<void(const String& text, std::size_t prevLength, std::size_t length)>;
+
 		[[nodiscard]]
-		inline Task<void> TypewriterTask(std::function<void(const String&)> callback, const Duration totalDuration, const String text, ISteadyClock* pSteadyClock)
+		inline Task<void> TypewriterTask(TypewriterSink sink, const String text, const Array<double> revealSecs, const Duration totalDuration, ISteadyClock* pSteadyClock)
 		{
+			// revealSecs[i]はi+1文字目が表示される時刻(秒)。毎フレームの再計算を避けるため事前に計算済みのものを受け取る
+			const double totalSec = totalDuration.count();
 			Optional<std::size_t> prevLength = none; // textが空文字列の場合の初回コールバック呼び出しを考慮するためOptionalを使用
+			std::size_t length = 0;
 			detail::DeltaAggregateTimer timer{ totalDuration, pSteadyClock };
 			while (true)
 			{
 				const double progress = timer.progress0_1();
-				const std::size_t length = Min(static_cast<std::size_t>(1 + text.length() * progress), text.length());
+				if (progress >= 1.0)
+				{
+					length = text.length();
+				}
+				else
+				{
+					// 時間は巻き戻らないため、前回の位置から進めるだけでよい
+					const double elapsedSec = totalSec * progress;
+					while (length < revealSecs.size() && revealSecs[length] <= elapsedSec)
+					{
+						++length;
+					}
+				}
 				if (length != prevLength)
 				{
-					callback(text.substr(0, length));
+					sink(text, prevLength.value_or(0), length);
 					prevLength = length;
 				}
 				if (progress >= 1.0)
@@ -61,21 +80,60 @@ namespace cotasklib::Co
 	class [[nodiscard]] TypewriterTaskBuilder
 	{
 	private:
-		std::function<void(const String&)> m_callback;
+		detail::TypewriterSink m_sink;
 		Duration m_duration;
 		bool m_isOneLetterDuration;
 		String m_text;
+		Array<std::pair<String, Duration>> m_pauses;
 		ISteadyClock* m_pSteadyClock;
 
+		// 各文字が表示される時刻の表と全体の時間を計算する
+		// 文字ごとの待機時間の判定はここで一度だけ行い、再生中には行わない
 		[[nodiscard]]
-		Duration calcTotalDuration() const
+		std::pair<Array<double>, Duration> calcRevealTable() const
 		{
-			return m_isOneLetterDuration ? m_duration * m_text.length() : m_duration;
+			const std::size_t length = m_text.length();
+			Array<double> revealSecs(length);
+			if (length == 0)
+			{
+				return { std::move(revealSecs), m_isOneLetterDuration ? Duration::zero() : m_duration };
+			}
+
+			const double oneLetterSec = m_isOneLetterDuration ? m_duration.count() : m_duration.count() / length;
+			double sec = 0.0;
+			for (std::size_t i = 0; i < length; ++i)
+			{
+				revealSecs[i] = sec;
+				sec += oneLetterSec;
+				for (const auto& [chars, pauseDuration] : m_pauses)
+				{
+					if (chars.contains(m_text[i]))
+					{
+						sec += pauseDuration.count();
+					}
+				}
+			}
+
+			if (m_isOneLetterDuration)
+			{
+				return { std::move(revealSecs), Duration{ sec } };
+			}
+
+			// 全体の時間が指定されている場合は、待機時間を含めた比率を保ったまま指定時間に収める
+			if (sec > 0.0)
+			{
+				const double scale = m_duration.count() / sec;
+				for (double& revealSec : revealSecs)
+				{
+					revealSec *= scale;
+				}
+			}
+			return { std::move(revealSecs), m_duration };
 		}
 
 	public:
-		explicit TypewriterTaskBuilder(std::function<void(const String&)> callback, Duration oneLetterDuration, StringView text, ISteadyClock* pSteadyClock)
-			: m_callback(std::move(callback))
+		explicit TypewriterTaskBuilder(detail::TypewriterSink sink, Duration oneLetterDuration, StringView text, ISteadyClock* pSteadyClock)
+			: m_sink(std::move(sink))
 			, m_duration(oneLetterDuration)
 			, m_isOneLetterDuration(true)
 			, m_text(text)
@@ -83,6 +141,15 @@ namespace cotasklib::Co
 		{
 		}
 
+		explicit TypewriterTaskBuilder(std::function<void(const String&)> callback, Duration oneLetterDuration, StringView text, ISteadyClock* pSteadyClock)
+			: TypewriterTaskBuilder(
+				[callback = std::move(callback)](const String& text, std::size_t, std::size_t length) { callback(text.substr(0, length)); },
+				oneLetterDuration,
+				text,
+				pSteadyClock)
+		{
+		}
+
 		TypewriterTaskBuilder(const TypewriterTaskBuilder&) = default;
 		TypewriterTaskBuilder(TypewriterTaskBuilder&&) = default;
 		TypewriterTaskBuilder& operator=(const TypewriterTaskBuilder&) = default;
@@ -108,6 +175,12 @@ namespace cotasklib::Co
 			return *this;
 		}
 
+		TypewriterTaskBuilder& pauseAfter(StringView chars, Duration pauseDuration)
+		{
+			m_pauses.emplace_back(String{ chars }, pauseDuration);
+			return *this;
+		}
+
 		TypewriterTaskBuilder& setClock(ISteadyClock* pSteadyClock)
 		{
 			m_pSteadyClock = pSteadyClock;
@@ -116,7 +189,8 @@ namespace cotasklib::Co
 
 		Task<void> play()
 		{
-			return detail::TypewriterTask(m_callback, calcTotalDuration(), m_text, m_pSteadyClock);
+			auto [revealSecs, totalDuration] = calcRevealTable();
+			return detail::TypewriterTask(m_sink, m_text, std::move(revealSecs), totalDuration, m_pSteadyClock);
 		}
 
 		ScopedTaskRunner playScoped()
@@ -133,7 +207,19 @@ namespace cotasklib::Co
 	[[nodiscard]]
 	inline TypewriterTaskBuilder Typewriter(String* pText, Duration oneLetterDuration = 0s, StringView text = U"", ISteadyClock* pSteadyClock = nullptr)
 	{
-		return TypewriterTaskBuilder([pText](const String& text) { *pText = text; }, oneLetterDuration, text, pSteadyClock);
+		// 前回書き込んだ内容から変更されていなければ、新たに表示された文字のみを末尾に追加する
+		detail::TypewriterSink sink = [pText](const String& text, std::size_t prevLength, std::size_t length)
+			{
+				if (prevLength == 0 || length < prevLength || pText->length() != prevLength)
+				{
+					pText->assign(StringView{ text }.substr(0, length));
+				}
+				else
+				{
+					pText->append(StringView{ text }.substr(prevLength, length - prevLength));
+				}
+			};
+		return TypewriterTaskBuilder(std::move(sink), oneLetterDuration, text, pSteadyClock);
 	}
 
 	[[nodiscard]]
@@ -141,6 +227,18 @@ namespace cotasklib::Co
 	{
 		return TypewriterTaskBuilder(std::move(callback), oneLetterDuration, text, pSteadyClock);
 	}
+
+	// 表示中の部分文字列をStringViewで受け取る文字送り
+	// StringViewはタスクが所有する文字列を指すため、コールバック内でのみ有効
+	[[nodiscard]]
+	inline TypewriterTaskBuilder TypewriterView(std::function<void(StringView)> callback, Duration oneLetterDuration = 0s, StringView text = U"", ISteadyClock* pSteadyClock = nullptr)
+	{
+		detail::TypewriterSink sink = [callback = std::move(callback)](const String& text, std::size_t, std::size_t length)
+			{
+				callback(StringView{ text }.substr(0, length));
+			};
+		return TypewriterTaskBuilder(std::move(sink), oneLetterDuration, text, pSteadyClock);
+	}
 }
 
 #ifndef NO_COTASKLIB_USING
@@ -0,0 +1,561 @@
+﻿//----------------------------------------------------------------------------------------
+//
+//  CoTaskLib
+//
+//  Copyright (c) 2024 masaka
+//
+//  Licensed under the MIT License.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//----------------------------------------------------------------------------------------
+
+#pragma once
+#include "Core.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cotasklib::Co
+{
+	namespace detail
+	{
+		// 関数がCancellationTokenを受け取る場合のみ、引数の末尾に渡して呼び出す
+		template <typename TFunc, typename... Args>
+		decltype(auto) InvokeWorkerFunc(TFunc& func, const CancellationToken& cancellationToken, Args... args)
+		{
+			if constexpr (std::invocable<TFunc&, Args..., const CancellationToken&>)
+			{
+				return func(args..., cancellationToken);
+			}
+			else
+			{
+				return func(args...);
+			}
+		}
+
+		template <typename TFunc, typename... Args>
+		using WorkerFuncResult = decltype(InvokeWorkerFunc(std::declval<TFunc&>(), std::declval<const CancellationToken&>(), std::declval<Args>()...));
+
+		// ワーカースレッドで実行するジョブ
+		// (ワーカー側・待機するタスク側・完了キューの三者から参照カウントで保持され、最後に手放した側が破棄する)
+		class WorkerJobBase : public ICompletionNode
+		{
+		private:
+			std::atomic<uint32> m_refCount = 1;
+
+			// 要素数(RunOnWorkerの場合は1)
+			std::size_t m_count;
+
+			std::atomic<std::size_t> m_nextIndex = 0;
+
+			std::atomic<std::size_t> m_remainingCount;
+
+			std::shared_ptr<CompletionQueue> m_pCompletionQueue;
+
+			// 待機側のタスクが破棄された、または要素が例外を投げた場合にキャンセルを要求し、未着手の要素を実行しない
+			CancellationToken m_cancellationToken;
+
+			std::mutex m_exceptionMutex;
+
+			std::exception_ptr m_exception;
+
+			// 以下はメインスレッドからのみ参照する
+			SignalSleeper* m_pSleeper = nullptr;
+
+			bool m_isCompleted = false;
+
+		protected:
+			// ワーカースレッドで要素を1つ実行する
+			virtual void runItem(std::size_t index) = 0;
+
+			void rethrowIfFailed()
+			{
+				if (m_exception)
+				{
+					std::rethrow_exception(m_exception);
+				}
+			}
+
+		public:
+			WorkerJobBase(std::size_t count, std::shared_ptr<CompletionQueue> pCompletionQueue)
+				: m_count(count)
+				, m_remainingCount(count)
+				, m_pCompletionQueue(std::move(pCompletionQueue))
+			{
+			}
+
+			WorkerJobBase(const WorkerJobBase&) = delete;
+
+			WorkerJobBase& operator=(const WorkerJobBase&) = delete;
+
+			void addRef() noexcept
+			{
+				m_refCount.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			void release() noexcept override
+			{
+				if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					delete this;
+				}
+			}
+
+			[[nodiscard]]
+			std::size_t count() const noexcept
+			{
+				return m_count;
+			}
+
+			[[nodiscard]]
+			const CancellationToken& cancellationToken() const noexcept
+			{
+				return m_cancellationToken;
+			}
+
+			// ワーカースレッドで未着手の要素がなくなるまで実行する
+			void runOnWorker()
+			{
+				std::size_t doneCount = 0;
+				for (std::size_t index = m_nextIndex.fetch_add(1, std::memory_order_relaxed); index < m_count; index = m_nextIndex.fetch_add(1, std::memory_order_relaxed))
+				{
+					if (!m_cancellationToken.isCancellationRequested())
+					{
+						try
+						{
+							runItem(index);
+						}
+						catch (...)
+						{
+							const std::lock_guard lock{ m_exceptionMutex };
+							if (!m_exception)
+							{
+								m_exception = std::current_exception();
+							}
+							m_cancellationToken.requestCancel();
+						}
+					}
+					++doneCount;
+				}
+
+				if (doneCount > 0 && m_remainingCount.fetch_sub(doneCount, std::memory_order_acq_rel) == doneCount)
+				{
+					// 最後の要素を終えたワーカーが完了キューへ積む
+					// (キューがジョブを、ジョブがキューを保持し続けないよう、積む前にキューへの参照を手放す)
+					const std::shared_ptr<CompletionQueue> pCompletionQueue = std::move(m_pCompletionQueue);
+					addRef();
+					pCompletionQueue->push(this);
+				}
+			}
+
+			void onCompleted() override
+			{
+				m_isCompleted = true;
+				if (m_pSleeper)
+				{
+					m_pSleeper->notify();
+				}
+			}
+
+			// 以下はメインスレッドからのみ呼び出す
+
+			void setSleeper(SignalSleeper* pSleeper) noexcept
+			{
+				m_pSleeper = pSleeper;
+			}
+
+			[[nodiscard]]
+			bool isCompleted() const noexcept
+			{
+				return m_isCompleted;
+			}
+
+			void abort() noexcept
+			{
+				m_pSleeper = nullptr;
+				m_cancellationToken.requestCancel();
+			}
+		};
+
+		// ワーカースレッドのプール
+		// (ワーカーごとにキューを持ち、自身のキューが空になると他のワーカーのキューの先頭から奪って実行する)
+		class WorkerPool
+		{
+		private:
+			struct WorkerQueue
+			{
+				std::mutex mutex;
+				std::deque<WorkerJobBase*> jobs;
+			};
+
+			Array<std::unique_ptr<WorkerQueue>> m_queues;
+
+			Array<std::thread> m_threads;
+
+			std::atomic<std::size_t> m_pendingCount = 0;
+
+			std::atomic<std::size_t> m_nextQueueIndex = 0;
+
+			std::mutex m_sleepMutex;
+
+			std::condition_variable m_sleepCondition;
+
+			bool m_isStopping = false;
+
+			[[nodiscard]]
+			WorkerJobBase* tryPop(std::size_t workerIndex)
+			{
+				{
+					// 自身のキューは末尾から取り出す
+					WorkerQueue& queue = *m_queues[workerIndex];
+					const std::lock_guard lock{ queue.mutex };
+					if (!queue.jobs.empty())
+					{
+						WorkerJobBase* const pJob = queue.jobs.back();
+						queue.jobs.pop_back();
+						return pJob;
+					}
+				}
+
+				for (std::size_t i = 1; i < m_queues.size(); ++i)
+				{
+					// 他のワーカーのキューは先頭から奪う
+					WorkerQueue& queue = *m_queues[(workerIndex + i) % m_queues.size()];
+					const std::lock_guard lock{ queue.mutex };
+					if (!queue.jobs.empty())
+					{
+						WorkerJobBase* const pJob = queue.jobs.front();
+						queue.jobs.pop_front();
+						return pJob;
+					}
+				}
+
+				return nullptr;
+			}
+
+			void workerMain(std::size_t workerIndex)
+			{
+				while (true)
+				{
+					if (WorkerJobBase* const pJob = tryPop(workerIndex))
+					{
+						m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+						pJob->runOnWorker();
+						pJob->release();
+						continue;
+					}
+
+					std::unique_lock lock{ m_sleepMutex };
+					m_sleepCondition.wait(lock, [this] { return m_isStopping || m_pendingCount.load(std::memory_order_relaxed) > 0; });
+					if (m_isStopping)
+					{
+						return;
+					}
+				}
+			}
+
+		public:
+			explicit WorkerPool(std::size_t threadCount)
+			{
+				threadCount = Max<std::size_t>(threadCount, 1);
+				m_queues.reserve(threadCount);
+				for (std::size_t i = 0; i < threadCount; ++i)
+				{
+					m_queues.push_back(std::make_unique<WorkerQueue>());
+				}
+				m_threads.reserve(threadCount);
+				for (std::size_t i = 0; i < threadCount; ++i)
+				{
+					m_threads.emplace_back([this, i] { workerMain(i); });
+				}
+			}
+
+			WorkerPool(const WorkerPool&) = delete;
+
+			WorkerPool& operator=(const WorkerPool&) = delete;
+
+			~WorkerPool()
+			{
+				{
+					const std::lock_guard lock{ m_sleepMutex };
+					m_isStopping = true;
+				}
+				m_sleepCondition.notify_all();
+				for (std::thread& thread : m_threads)
+				{
+					thread.join();
+				}
+
+				// 未着手のジョブは実行せずに参照を解放する
+				for (const auto& pQueue : m_queues)
+				{
+					for (WorkerJobBase* const pJob : pQueue->jobs)
+					{
+						pJob->release();
+					}
+				}
+			}
+
+			[[nodiscard]]
+			static WorkerPool& Instance()
+			{
+				static WorkerPool instance{ Max(std::thread::hardware_concurrency(), 2U) - 1 };
+				return instance;
+			}
+
+			[[nodiscard]]
+			std::size_t threadCount() const noexcept
+			{
+				return m_threads.size();
+			}
+
+			// ジョブを投入する
+			// (要素数が多い場合もワーカー数を上限とした件数のみキューへ積み、各ワーカーは同じジョブから未着手の要素を順に取り出す)
+			void submit(WorkerJobBase* pJob)
+			{
+				const std::size_t parallelism = Min(pJob->count(), m_queues.size());
+				if (parallelism == 0)
+				{
+					return;
+				}
+
+				// Note: キューへ積んだ直後にワーカーが取り出して減算しうるため、積む前に加算する
+				//       (後から加算すると一時的に0を下回り、size_tの値が巨大になって待機中のワーカーが空回りする)
+				{
+					const std::lock_guard lock{ m_sleepMutex };
+					m_pendingCount.fetch_add(parallelism, std::memory_order_relaxed);
+				}
+
+				const std::size_t firstQueueIndex = m_nextQueueIndex.fetch_add(parallelism, std::memory_order_relaxed);
+				for (std::size_t i = 0; i < parallelism; ++i)
+				{
+					pJob->addRef();
+					WorkerQueue& queue = *m_queues[(firstQueueIndex + i) % m_queues.size()];
+					const std::lock_guard lock{ queue.mutex };
+					queue.jobs.push_back(pJob);
+				}
+
+				if (parallelism == 1)
+				{
+					m_sleepCondition.notify_one();
+				}
+				else
+				{
+					m_sleepCondition.notify_all();
+				}
+			}
+		};
+
+		// 待機側のタスクが保持するジョブへの参照
+		// (破棄時にジョブを中断扱いにするため、待機中にタスクが破棄されても未着手の要素は実行されない)
+		template <typename TJob>
+		class WorkerJobRef
+		{
+		private:
+			TJob* m_pJob;
+
+		public:
+			explicit WorkerJobRef(TJob* pJob) noexcept
+				: m_pJob(pJob)
+			{
+			}
+
+			WorkerJobRef(const WorkerJobRef&) = delete;
+
+			WorkerJobRef& operator=(const WorkerJobRef&) = delete;
+
+			WorkerJobRef(WorkerJobRef&& other) noexcept
+				: m_pJob(std::exchange(other.m_pJob, nullptr))
+			{
+			}
+
+			WorkerJobRef& operator=(WorkerJobRef&&) = delete;
+
+			~WorkerJobRef()
+			{
+				if (m_pJob)
+				{
+					m_pJob->abort();
+					m_pJob->release();
+				}
+			}
+
+			[[nodiscard]]
+			TJob* get() const noexcept
+			{
+				return m_pJob;
+			}
+
+			[[nodiscard]]
+			TJob* operator->() const noexcept
+			{
+				return m_pJob;
+			}
+		};
+
+		template <typename TFunc, typename TResult>
+		class WorkerFuncJob : public WorkerJobBase
+		{
+		private:
+			TFunc m_func;
+
+			Optional<std::conditional_t<std::is_void_v<TResult>, std::monostate, TResult>> m_result;
+
+		protected:
+			void runItem(std::size_t) override
+			{
+				if constexpr (std::is_void_v<TResult>)
+				{
+					InvokeWorkerFunc(m_func, cancellationToken());
+					m_result.emplace();
+				}
+				else
+				{
+					m_result.emplace(InvokeWorkerFunc(m_func, cancellationToken()));
+				}
+			}
+
+		public:
+			WorkerFuncJob(TFunc&& func, std::shared_ptr<CompletionQueue> pCompletionQueue)
+				: WorkerJobBase(1, std::move(pCompletionQueue))
+				, m_func(std::move(func))
+			{
+			}
+
+			[[nodiscard]]
+			TResult takeResult()
+			{
+				rethrowIfFailed();
+				if constexpr (!std::is_void_v<TResult>)
+				{
+					return std::move(*m_result);
+				}
+			}
+		};
+
+		template <typename TFunc, typename TResult>
+		class WorkerBatchJob : public WorkerJobBase
+		{
+		private:
+			TFunc m_func;
+
+			// Note: Array<bool>の要素を複数のワーカーから書き込まないよう、要素ごとにOptionalで持つ
+			std::vector<Optional<std::conditional_t<std::is_void_v<TResult>, std::monostate, TResult>>> m_results;
+
+		protected:
+			void runItem(std::size_t index) override
+			{
+				if constexpr (std::is_void_v<TResult>)
+				{
+					InvokeWorkerFunc(m_func, cancellationToken(), index);
+				}
+				else
+				{
+					m_results[index].emplace(InvokeWorkerFunc(m_func, cancellationToken(), index));
+				}
+			}
+
+		public:
+			WorkerBatchJob(std::size_t count, TFunc&& func, std::shared_ptr<CompletionQueue> pCompletionQueue)
+				: WorkerJobBase(count, std::move(pCompletionQueue))
+				, m_func(std::move(func))
+			{
+				if constexpr (!std::is_void_v<TResult>)
+				{
+					m_results.resize(count);
+				}
+			}
+
+			[[nodiscard]]
+			auto takeResult()
+			{
+				rethrowIfFailed();
+				if constexpr (!std::is_void_v<TResult>)
+				{
+					Array<TResult> results;
+					results.reserve(m_results.size());
+					for (auto& result : m_results)
+					{
+						results.push_back(std::move(*result));
+					}
+					return results;
+				}
+			}
+		};
+
+		template <typename TJob>
+		auto AwaitWorkerJob(WorkerJobRef<TJob> job) -> Task<decltype(job->takeResult())>
+		{
+			if (job->count() == 0)
+			{
+				co_return job->takeResult();
+			}
+
+			SignalSleeper sleeper;
+			job->setSleeper(&sleeper);
+			WorkerPool::Instance().submit(job.get());
+
+			// Note: Backendから直接実行されている場合、完了が通知されるまで毎フレームのresumeが省略される
+			while (!job->isCompleted())
+			{
+				co_await SleepAwaiter{ &sleeper };
+			}
+			job->setSleeper(nullptr);
+			co_return job->takeResult();
+		}
+	}
+
+	// 関数をワーカースレッドで実行し、結果を待つ
+	// (関数内ではSiv3Dの各種機能やCo名前空間内の関数を使用しないこと)
+	// (関数がconst CancellationToken&を受け取る場合、待機側のタスクが破棄されるとキャンセルが要求される)
+	template <typename TFunc>
+	[[nodiscard]]
+	auto RunOnWorker(TFunc func) -> Task<detail::WorkerFuncResult<TFunc>> requires std::invocable<TFunc> || std::invocable<TFunc, const CancellationToken&>
+	{
+		using Result = detail::WorkerFuncResult<TFunc>;
+		static_assert(!std::is_reference_v<Result>, "RunOnWorker does not support functions returning a reference");
+		using Job = detail::WorkerFuncJob<TFunc, Result>;
+		return detail::AwaitWorkerJob(detail::WorkerJobRef<Job>{ new Job{ std::move(func), detail::Backend::WorkerCompletionQueue() } });
+	}
+
+	// 0からcount-1までの添字を引数に関数をワーカースレッドで実行し、全ての完了を待つ
+	// (1回の投入にまとめるため、細かい処理を大量に実行する場合もRunOnWorkerを要素ごとに呼ぶより軽量)
+	template <typename TFunc>
+	[[nodiscard]]
+	auto RunOnWorkerBatch(std::size_t count, TFunc func) requires std::invocable<TFunc, std::size_t> || std::invocable<TFunc, std::size_t, const CancellationToken&>
+	{
+		using Result = detail::WorkerFuncResult<TFunc, std::size_t>;
+		static_assert(!std::is_reference_v<Result>, "RunOnWorkerBatch does not support functions returning a reference");
+		using Job = detail::WorkerBatchJob<TFunc, Result>;
+		return detail::AwaitWorkerJob(detail::WorkerJobRef<Job>{ new Job{ count, std::move(func), detail::Backend::WorkerCompletionQueue() } });
+	}
+
+	[[nodiscard]]
+	inline std::size_t GetWorkerThreadCount()
+	{
+		return detail::WorkerPool::Instance().threadCount();
+	}
+}
+
+#ifndef NO_COTASKLIB_USING
+using namespace cotasklib;
+#endif
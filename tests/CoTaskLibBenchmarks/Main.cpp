@@ -0,0 +1,337 @@
+﻿#include <CoTaskLib.hpp>
+#include <chrono>
+
+// ウィンドウを生成せずに実行する
+SIV3D_SET(EngineOption::Renderer::Headless)
+
+namespace
+{
+	// 計測の繰り返し回数(最初の1回はウォームアップとして集計しない)
+	constexpr int32 WarmupCount = 1;
+	constexpr int32 SampleCount = 5;
+
+	constexpr FilePathView ResultPath = U"benchmark_results.json";
+
+	struct BenchmarkResult
+	{
+		String name;
+		// JSONオブジェクトの中身として出力するパラメータ(例: "runners": 1000)
+		String params;
+		int64 operationCount;
+		Array<double> sampleNanosecs;
+	};
+
+	Array<BenchmarkResult> s_results;
+
+	using Clock = std::chrono::steady_clock;
+
+	[[nodiscard]]
+	double ElapsedNanosec(Clock::time_point begin)
+	{
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+	}
+
+	// fnSampleは1回分の計測を行い、計測区間の経過時間(ナノ秒)を返す
+	// (準備と後始末は計測区間に含めないよう、fnSample内で計測区間を決める)
+	template <typename TFunc>
+	void RunBenchmark(StringView name, StringView params, int64 operationCount, TFunc fnSample)
+	{
+		Reseed(12345);
+
+		BenchmarkResult result{ .name = String{ name }, .params = String{ params }, .operationCount = operationCount };
+		for (int32 i = 0; i < WarmupCount + SampleCount; ++i)
+		{
+			const double nanosec = fnSample();
+			if (i >= WarmupCount)
+			{
+				result.sampleNanosecs.push_back(nanosec);
+			}
+		}
+
+		Array<double> sorted = result.sampleNanosecs.sorted();
+		const double medianNanosec = sorted[sorted.size() / 2];
+		Console << U"{:<24} {:<44} {:>12.1f} ns/op"_fmt(name, params, medianNanosec / static_cast<double>(operationCount));
+
+		s_results.push_back(std::move(result));
+	}
+
+	[[nodiscard]]
+	String ResultsToJSON()
+	{
+		String json = U"{\n  \"samples\": " + Format(SampleCount) + U",\n  \"results\": [\n";
+		for (std::size_t i = 0; i < s_results.size(); ++i)
+		{
+			const BenchmarkResult& result = s_results[i];
+			const Array<double> sorted = result.sampleNanosecs.sorted();
+			const double opCount = static_cast<double>(result.operationCount);
+			json += U"    {{\"name\": \"{}\", \"params\": {{{}}}, \"operations\": {}, \"min_ns_per_op\": {:.3f}, \"median_ns_per_op\": {:.3f}, \"max_ns_per_op\": {:.3f}}}"_fmt(
+				result.name,
+				result.params,
+				result.operationCount,
+				sorted.front() / opCount,
+				sorted[sorted.size() / 2] / opCount,
+				sorted.back() / opCount);
+			json += (i + 1 < s_results.size()) ? U",\n" : U"\n";
+		}
+		json += U"  ]\n}\n";
+		return json;
+	}
+
+	Co::Task<void> EmptyTask()
+	{
+		co_return;
+	}
+
+	Co::Task<void> LoopTask()
+	{
+		while (true)
+		{
+			co_await Co::NextFrame();
+		}
+	}
+
+	Co::Task<void> NestedTask(int32 depth)
+	{
+		if (depth == 0)
+		{
+			co_await LoopTask();
+			co_return;
+		}
+		co_await NestedTask(depth - 1);
+	}
+
+	Co::Task<void> DelayFrameTask(int32 frames)
+	{
+		co_await Co::DelayFrame(frames);
+	}
+
+	// Taskの生成・実行開始・破棄
+	void BenchmarkTaskSpawn()
+	{
+		constexpr int32 Count = 100'000;
+
+		RunBenchmark(U"task_spawn_destroy", U"\"kind\": \"immediate\"", Count, [&]
+			{
+				const auto begin = Clock::now();
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const auto runner = EmptyTask().runScoped();
+				}
+				return ElapsedNanosec(begin);
+			});
+
+		RunBenchmark(U"task_spawn_destroy", U"\"kind\": \"suspended\"", Count, [&]
+			{
+				const auto begin = Clock::now();
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const auto runner = LoopTask().runScoped();
+				}
+				return ElapsedNanosec(begin);
+			});
+	}
+
+	// 実行中のランナー数ごとのBackend::update()1回あたりの時間
+	void BenchmarkBackendUpdate()
+	{
+		constexpr int32 Frames = 60;
+
+		for (const int32 runnerCount : { 1'000, 10'000, 100'000 })
+		{
+			RunBenchmark(U"backend_update", U"\"runners\": {}, \"kind\": \"active\""_fmt(runnerCount), Frames, [&]
+				{
+					Co::MultiRunner mr;
+					mr.reserve(runnerCount);
+					for (int32 i = 0; i < runnerCount; ++i)
+					{
+						LoopTask().runAddTo(mr);
+					}
+					const auto begin = Clock::now();
+					Co::FastForward(Frames);
+					return ElapsedNanosec(begin);
+				});
+
+			RunBenchmark(U"backend_update", U"\"runners\": {}, \"kind\": \"parked\""_fmt(runnerCount), Frames, [&]
+				{
+					Co::MultiRunner mr;
+					mr.reserve(runnerCount);
+					for (int32 i = 0; i < runnerCount; ++i)
+					{
+						Co::Delay(1h).runAddTo(mr);
+					}
+
+					// 休止させてから計測する
+					Co::FastForward(1);
+					const auto begin = Clock::now();
+					Co::FastForward(Frames);
+					return ElapsedNanosec(begin);
+				});
+		}
+	}
+
+	// ネストしたco_awaitの深さごとのresumeの時間
+	void BenchmarkNestedAwait()
+	{
+		constexpr int32 RunnerCount = 1'000;
+		constexpr int32 Frames = 60;
+
+		for (const int32 depth : { 1, 10, 100 })
+		{
+			RunBenchmark(U"nested_await", U"\"depth\": {}, \"runners\": {}"_fmt(depth, RunnerCount), static_cast<int64>(RunnerCount) * Frames, [&]
+				{
+					Co::MultiRunner mr;
+					mr.reserve(RunnerCount);
+					for (int32 i = 0; i < RunnerCount; ++i)
+					{
+						NestedTask(depth).runAddTo(mr);
+					}
+					const auto begin = Clock::now();
+					Co::FastForward(Frames);
+					return ElapsedNanosec(begin);
+				});
+		}
+	}
+
+	// DrawExecutorへのDrawerの追加・描画順の変更・削除
+	void BenchmarkDrawerChurn()
+	{
+		constexpr int32 Count = 10'000;
+
+		RunBenchmark(U"drawer_churn", U"\"drawers\": {}, \"op\": \"add_remove\""_fmt(Count), Count, [&]
+			{
+				Array<Co::ScopedDrawer> drawers;
+				drawers.reserve(Count);
+				const auto begin = Clock::now();
+				for (int32 i = 0; i < Count; ++i)
+				{
+					drawers.emplace_back([] {}, Co::Layer::Default, Random(-1000, 1000));
+				}
+				drawers.clear();
+				return ElapsedNanosec(begin);
+			});
+
+		RunBenchmark(U"drawer_churn", U"\"drawers\": {}, \"op\": \"reindex\""_fmt(Count), Count, [&]
+			{
+				Array<Co::ScopedDrawer> drawers;
+				drawers.reserve(Count);
+				for (int32 i = 0; i < Count; ++i)
+				{
+					drawers.emplace_back([] {}, Co::Layer::Default, i);
+				}
+				const auto begin = Clock::now();
+				for (auto& drawer : drawers)
+				{
+					drawer.setDrawIndex(Random(-1000, 1000));
+				}
+				return ElapsedNanosec(begin);
+			});
+	}
+
+	// MultiRunnerの全完了待ち
+	void BenchmarkMultiRunnerWait()
+	{
+		constexpr int32 Frames = 10;
+
+		for (const int32 runnerCount : { 100, 10'000 })
+		{
+			RunBenchmark(U"multirunner_wait_all", U"\"runners\": {}"_fmt(runnerCount), runnerCount, [&]
+				{
+					Co::MultiRunner mr;
+					mr.reserve(runnerCount);
+					for (int32 i = 0; i < runnerCount; ++i)
+					{
+						DelayFrameTask(1 + i % Frames).runAddTo(mr);
+					}
+					const auto waitRunner = mr.waitUntilAllDone().runScoped();
+					const auto begin = Clock::now();
+					while (!waitRunner.done())
+					{
+						Co::FastForward(1);
+					}
+					return ElapsedNanosec(begin);
+				});
+		}
+	}
+
+	// 値のイージングの1フレームあたりの時間(Ease・TweenBatch・Timeline・Tweener)
+	void BenchmarkEase()
+	{
+		constexpr int32 Count = 10'000;
+		constexpr int32 Frames = 60;
+		constexpr int64 Operations = static_cast<int64>(Count) * Frames;
+
+		RunBenchmark(U"ease_throughput", U"\"values\": {}, \"impl\": \"Ease\""_fmt(Count), Operations, [&]
+			{
+				Array<double> values(Count, 0.0);
+				Co::MultiRunner mr;
+				mr.reserve(Count);
+				for (auto& value : values)
+				{
+					Co::Ease(&value, 2s).fromTo(0.0, 1.0).play().runAddTo(mr);
+				}
+				const auto begin = Clock::now();
+				Co::FastForward(Frames);
+				return ElapsedNanosec(begin);
+			});
+
+		RunBenchmark(U"ease_throughput", U"\"values\": {}, \"impl\": \"TweenBatch\""_fmt(Count), Operations, [&]
+			{
+				Array<double> values(Count, 0.0);
+				Co::TweenBatch<double> batch;
+				const auto batchRunner = batch.runScoped();
+				for (auto& value : values)
+				{
+					batch.add(&value, 0.0, 1.0, 2s);
+				}
+				const auto begin = Clock::now();
+				Co::FastForward(Frames);
+				return ElapsedNanosec(begin);
+			});
+
+		RunBenchmark(U"ease_throughput", U"\"values\": {}, \"impl\": \"Timeline\""_fmt(Count), Operations, [&]
+			{
+				Array<double> values(Count, 0.0);
+				Co::Timeline timeline;
+				for (auto& value : values)
+				{
+					timeline.add(&value, 0s, 2s, 0.0, 1.0);
+				}
+				const auto timelineRunner = timeline.play().runScoped();
+				const auto begin = Clock::now();
+				Co::FastForward(Frames);
+				return ElapsedNanosec(begin);
+			});
+
+		RunBenchmark(U"tweener_throughput", U"\"tweeners\": {}"_fmt(Count), Operations, [&]
+			{
+				Array<Co::Tweener> tweeners(Count, Co::Tweener{ Vec2::Zero() });
+				Co::MultiRunner mr;
+				mr.reserve(Count);
+				for (auto& tweener : tweeners)
+				{
+					tweener.fadeInAlpha(2s).play().runAddTo(mr);
+				}
+				const auto begin = Clock::now();
+				Co::FastForward(Frames);
+				return ElapsedNanosec(begin);
+			});
+	}
+}
+
+void Main()
+{
+	Co::Init();
+
+	Console.open();
+
+	BenchmarkTaskSpawn();
+	BenchmarkBackendUpdate();
+	BenchmarkNestedAwait();
+	BenchmarkDrawerChurn();
+	BenchmarkMultiRunnerWait();
+	BenchmarkEase();
+
+	TextWriter writer{ ResultPath };
+	writer.write(ResultsToJSON());
+	Console << U"Results written to {}"_fmt(ResultPath);
+}
@@ -823,6 +823,115 @@ TEST_CASE("TaskFinishSource<int32>::waitForResult")
 	REQUIRE(taskFinishSource.done() == true);
 }
 
+TEST_CASE("TaskFinishSource<int32>::waitForResult resumes in execution order")
+{
+	Co::TaskFinishSource<int32> taskFinishSource;
+	Optional<int32> result1 = none;
+	Optional<int32> result2 = none;
+	const auto runner1 = taskFinishSource.waitForResult().runScoped([&](int32 r) { result1 = r; });
+
+	bool finishRequested = false;
+	const auto finisher = Co::UpdaterTask([&] { if (finishRequested) taskFinishSource.requestFinish(42); }).runScoped();
+	const auto runner2 = taskFinishSource.waitUntilDone().runScoped([&] { result2 = 0; });
+	System::Update();
+	REQUIRE(runner1.done() == false);
+	REQUIRE(runner2.done() == false);
+
+	// 休止中の待機も毎フレーム条件を調べる場合と同じく、完了リクエスト側より実行順が後ろの待機のみ同じフレーム内で再開される
+	finishRequested = true;
+	System::Update();
+	REQUIRE(runner1.done() == false);
+	REQUIRE(runner2.done() == true);
+	REQUIRE(result2 == 0);
+
+	// 実行順が前の待機は次のフレームで再開される
+	System::Update();
+	REQUIRE(runner1.done() == true);
+	REQUIRE(result1 == 42);
+}
+
+TEST_CASE("TaskFinishSource<std::unique_ptr<int32>>::waitForResult")
+{
+	Co::TaskFinishSource<std::unique_ptr<int32>> taskFinishSource;
+	std::unique_ptr<int32> result;
+	const auto runner = taskFinishSource.waitForResult().runScoped([&](std::unique_ptr<int32> r) { result = std::move(r); });
+	System::Update();
+	REQUIRE(runner.done() == false);
+
+	// ムーブのみ可能な型の結果も受け取れる
+	taskFinishSource.requestFinish(std::make_unique<int32>(42));
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(result != nullptr);
+	REQUIRE(*result == 42);
+	REQUIRE(taskFinishSource.done() == true);
+	REQUIRE_THROWS_AS(taskFinishSource.result(), Error);
+}
+
+TEST_CASE("TaskFinishSource<int32>::waitForResult with multiple waiters")
+{
+	Co::TaskFinishSource<int32> taskFinishSource;
+	Optional<int32> result1 = none;
+	Optional<int32> result2 = none;
+	const auto runner1 = taskFinishSource.waitForResult().runScoped([&](int32 r) { result1 = r; });
+	const auto runner2 = taskFinishSource.waitForResult().runScoped([&](int32 r) { result2 = r; });
+
+	// コピー可能な型は、待機している全てのタスクが同じ結果を受け取る
+	taskFinishSource.requestFinish(42);
+	System::Update();
+	REQUIRE(runner1.done() == true);
+	REQUIRE(runner2.done() == true);
+	REQUIRE(result1 == 42);
+	REQUIRE(result2 == 42);
+
+	// 完了後に待機を始めた場合も同じ結果を受け取る
+	Optional<int32> result3 = none;
+	const auto runner3 = taskFinishSource.waitForResult().runScoped([&](int32 r) { result3 = r; });
+	REQUIRE(runner3.done() == true);
+	REQUIRE(result3 == 42);
+}
+
+TEST_CASE("TaskFinishSource<std::unique_ptr<int32>>::waitForResult with multiple waiters")
+{
+	Co::TaskFinishSource<std::unique_ptr<int32>> taskFinishSource;
+	std::unique_ptr<int32> result1;
+	const auto runner1 = taskFinishSource.waitForResult().runScoped([&](std::unique_ptr<int32> r) { result1 = std::move(r); });
+	const auto runner2 = taskFinishSource.waitForResult().runScoped();
+
+	// ムーブのみ可能な型は最初に再開したタスクのみ受け取り、2つ目のタスクには例外が送出される
+	taskFinishSource.requestFinish(std::make_unique<int32>(42));
+	REQUIRE_THROWS_WITH(Co::detail::Backend::ManualUpdate(), "TaskFinishSource: move-only result can be get only once by waitForResult()");
+	REQUIRE(result1 != nullptr);
+	REQUIRE(*result1 == 42);
+}
+
+TEST_CASE("TaskFinishSource destroyed while waiting")
+{
+	Optional<Co::TaskFinishSource<void>> taskFinishSource{ std::in_place };
+	const auto runner = taskFinishSource->waitUntilDone().runScoped();
+	System::Update();
+
+	// 待機中に破棄されても待機側はアクセスせず、完了もしない
+	taskFinishSource.reset();
+	System::Update();
+	System::Update();
+	REQUIRE(runner.done() == false);
+}
+
+TEST_CASE("ScopedTaskRunner::waitUntilDone after forget")
+{
+	Co::ScopedTaskRunner runner = Co::WaitForever().runScoped();
+	const auto runner2 = runner.waitUntilDone().runScoped();
+	System::Update();
+	REQUIRE(runner2.done() == false);
+
+	// forgetするとdone()がtrueになるため、待機側も完了する
+	runner.forget();
+	REQUIRE(runner.done() == true);
+	System::Update();
+	REQUIRE(runner2.done() == true);
+}
+
 TEST_CASE("ScopedTaskRunner::requestCancel")
 {
 	int32 finishCallbackCount = 0;
@@ -971,6 +1080,98 @@ TEST_CASE("ScopedTaskRunner move assignment")
 	REQUIRE(runner2CancelCount == 0);
 }
 
+Co::Task<void> PushBackValueEveryFrame(std::vector<int32>* pVec, int32 value)
+{
+	while (true)
+	{
+		co_await Co::NextFrame();
+		pVec->push_back(value);
+	}
+}
+
+TEST_CASE("ScopedTaskRunner execution order after cancel")
+{
+	std::vector<int32> vec;
+
+	Co::MultiRunner mr;
+	for (int32 i = 0; i < 5; ++i)
+	{
+		PushBackValueEveryFrame(&vec, i).runAddTo(mr);
+	}
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 0, 1, 2, 3, 4 });
+
+	// 途中のタスクを削除しても、残りのタスクは登録順に実行される
+	REQUIRE(mr[1].requestCancel() == true);
+	REQUIRE(mr[3].requestCancel() == true);
+	vec.clear();
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 0, 2, 4 });
+
+	// 削除後に追加したタスクは末尾で実行される
+	const auto runner = PushBackValueEveryFrame(&vec, 5).runScoped();
+	vec.clear();
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 0, 2, 4, 5 });
+}
+
+TEST_CASE("ScopedTaskRunner::done after slot reuse")
+{
+	const auto runner1 = Co::DelayFrame(1).runScoped();
+	REQUIRE(runner1.done() == false);
+
+	System::Update();
+	REQUIRE(runner1.done() == true);
+
+	// 完了済みの実行を指すIDは、内部のスロットが別の実行に再利用されても完了扱いのまま
+	const auto runner2 = Co::DelayFrame(1).runScoped();
+	REQUIRE(runner1.done() == true);
+	REQUIRE(runner2.done() == false);
+
+	System::Update();
+	REQUIRE(runner1.done() == true);
+	REQUIRE(runner2.done() == true);
+}
+
+TEST_CASE("Cancel other task during update")
+{
+	std::vector<int32> vec;
+	Optional<Co::ScopedTaskRunner> runner2;
+
+	// 先に実行されるタスクから、後に実行されるタスクをキャンセルする
+	const auto runner1 = Co::UpdaterTask([&] { vec.push_back(1); runner2.reset(); }).runScoped();
+	runner2 = PushBackValueEveryFrame(&vec, 2).runScoped();
+	const auto runner3 = PushBackValueEveryFrame(&vec, 3).runScoped();
+	vec.clear();
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1, 3 });
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1, 3, 1, 3 });
+}
+
+TEST_CASE("Destroy own runner in finish callback during update")
+{
+	std::vector<int32> vec;
+	Optional<Co::ScopedTaskRunner> runner1;
+
+	// 完了時のコールバック内で自身のランナーを破棄しても、後に実行されるタスクはキャンセルされない
+	runner1 = Co::DelayFrame(1).runScoped([&] { vec.push_back(1); runner1.reset(); });
+	const auto runner2 = PushBackValueEveryFrame(&vec, 2).runScoped();
+	vec.clear();
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1, 2 });
+	REQUIRE(runner1.has_value() == false);
+	REQUIRE(runner2.done() == false);
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1, 2, 2 });
+	REQUIRE(runner2.done() == false);
+}
+
 TEST_CASE("MultiRunner finish")
 {
 	Co::MultiRunner mr;
@@ -1251,6 +1452,190 @@ TEST_CASE("MultiRunner::waitUntilAnyDone added while running")
 	REQUIRE(runner.done() == true);
 }
 
+TEST_CASE("MultiRunner::removeDone")
+{
+	Co::MultiRunner mr;
+	Co::DelayFrame(1).runAddTo(mr);
+	Co::DelayFrame(3).runAddTo(mr);
+	Co::DelayFrame(0).runAddTo(mr);
+	Co::DelayFrame(2).runAddTo(mr);
+
+	// 即時完了したタスクのみ取り除かれる
+	mr.removeDone();
+	REQUIRE(mr.size() == 3);
+	REQUIRE(mr.anyDone() == false);
+
+	System::Update();
+	REQUIRE(mr.anyDone() == true);
+	REQUIRE(mr.allDone() == false);
+
+	mr.removeDone();
+	REQUIRE(mr.size() == 2);
+	REQUIRE(mr.anyDone() == false);
+
+	System::Update();
+	System::Update();
+	REQUIRE(mr.allDone() == true);
+
+	mr.removeDone();
+	REQUIRE(mr.empty());
+	REQUIRE(mr.allDone() == true);
+}
+
+TEST_CASE("MultiRunner element moved out")
+{
+	Co::MultiRunner mr;
+	Co::DelayFrame(3).runAddTo(mr);
+	Co::DelayFrame(1).runAddTo(mr);
+	REQUIRE(mr.allDone() == false);
+
+	// 要素をムーブで取り出すと、残った要素は完了扱いになる
+	Co::ScopedTaskRunner runner = std::move(mr[0]);
+	REQUIRE(mr.anyDone() == true);
+	REQUIRE(mr.allDone() == false);
+
+	System::Update();
+	REQUIRE(mr.allDone() == true);
+
+	// 取り出した実行は継続しており、完了してもMultiRunnerの完了判定には影響しない
+	REQUIRE(runner.done() == false);
+	mr.clear();
+	System::Update();
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(mr.allDone() == true);
+
+	// 要素へ実行中のタスクを代入すると、未完了として扱われる
+	Co::DelayFrame(1).runAddTo(mr);
+	System::Update();
+	REQUIRE(mr.allDone() == true);
+	mr[0] = Co::DelayFrame(1).runScoped();
+	REQUIRE(mr.allDone() == false);
+	System::Update();
+	REQUIRE(mr.allDone() == true);
+}
+
+TEST_CASE("MultiRunner outlived by moved-out element")
+{
+	Optional<Co::ScopedTaskRunner> runner;
+	{
+		Co::MultiRunner mr;
+		Co::DelayFrame(1).runAddTo(mr);
+		runner.emplace(std::move(mr[0]));
+	}
+
+	// MultiRunnerの破棄後に完了しても問題ない
+	System::Update();
+	REQUIRE(runner->done() == true);
+}
+
+TEST_CASE("MultiRunner::setAutoRemoveDone")
+{
+	Co::MultiRunner mr;
+	mr.setAutoRemoveDone(true);
+	REQUIRE(mr.isAutoRemoveDoneEnabled() == true);
+
+	// 毎フレーム追加しても、完了済みの要素は追加時に取り除かれるため増え続けない
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Co::DelayFrame(2).runAddTo(mr);
+		REQUIRE(mr.size() <= 3);
+		System::Update();
+	}
+
+	// 即時完了した要素も次の追加時に取り除かれる
+	Co::DelayFrame(0).runAddTo(mr);
+	REQUIRE(mr.anyDone() == true);
+	Co::DelayFrame(5).runAddTo(mr);
+	REQUIRE(mr.size() == 2);
+	REQUIRE(mr.anyDone() == false);
+}
+
+TEST_CASE("MultiRunner::setAutoRemoveDone without add")
+{
+	Co::MultiRunner mr;
+	mr.setAutoRemoveDone(true);
+	Co::DelayFrame(1).runAddTo(mr);
+	Co::DelayFrame(2).runAddTo(mr);
+	Co::WaitForever().runAddTo(mr);
+
+	// 追加しなくても、要素が完了したupdateの終了時に取り除かれる
+	System::Update();
+	REQUIRE(mr.size() == 2);
+	System::Update();
+	REQUIRE(mr.size() == 1);
+	REQUIRE(mr.anyDone() == false);
+
+	mr.requestCancelAll();
+	System::Update();
+	REQUIRE(mr.empty());
+}
+
+TEST_CASE("MultiRunner elements swapped through operator[]")
+{
+	Co::MultiRunner mr;
+	Co::DelayFrame(1).runAddTo(mr);
+	Co::WaitForever().runAddTo(mr);
+	Co::DelayFrame(2).runAddTo(mr);
+
+	// 要素を入れ替えても、完了判定と完了済みの要素の削除は入れ替え後の位置で行われる
+	std::swap(mr[0], mr[1]);
+	System::Update();
+	REQUIRE(mr.anyDone() == true);
+	mr.removeDone();
+	REQUIRE(mr.size() == 2);
+	REQUIRE(std::as_const(mr)[0].done() == false);
+	REQUIRE(std::as_const(mr)[1].done() == false);
+
+	System::Update();
+	mr.removeDone();
+	REQUIRE(mr.size() == 1);
+	REQUIRE(mr.allDone() == false);
+
+	mr.requestCancelAll();
+	REQUIRE(mr.allDone() == true);
+}
+
+TEST_CASE("MultiRunner with runners of destroyed Executor")
+{
+	Co::MultiRunner mr;
+	Optional<Co::Executor> executor{ InPlace };
+	{
+		const auto binding = executor->bind();
+		Co::WaitForever().runAddTo(mr);
+	}
+	Co::DelayFrame(1).runAddTo(mr);
+	REQUIRE(mr.allDone() == false);
+
+	// Executorの破棄によりタスクが破棄された場合も、完了として扱われる
+	executor.reset();
+	REQUIRE(std::as_const(mr)[0].done() == true);
+	REQUIRE(mr.anyDone() == true);
+	REQUIRE(mr.allDone() == false);
+
+	System::Update();
+	REQUIRE(mr.allDone() == true);
+	mr.removeDone();
+	REQUIRE(mr.empty());
+}
+
+TEST_CASE("MultiRunner::waitUntilAllDone after requestCancelAll")
+{
+	Co::MultiRunner mr;
+	Co::WaitForever().runAddTo(mr);
+	Co::WaitForever().runAddTo(mr);
+
+	const auto runner = mr.waitUntilAllDone().runScoped();
+	System::Update();
+	REQUIRE(runner.done() == false);
+
+	// キャンセルも完了として通知される
+	mr.requestCancelAll();
+	REQUIRE(mr.allDone() == true);
+	System::Update();
+	REQUIRE(runner.done() == true);
+}
+
 Co::Task<void> WaitForeverTest(int32* pValue)
 {
 	*pValue = 1;
@@ -1981,21 +2366,137 @@ TEST_CASE("Co::Any with non-copyable result")
 	REQUIRE(runner.done() == true);
 }
 
-TEST_CASE("UpdaterTask without TaskFinishSource argument")
+Co::Task<int32> GetValueWithDelayFrame(int32 value, int32 frames)
 {
-	int32 count = 0;
-	auto task = Co::UpdaterTask([&] { ++count; });
+	co_await Co::DelayFrame(frames);
+	co_return value;
+}
 
-	// タスク生成時点ではまだ実行されない
-	REQUIRE(count == 0);
+TEST_CASE("Co::AllOf")
+{
+	TestClock clock;
+	Array<Co::Task<int32>> tasks;
+	for (int32 i = 0; i < 5; ++i)
+	{
+		tasks.push_back(GetValueWithDelay(i * 10, Duration{ 5 - i }, &clock));
+	}
 
-	// runScopedで開始すると最初のsuspendまで実行される
-	const auto runner = std::move(task).runScoped();
-	REQUIRE(count == 1);
-	REQUIRE(runner.done() == false);
-	
-	System::Update();
-	REQUIRE(count == 2);
+	Optional<Array<int32>> result;
+	const auto runner = Co::AllOf(std::move(tasks)).runScoped([&](Array<int32>&& r) { result = std::move(r); });
+	REQUIRE(runner.done() == false);
+
+	for (int32 i = 1; i <= 4; ++i)
+	{
+		clock.microsec = i * 1'000'000;
+		System::Update();
+		REQUIRE(runner.done() == false);
+	}
+
+	// 完了順によらず、渡した順番で結果が返される
+	clock.microsec = 5'000'000;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == Array<int32>{ 0, 10, 20, 30, 40 });
+}
+
+TEST_CASE("Co::AllOf empty and void")
+{
+	Optional<Array<int32>> result;
+	const auto runner = Co::AllOf(Array<Co::Task<int32>>{}).runScoped([&](Array<int32>&& r) { result = std::move(r); });
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == Array<int32>{});
+
+	Array<Co::Task<void>> tasks;
+	tasks.push_back(Co::DelayFrame(1));
+	tasks.push_back(Co::DelayFrame(2));
+	tasks.push_back(Co::DelayFrame(0));
+	const auto runner2 = Co::AllOf(std::move(tasks)).runScoped();
+	REQUIRE(runner2.done() == false);
+	System::Update();
+	REQUIRE(runner2.done() == false);
+	System::Update();
+	REQUIRE(runner2.done() == true);
+}
+
+TEST_CASE("Co::AllOf execution order")
+{
+	std::vector<int32> vec;
+
+	Array<Co::Task<void>> tasks;
+	tasks.push_back(PushBackValueWithDelayFrame(&vec, 1));
+	tasks.push_back(PushBackValueWithDelayFrame(&vec, 2));
+	tasks.push_back(PushBackValueWithDelayFrame(&vec, 3));
+	const auto runner = Co::AllOf(std::move(tasks)).runScoped();
+
+	// 渡した順番でresumeされる
+	REQUIRE(vec == std::vector<int32>{ 1, 2, 3 });
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1, 2, 3, 10, 20, 30 });
+	REQUIRE(runner.done() == true);
+}
+
+TEST_CASE("Co::AnyOf")
+{
+	Array<Co::Task<int32>> tasks;
+	tasks.push_back(GetValueWithDelayFrame(10, 3));
+	tasks.push_back(GetValueWithDelayFrame(20, 2));
+	tasks.push_back(GetValueWithDelayFrame(30, 2));
+
+	Optional<std::pair<std::size_t, int32>> result;
+	const auto runner = Co::AnyOf(std::move(tasks)).runScoped([&](std::pair<std::size_t, int32>&& r) { result = r; });
+	System::Update();
+	REQUIRE(runner.done() == false);
+
+	// 同じフレームで完了した場合はインデックスが小さいものが返される
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == std::pair<std::size_t, int32>{ 1, 20 });
+}
+
+TEST_CASE("Co::AnyOf with non-copyable result")
+{
+	Array<Co::Task<std::unique_ptr<int32>>> tasks;
+	tasks.push_back(CoReturnWithMoveOnlyTypeAndDelayTest());
+
+	std::unique_ptr<int32> result;
+	const auto runner = Co::AnyOf(std::move(tasks)).runScoped([&](std::pair<std::size_t, std::unique_ptr<int32>>&& r) { result = std::move(r.second); });
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(result != nullptr);
+	REQUIRE(*result == 42);
+}
+
+TEST_CASE("Co::AnyOf void and empty")
+{
+	Array<Co::Task<void>> tasks;
+	tasks.push_back(Co::DelayFrame(2));
+	tasks.push_back(Co::DelayFrame(1));
+
+	Optional<std::size_t> result;
+	const auto runner = Co::AnyOf(std::move(tasks)).runScoped([&](std::size_t r) { result = r; });
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == 1u);
+
+	// 空の配列は例外を投げる
+	REQUIRE_THROWS_AS(Co::AnyOf(Array<Co::Task<void>>{}).runScoped(), Error);
+}
+
+TEST_CASE("UpdaterTask without TaskFinishSource argument")
+{
+	int32 count = 0;
+	auto task = Co::UpdaterTask([&] { ++count; });
+
+	// タスク生成時点ではまだ実行されない
+	REQUIRE(count == 0);
+
+	// runScopedで開始すると最初のsuspendまで実行される
+	const auto runner = std::move(task).runScoped();
+	REQUIRE(count == 1);
+	REQUIRE(runner.done() == false);
+	
+	System::Update();
+	REQUIRE(count == 2);
 	REQUIRE(runner.done() == false);
 
 	System::Update();
@@ -2869,6 +3370,114 @@ TEST_CASE("UpdaterScene")
 	REQUIRE(runner.done() == true);
 }
 
+class PreloadLogScene : public Co::SceneBase
+{
+private:
+	Array<String>* m_pLog;
+
+	Co::Task<void> preload() override
+	{
+		m_pLog->push_back(U"next.preload.begin");
+		co_await Co::DelayFrame(2);
+		m_pLog->push_back(U"next.preload.end");
+	}
+
+	Co::Task<void> preStart() override
+	{
+		m_pLog->push_back(U"next.preStart");
+		co_return;
+	}
+
+	Co::Task<void> start() override
+	{
+		requestSceneFinish();
+		co_return;
+	}
+
+public:
+	explicit PreloadLogScene(Array<String>* pLog)
+		: m_pLog(pLog)
+	{
+		m_pLog->push_back(U"next.construct");
+	}
+};
+
+class PreloadRequestScene : public Co::SceneBase
+{
+private:
+	Array<String>* m_pLog;
+
+	Co::Task<void> start() override
+	{
+		requestNextScenePreloaded<PreloadLogScene>(m_pLog);
+		co_return;
+	}
+
+	Co::Task<void> fadeOut() override
+	{
+		m_pLog->push_back(U"current.fadeOut.begin");
+		co_await Co::NextFrame();
+		m_pLog->push_back(U"current.fadeOut.end");
+	}
+
+public:
+	explicit PreloadRequestScene(Array<String>* pLog)
+		: m_pLog(pLog)
+	{
+	}
+
+	~PreloadRequestScene()
+	{
+		m_pLog->push_back(U"current.destruct");
+	}
+};
+
+TEST_CASE("requestNextScenePreloaded overlaps preload with fadeOut")
+{
+	Array<String> log;
+	const auto runner = Co::PlaySceneFrom<PreloadRequestScene>(&log).runScoped();
+	while (!runner.done())
+	{
+		System::Update();
+	}
+
+	// 次のシーンはfadeOut開始時に生成され、前のシーンの破棄前にpreloadが完了する
+	REQUIRE(log == Array<String>{
+		U"next.construct",
+		U"next.preload.begin",
+		U"current.fadeOut.begin",
+		U"current.fadeOut.end",
+		U"next.preload.end",
+		U"current.destruct",
+		U"next.preStart",
+	});
+}
+
+TEST_CASE("requestNextScenePreloaded without overlap")
+{
+	Co::SetOverlappedScenePreloadAllowed(false);
+
+	Array<String> log;
+	const auto runner = Co::PlaySceneFrom<PreloadRequestScene>(&log).runScoped();
+	while (!runner.done())
+	{
+		System::Update();
+	}
+
+	Co::SetOverlappedScenePreloadAllowed(true);
+
+	// 前のシーンを破棄してから次のシーンを生成する
+	REQUIRE(log == Array<String>{
+		U"current.fadeOut.begin",
+		U"current.fadeOut.end",
+		U"current.destruct",
+		U"next.construct",
+		U"next.preload.begin",
+		U"next.preload.end",
+		U"next.preStart",
+	});
+}
+
 TEST_CASE("Co::Ease")
 {
 	TestClock clock;
@@ -3021,325 +3630,2873 @@ TEST_CASE("Co::Ease::setEase")
 	REQUIRE(value == 100.0);
 }
 
-TEST_CASE("Co::LinearEase")
+TEST_CASE("Co::TweenBatch")
 {
 	TestClock clock;
+	Co::TweenBatch<double> batch{ &clock };
+	const auto batchRunner = batch.runScoped();
 
-	double value = -1.0;
-	auto easeTask = Co::LinearEase(&value, 1s)
-		.setClock(&clock)
-		.from(0.0)
-		.to(100.0)
-		.play();
-
-	// Task生成時点ではまだ実行されない
-	REQUIRE(easeTask.done() == false);
-	REQUIRE(value == -1.0);
-
-	const auto runner = std::move(easeTask).runScoped();
+	double value1 = -1.0;
+	double value2 = -1.0;
+	const Co::TweenID id1 = batch.add(&value1, 0.0, 100.0, 1s);
+	const Co::TweenID id2 = batch.add(&value2, 100.0, 200.0, 2s, Easing::Linear);
 
-	// runScopedで開始すると初期値が代入される
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == 0.0);
+	// 追加時点で初期値が代入される
+	REQUIRE(value1 == 0.0);
+	REQUIRE(value2 == 100.0);
+	REQUIRE(batch.size() == 2);
 
 	// 0秒
 	clock.microsec = 0;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == 0.0);
+	REQUIRE(value1 == 0.0);
+	REQUIRE(value2 == 100.0);
 
 	// 0.5秒
 	clock.microsec = 500'000;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == Approx(50.0));
-
-	// 0.999秒
-	clock.microsec = 999'000;
-	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == Approx(99.9));
+	REQUIRE(value1 == Approx(EaseOutQuad(0.5) * 100.0));
+	REQUIRE(value2 == Approx(125.0));
+	REQUIRE(batch.isDone(id1) == false);
 
 	// 1.001秒
 	clock.microsec = 1'001'000;
 	System::Update();
-	REQUIRE(runner.done() == true);
-	REQUIRE(value == 100.0);
+	REQUIRE(value1 == 100.0);
+	REQUIRE(batch.isDone(id1) == true);
+	REQUIRE(batch.isDone(id2) == false);
+	REQUIRE(batch.size() == 1);
+
+	// 2.001秒
+	clock.microsec = 2'001'000;
+	System::Update();
+	REQUIRE(value2 == 200.0);
+	REQUIRE(batch.isDone(id2) == true);
+	REQUIRE(batch.allDone() == true);
+	REQUIRE(batchRunner.done() == false);
 }
 
-TEST_CASE("Co::LinearEase with zero duration")
+TEST_CASE("Co::TweenBatch with zero duration")
 {
+	Co::TweenBatch<double> batch;
+
 	double value = -1.0;
-	const auto runner = Co::LinearEase(&value, 0s)
-		.from(0.0)
-		.to(100.0)
-		.play()
-		.runScoped();
+	const Co::TweenID id = batch.add(&value, 0.0, 100.0, 0s);
 
-	// 即座に終了
-	REQUIRE(runner.done() == true);
+	// 即座に目標値が代入され、登録されない
 	REQUIRE(value == 100.0);
+	REQUIRE(batch.isDone(id) == true);
+	REQUIRE(batch.allDone() == true);
 }
 
-TEST_CASE("Co::LinearEase and Co::Delay ends at the same time")
+TEST_CASE("Co::TweenBatch wait and cancel")
 {
 	TestClock clock;
+	Co::TweenBatch<double> batch{ &clock };
+	const auto batchRunner = batch.runScoped();
 
-	double value = -1.0;
-	auto easeTask = Co::LinearEase(&value, 1s).fromTo(0.0, 1.0).setClock(&clock).play();
-
-	Optional<Co::VoidResult> easeResult;
-	Optional<Co::VoidResult> delayResult;
-
-	const auto runner = Co::Any(
-		std::move(easeTask),
-		Co::Delay(1s, &clock)).runScoped([&](const auto& result) { std::tie(easeResult, delayResult) = result; });
+	double value1 = 0.0;
+	double value2 = 0.0;
+	double value3 = 0.0;
+	const Co::TweenID id1 = batch.add(&value1, 0.0, 1.0, 1s, EaseOutQuad, 1);
+	batch.add(&value2, 0.0, 1.0, 2s, EaseOutQuad, 1);
+	const Co::TweenID id3 = batch.add(&value3, 0.0, 1.0, 3s, EaseOutQuad, 2);
 
-	REQUIRE(runner.done() == false);
-	REQUIRE((bool)easeResult == false);
-	REQUIRE((bool)delayResult == false);
+	const auto waitRunner1 = batch.waitUntilDone(id1).runScoped();
+	const auto waitGroupRunner1 = batch.waitUntilGroupDone(1).runScoped();
+	const auto waitGroupRunner2 = batch.waitUntilGroupDone(2).runScoped();
+	const auto waitAllRunner = batch.waitUntilAllDone().runScoped();
 
-	// 0秒
-	clock.microsec = 0;
+	clock.microsec = 900'000;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE((bool)easeResult == false);
-	REQUIRE((bool)delayResult == false);
-
-	// 0.5秒
-	clock.microsec = 500'000;
+	REQUIRE(waitRunner1.done() == false);
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE((bool)easeResult == false);
-	REQUIRE((bool)delayResult == false);
+	REQUIRE(waitRunner1.done() == false);
 
-	// 0.999秒
-	clock.microsec = 999'000;
+	clock.microsec = 1'600'000;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE((bool)easeResult == false);
-	REQUIRE((bool)delayResult == false);
+	REQUIRE(waitRunner1.done() == true);
+	REQUIRE(waitGroupRunner1.done() == false);
+	REQUIRE(batch.isGroupDone(1) == false);
 
-	// 1.001秒
-	clock.microsec = 1'001'000;
+	// キャンセルした場合は値が書き込まれないが、完了として扱われる
+	const double value3BeforeCancel = value3;
+	REQUIRE(batch.cancel(id3) == true);
+	REQUIRE(batch.cancel(id3) == false);
+	REQUIRE(batch.isGroupDone(2) == true);
+	clock.microsec = 3'100'000;
 	System::Update();
-	REQUIRE(runner.done() == true);
-	REQUIRE((bool)easeResult == true);
-	REQUIRE((bool)delayResult == true);
-	REQUIRE(value == 1.0);
+	REQUIRE(value3 == value3BeforeCancel);
+	REQUIRE(waitGroupRunner2.done() == true);
+
+	REQUIRE(value2 == 1.0);
+	REQUIRE(waitGroupRunner1.done() == true);
+	REQUIRE(waitAllRunner.done() == true);
 }
 
-TEST_CASE("Co::Typewriter")
+TEST_CASE("Co::TweenBatch wakes only affected waiters")
 {
 	TestClock clock;
+	Co::TweenBatch<double> batch{ &clock };
+	const auto batchRunner = batch.runScoped();
 
-	String value;
-	auto typewriterTask = Co::Typewriter(&value, 0.25s, U"TEST") // ここで指定するのは1文字あたりの時間
-		.setClock(&clock)
-		.play();
-
-	// Task生成時点ではまだ実行されない
-	REQUIRE(typewriterTask.done() == false);
-	REQUIRE(value.isEmpty());
+	double value1 = 0.0;
+	double value2 = 0.0;
+	batch.add(&value1, 0.0, 1.0, 1s, EaseOutQuad, 1);
+	const Co::TweenID id2 = batch.add(&value2, 0.0, 1.0, 2s, EaseOutQuad, 2);
 
-	const auto runner = std::move(typewriterTask).runScoped();
+	Array<Co::ScopedTaskRunner> waitRunners;
+	for (int32 i = 0; i < 10; ++i)
+	{
+		waitRunners.push_back(batch.waitUntilDone(id2).runScoped());
+		waitRunners.push_back(batch.waitUntilGroupDone(2).runScoped());
+		waitRunners.push_back(batch.waitUntilAllDone().runScoped());
+	}
+	clock.microsec = 500'000;
+	System::Update();
 
-	// runScopedで開始すると初期値が代入される
-	// 1文字目は最初から表示される仕様にしている
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"T");
+	// 別の要素・グループが完了しても、待機は起床しない
+	Co::ResetTaskPriorityStats();
+	clock.microsec = 1'100'000;
+	System::Update();
+	REQUIRE(batch.isGroupDone(1) == true);
+	REQUIRE(Co::GetTaskPriorityStats(Co::TaskPriority::Normal).resumeCount == 1);
+	REQUIRE(waitRunners.all([](const Co::ScopedTaskRunner& runner) { return !runner.done(); }));
 
-	// 0秒
-	clock.microsec = 0;
+	clock.microsec = 2'100'000;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"T");
+	REQUIRE(waitRunners.all([](const Co::ScopedTaskRunner& runner) { return runner.done(); }));
+}
 
-	// 0.2501秒
-	clock.microsec = 250'100;
+TEST_CASE("Co::Timeline")
+{
+	TestClock clock;
+	Co::Timeline timeline{ &clock };
+
+	double value1 = -1.0;
+	double value2 = -1.0;
+	timeline
+		.add(&value1, 0s, 1s, 0.0, 100.0, Easing::Linear)
+		.addKeyframes(&value2, { { 0.5s, 0.0 }, { 1.5s, 10.0 }, { 2.0s, 20.0 } }, Easing::Linear);
+	REQUIRE(timeline.size() == 3);
+	REQUIRE(timeline.length() == 2.0s);
+
+	// 再生開始時点で値が代入される(開始前の区間の対象には開始値が代入される)
+	const auto runner = timeline.play().runScoped();
+	REQUIRE(value1 == 0.0);
+	REQUIRE(value2 == 0.0);
+	REQUIRE(timeline.isPlaying() == true);
+
+	// 0.5秒
+	clock.microsec = 500'000;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"TE");
+	REQUIRE(value1 == Approx(50.0));
+	REQUIRE(value2 == Approx(0.0));
+	REQUIRE(timeline.activeCount() == 2);
 
-	// 0.5001秒
-	clock.microsec = 500'100;
+	// 1秒
+	clock.microsec = 1'000'000;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"TES");
+	REQUIRE(value1 == 100.0);
+	REQUIRE(value2 == Approx(5.0));
+	REQUIRE(timeline.activeCount() == 1);
 
-	// 0.7501秒
-	// 最後の文字が見える時間を設ける必要があるため、この時点で最後の文字まで表示される仕様にしている
-	clock.microsec = 750'100;
+	// 1.75秒
+	clock.microsec = 1'750'000;
 	System::Update();
-	REQUIRE(runner.done() == false); // タスク自体はまだ終了していない
-	REQUIRE(value == U"TEST");
+	REQUIRE(value2 == Approx(15.0));
+	REQUIRE(timeline.activeCount() == 1);
 
-	// 1.0001秒
-	clock.microsec = 1'000'100;
+	// 2.1秒
+	clock.microsec = 2'100'000;
 	System::Update();
+	REQUIRE(value2 == 20.0);
+	REQUIRE(timeline.activeCount() == 0);
 	REQUIRE(runner.done() == true);
-	REQUIRE(value == U"TEST");
+	REQUIRE(timeline.isPlaying() == false);
+	REQUIRE(timeline.position() == 2.0s);
 }
 
-TEST_CASE("Co::Typewriter with zero duration")
+TEST_CASE("Co::Timeline seek")
 {
-	String value;
-	const auto runner = Co::Typewriter(&value, 0s, U"TEST").playScoped();
+	TestClock clock;
+	Co::Timeline timeline{ &clock };
+
+	double value = -1.0;
+	timeline.addKeyframes(&value, { { 0s, 0.0 }, { 1s, 100.0 }, { 2s, 0.0 } }, Easing::Linear);
+
+	// 再生していない状態でも、seekした時刻の値が代入される
+	timeline.seek(1.5s);
+	REQUIRE(value == Approx(50.0));
+	REQUIRE(timeline.position() == 1.5s);
+	timeline.seek(0.5s);
+	REQUIRE(value == Approx(50.0));
+	timeline.seek(10s);
+	REQUIRE(value == 0.0);
+	REQUIRE(timeline.position() == 2s);
+
+	// 再生中にseekした場合は移動先から再生を続ける
+	timeline.seek(0s);
+	const auto runner = timeline.play().runScoped();
+	clock.microsec = 250'000;
+	System::Update();
+	REQUIRE(value == Approx(25.0));
+
+	timeline.seek(1.5s);
+	REQUIRE(value == Approx(50.0));
+	clock.microsec = 500'000;
+	System::Update();
+	REQUIRE(value == Approx(50.0));
+
+	clock.microsec = 750'000;
+	System::Update();
+	REQUIRE(value == Approx(25.0));
+	REQUIRE(runner.done() == false);
+
+	clock.microsec = 1'000'000;
+	System::Update();
+	REQUIRE(value == 0.0);
+	REQUIRE(runner.done() == true);
+
+	// 同時に複数のplay()は実行できない
+	timeline.seek(0s);
+	const auto runner2 = timeline.play().runScoped();
+	REQUIRE_THROWS_AS(timeline.play().runScoped(), Error);
+}
+
+TEST_CASE("Co::Timeline overlapping segments")
+{
+	TestClock clock;
+	Co::Timeline timeline{ &clock };
+
+	// 同じ値に対して重なる区間を登録した場合、開始時刻が後の区間の値が優先される
+	double value = -1.0;
+	timeline
+		.add(&value, 0s, 4s, 0.0, 100.0, Easing::Linear)
+		.add(&value, 1s, 2s, 0.0, 10.0, Easing::Linear);
+
+	// seekで重なりの中・後の区間の終了後に移動した場合
+	timeline.seek(0.5s);
+	REQUIRE(value == Approx(12.5));
+	timeline.seek(1.5s);
+	REQUIRE(value == Approx(5.0));
+	timeline.seek(3s);
+	REQUIRE(value == 10.0);
+
+	// 再生した場合もseekと同じ値になる
+	timeline.seek(0s);
+	const auto runner = timeline.play().runScoped();
+	REQUIRE(value == 0.0);
+
+	clock.microsec = 500'000;
+	System::Update();
+	REQUIRE(value == Approx(12.5));
+
+	clock.microsec = 1'500'000;
+	System::Update();
+	REQUIRE(value == Approx(5.0));
+	REQUIRE(timeline.activeCount() == 1);
+
+	clock.microsec = 3'000'000;
+	System::Update();
+	REQUIRE(value == 10.0);
+	REQUIRE(timeline.activeCount() == 0);
+
+	clock.microsec = 4'000'000;
+	System::Update();
+	REQUIRE(value == 10.0);
+	REQUIRE(runner.done() == true);
+}
+
+TEST_CASE("Co::Timeline with Tweener")
+{
+	Co::Tweener tweener;
+	Co::Timeline timeline;
+	timeline
+		.addAlpha(tweener, 0s, 1s, 0.0, 1.0)
+		.addPosition(tweener, 1s, 2s, Vec2{ 0, 0 }, Vec2{ 10, 20 });
+
+	timeline.seek(2s);
+	REQUIRE(tweener.alpha() == 1.0);
+	REQUIRE(tweener.position() == Vec2{ 10, 20 });
+
+	timeline.seek(0s);
+	REQUIRE(tweener.alpha() == 0.0);
+	REQUIRE(tweener.position() == Vec2{ 0, 0 });
+}
+
+TEST_CASE("Co::TweenBatch added from task before batch update")
+{
+	TestClock clock;
+	Co::TweenBatch<double> batch{ &clock };
+
+	double value1 = 0.0;
+	double value2 = 0.0;
+	bool addRequested = false;
+
+	// バッチの更新より実行順が前のタスクから追加する
+	const auto adder = Co::UpdaterTask([&]
+		{
+			if (addRequested)
+			{
+				addRequested = false;
+				batch.add(&value2, 0.0, 100.0, 1s, Easing::Linear);
+			}
+		}).runScoped();
+	const auto batchRunner = batch.runScoped();
+
+	batch.add(&value1, 0.0, 100.0, 1s, Easing::Linear);
+	clock.microsec = 500'000;
+	System::Update();
+	REQUIRE(value1 == Approx(50.0));
+
+	// 追加されたフレームの経過時間は加算されない
+	addRequested = true;
+	clock.microsec = 600'000;
+	System::Update();
+	REQUIRE(value1 == Approx(60.0));
+	REQUIRE(value2 == 0.0);
+
+	clock.microsec = 900'000;
+	System::Update();
+	REQUIRE(value1 == Approx(90.0));
+	REQUIRE(value2 == Approx(30.0));
+}
+
+TEST_CASE("Co::TweenBatch with many tweens")
+{
+	TestClock clock;
+	Co::TweenBatch<Vec2> batch{ &clock };
+	const auto batchRunner = batch.runScoped();
+
+	Array<Vec2> positions(1000, Vec2::Zero());
+	for (std::size_t i = 0; i < positions.size(); ++i)
+	{
+		batch.add(&positions[i], Vec2::Zero(), Vec2{ static_cast<double>(i), 1.0 }, SecondsF{ 0.5 + 0.001 * static_cast<double>(i) });
+	}
+	REQUIRE(batch.size() == 1000);
+
+	clock.microsec = 750'500;
+	System::Update();
+	REQUIRE(batch.size() == 749);
+	REQUIRE(positions[0] == Vec2{ 0.0, 1.0 });
+
+	clock.microsec = 1'500'000;
+	System::Update();
+	REQUIRE(batch.allDone() == true);
+	for (std::size_t i = 0; i < positions.size(); ++i)
+	{
+		REQUIRE(positions[i] == Vec2{ static_cast<double>(i), 1.0 });
+	}
+}
+
+TEST_CASE("Co::TweenBatch cancel many tweens")
+{
+	TestClock clock;
+	Co::TweenBatch<double> batch{ &clock };
+	const auto batchRunner = batch.runScoped();
+
+	Array<double> values(1000, -1.0);
+	Array<Co::TweenID> ids;
+	for (auto& value : values)
+	{
+		ids.push_back(batch.add(&value, 0.0, 1.0, 1s, Easing::Linear));
+	}
+
+	// 偶数番目をキャンセルする(詰める処理はまとめて行われるが、件数と完了状態は即座に反映される)
+	for (std::size_t i = 0; i < ids.size(); i += 2)
+	{
+		REQUIRE(batch.cancel(ids[i]) == true);
+		REQUIRE(batch.isDone(ids[i]) == true);
+	}
+	REQUIRE(batch.size() == 500);
+	REQUIRE(batch.cancel(ids[0]) == false);
+
+	clock.microsec = 500'000;
+	System::Update();
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		// キャンセルした値は書き込まれない
+		if (i % 2 == 0)
+		{
+			REQUIRE(values[i] == 0.0);
+		}
+		else
+		{
+			REQUIRE(values[i] == Approx(0.5));
+		}
+	}
+
+	// 残りを全てキャンセルすると完了となる
+	for (std::size_t i = 1; i < ids.size(); i += 2)
+	{
+		batch.cancel(ids[i]);
+	}
+	REQUIRE(batch.allDone() == true);
+	REQUIRE(batch.size() == 0);
+
+	// キャンセル後に追加したものは通常どおり進む
+	double value = -1.0;
+	const Co::TweenID id = batch.add(&value, 0.0, 1.0, 1s, Easing::Linear);
+	REQUIRE(batch.size() == 1);
+	clock.microsec = 1'000'000;
+	System::Update();
+	clock.microsec = 2'001'000;
+	System::Update();
+	REQUIRE(value == 1.0);
+	REQUIRE(batch.isDone(id) == true);
+}
+
+TEST_CASE("Co::Ease with compile-time ease function")
+{
+	TestClock clock;
+
+	double value = -1.0;
+	auto builder = Co::Ease<EaseInBounce>(&value, 1s, &clock).fromTo(0.0, 100.0);
+	static_assert(std::is_same_v<decltype(builder), Co::EaseTaskBuilder<double, Co::detail::StaticEase<EaseInBounce>>>);
+
+	const auto runner = builder.playScoped();
+	REQUIRE(value == 0.0);
+
+	clock.microsec = 250'000;
+	System::Update();
+	REQUIRE(value == Approx(EaseInBounce(0.25) * 100.0));
+
+	clock.microsec = 1'001'000;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == 100.0);
+}
+
+TEST_CASE("Co::LUTEase")
+{
+	// 両端は元のイージング関数の値と一致する
+	REQUIRE(Co::LUTEase<EaseOutElastic>(0.0) == EaseOutElastic(0.0));
+	REQUIRE(Co::LUTEase<EaseOutElastic>(1.0) == EaseOutElastic(1.0));
+	REQUIRE(Co::LUTEase<EaseOutElastic>(-0.5) == EaseOutElastic(0.0));
+	REQUIRE(Co::LUTEase<EaseOutElastic>(1.5) == EaseOutElastic(1.0));
+
+	// サンプル点の間は線形補間で近似される
+	for (int32 i = 0; i <= 1000; ++i)
+	{
+		const double t = i / 1000.0;
+		REQUIRE(Co::LUTEase<EaseOutElastic, 1024>(t) == Approx(EaseOutElastic(t)).margin(1e-3));
+		REQUIRE(Co::LUTEase<EaseInBounce, 1024>(t) == Approx(EaseInBounce(t)).margin(1e-3));
+	}
+
+	// 通常のイージング関数と同様に指定できる
+	TestClock clock;
+	double value = 0.0;
+	const auto runner = Co::Ease(&value, 1s).fromTo(0.0, 100.0).setEase(Co::LUTEase<EaseOutElastic>).setClock(&clock).playScoped();
+	clock.microsec = 300'000;
+	System::Update();
+	REQUIRE(value == Approx(Co::LUTEase<EaseOutElastic>(0.3) * 100.0));
+	clock.microsec = 1'000'000;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == 100.0);
+
+	Co::TweenBatch<double> batch{ &clock };
+	const auto batchRunner = batch.runScoped();
+	double batchValue = 0.0;
+	batch.add(&batchValue, 0.0, 100.0, 1s, Co::LUTEase<EaseOutElastic>);
+	clock.microsec = 1'500'000;
+	System::Update();
+	REQUIRE(batchValue == Approx(Co::LUTEase<EaseOutElastic>(0.5) * 100.0));
+}
+
+TEST_CASE("Co::LinearEase")
+{
+	TestClock clock;
+
+	double value = -1.0;
+	auto easeTask = Co::LinearEase(&value, 1s)
+		.setClock(&clock)
+		.from(0.0)
+		.to(100.0)
+		.play();
+
+	// Task生成時点ではまだ実行されない
+	REQUIRE(easeTask.done() == false);
+	REQUIRE(value == -1.0);
+
+	const auto runner = std::move(easeTask).runScoped();
+
+	// runScopedで開始すると初期値が代入される
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == 0.0);
+
+	// 0秒
+	clock.microsec = 0;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == 0.0);
+
+	// 0.5秒
+	clock.microsec = 500'000;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == Approx(50.0));
+
+	// 0.999秒
+	clock.microsec = 999'000;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == Approx(99.9));
+
+	// 1.001秒
+	clock.microsec = 1'001'000;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == 100.0);
+}
+
+TEST_CASE("Co::LinearEase with zero duration")
+{
+	double value = -1.0;
+	const auto runner = Co::LinearEase(&value, 0s)
+		.from(0.0)
+		.to(100.0)
+		.play()
+		.runScoped();
+
+	// 即座に終了
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == 100.0);
+}
+
+TEST_CASE("Co::LinearEase and Co::Delay ends at the same time")
+{
+	TestClock clock;
+
+	double value = -1.0;
+	auto easeTask = Co::LinearEase(&value, 1s).fromTo(0.0, 1.0).setClock(&clock).play();
+
+	Optional<Co::VoidResult> easeResult;
+	Optional<Co::VoidResult> delayResult;
+
+	const auto runner = Co::Any(
+		std::move(easeTask),
+		Co::Delay(1s, &clock)).runScoped([&](const auto& result) { std::tie(easeResult, delayResult) = result; });
+
+	REQUIRE(runner.done() == false);
+	REQUIRE((bool)easeResult == false);
+	REQUIRE((bool)delayResult == false);
+
+	// 0秒
+	clock.microsec = 0;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE((bool)easeResult == false);
+	REQUIRE((bool)delayResult == false);
+
+	// 0.5秒
+	clock.microsec = 500'000;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE((bool)easeResult == false);
+	REQUIRE((bool)delayResult == false);
+
+	// 0.999秒
+	clock.microsec = 999'000;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE((bool)easeResult == false);
+	REQUIRE((bool)delayResult == false);
+
+	// 1.001秒
+	clock.microsec = 1'001'000;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE((bool)easeResult == true);
+	REQUIRE((bool)delayResult == true);
+	REQUIRE(value == 1.0);
+}
+
+TEST_CASE("Co::Typewriter")
+{
+	TestClock clock;
+
+	String value;
+	auto typewriterTask = Co::Typewriter(&value, 0.25s, U"TEST") // ここで指定するのは1文字あたりの時間
+		.setClock(&clock)
+		.play();
+
+	// Task生成時点ではまだ実行されない
+	REQUIRE(typewriterTask.done() == false);
+	REQUIRE(value.isEmpty());
+
+	const auto runner = std::move(typewriterTask).runScoped();
+
+	// runScopedで開始すると初期値が代入される
+	// 1文字目は最初から表示される仕様にしている
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"T");
+
+	// 0秒
+	clock.microsec = 0;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"T");
+
+	// 0.2501秒
+	clock.microsec = 250'100;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"TE");
+
+	// 0.5001秒
+	clock.microsec = 500'100;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"TES");
+
+	// 0.7501秒
+	// 最後の文字が見える時間を設ける必要があるため、この時点で最後の文字まで表示される仕様にしている
+	clock.microsec = 750'100;
+	System::Update();
+	REQUIRE(runner.done() == false); // タスク自体はまだ終了していない
+	REQUIRE(value == U"TEST");
+
+	// 1.0001秒
+	clock.microsec = 1'000'100;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == U"TEST");
+}
+
+TEST_CASE("Co::Typewriter with zero duration")
+{
+	String value;
+	const auto runner = Co::Typewriter(&value, 0s, U"TEST").playScoped();
+
+	// 即座に終了
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == U"TEST");
+}
+
+TEST_CASE("Co::Typewriter with total duration")
+{
+	TestClock clock;
+
+	String value;
+	const auto runner = Co::Typewriter(&value)
+		.text(U"TEST")
+		.totalDuration(1s)
+		.setClock(&clock)
+		.playScoped();
+
+	// 0秒
+	clock.microsec = 0;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"T");
+
+	// 0.2501秒
+	clock.microsec = 250'100;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"TE");
+
+	// 0.5001秒
+	clock.microsec = 500'100;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"TES");
+
+	// 0.7501秒
+	clock.microsec = 750'100;
+	System::Update();
+	REQUIRE(runner.done() == false);
+	REQUIRE(value == U"TEST");
+
+	// 1.0001秒
+	clock.microsec = 1'000'100;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == U"TEST");
+}
+
+TEST_CASE("Co::TypewriterView")
+{
+	TestClock clock;
+
+	Array<String> values;
+	const auto runner = Co::TypewriterView([&](StringView view) { values.emplace_back(view); }, 0.25s, U"TEST")
+		.setClock(&clock)
+		.playScoped();
+
+	// 表示文字数が変化したときのみ呼ばれる
+	REQUIRE(values == Array<String>{ U"T" });
+
+	clock.microsec = 100'000;
+	System::Update();
+	REQUIRE(values == Array<String>{ U"T" });
+
+	clock.microsec = 250'100;
+	System::Update();
+	REQUIRE(values == Array<String>{ U"T", U"TE" });
+
+	// 複数文字分の時間が経過した場合は1回だけ呼ばれる
+	clock.microsec = 750'100;
+	System::Update();
+	REQUIRE(values == Array<String>{ U"T", U"TE", U"TEST" });
+
+	clock.microsec = 1'000'100;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(values.size() == 3);
+}
+
+TEST_CASE("Co::Typewriter with pauseAfter")
+{
+	TestClock clock;
+
+	String value;
+	const auto runner = Co::Typewriter(&value, 0.25s, U"A、B。")
+		.pauseAfter(U"、。", 0.5s)
+		.setClock(&clock)
+		.playScoped();
+
+	// 各文字の表示時刻: A=0秒, 、=0.25秒, B=1.0秒, 。=1.25秒, 終了=2.0秒
+	REQUIRE(value == U"A");
+
+	clock.microsec = 250'100;
+	System::Update();
+	REQUIRE(value == U"A、");
+
+	// 読点の後の待機中
+	clock.microsec = 900'000;
+	System::Update();
+	REQUIRE(value == U"A、");
+
+	clock.microsec = 1'000'100;
+	System::Update();
+	REQUIRE(value == U"A、B");
+
+	clock.microsec = 1'250'100;
+	System::Update();
+	REQUIRE(value == U"A、B。");
+	REQUIRE(runner.done() == false);
+
+	// 句点の後の待機時間もタスクの時間に含まれる
+	clock.microsec = 1'900'000;
+	System::Update();
+	REQUIRE(runner.done() == false);
+
+	clock.microsec = 2'000'100;
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == U"A、B。");
+}
+
+TEST_CASE("Co::Typewriter with pauseAfter and total duration")
+{
+	TestClock clock;
+
+	String value;
+	const auto runner = Co::Typewriter(&value)
+		.text(U"AB。C")
+		.pauseAfter(U"。", 1s)
+		.totalDuration(1s)
+		.setClock(&clock)
+		.playScoped();
+
+	// 1文字あたり0.25秒+句点の後1秒の比率(合計2秒)のまま全体を1秒に収める
+	// 各文字の表示時刻: A=0秒, B=0.125秒, 。=0.25秒, C=0.875秒, 終了=1.0秒
+	REQUIRE(value == U"A");
+
+	clock.microsec = 250'100;
+	System::Update();
+	REQUIRE(value == U"AB。");
+
+	clock.microsec = 800'000;
+	System::Update();
+	REQUIRE(value == U"AB。");
+
+	clock.microsec = 875'100;
+	System::Update();
+	REQUIRE(value == U"AB。C");
+	REQUIRE(runner.done() == false);
+
+	clock.microsec = 1'000'100;
+	System::Update();
+	REQUIRE(runner.done() == true);
+}
+
+TEST_CASE("Co::Typewriter rewrites the whole text if modified externally")
+{
+	TestClock clock;
+
+	String value;
+	const auto runner = Co::Typewriter(&value, 0.25s, U"TEST")
+		.setClock(&clock)
+		.playScoped();
+	REQUIRE(value == U"T");
+
+	clock.microsec = 250'100;
+	System::Update();
+	REQUIRE(value == U"TE");
+
+	// 外部から書き換えられた場合は追記ではなく全体を代入し直す
+	value = U"XYZ";
+	clock.microsec = 500'100;
+	System::Update();
+	REQUIRE(value == U"TES");
+
+	clock.microsec = 750'100;
+	System::Update();
+	REQUIRE(value == U"TEST");
+}
+
+template <typename Func, typename... Args>
+auto AsyncTaskCaller(Func func, Args... args) -> Co::Task<std::invoke_result_t<Func, Args...>>
+	requires std::is_invocable_v<Func, Args...>
+{
+	co_return co_await Async(func, std::move(args)...);
+}
+
+TEST_CASE("s3d::AsyncTask immediate")
+{
+	int32 value = 0;
+	const auto runner = AsyncTaskCaller([] { return 42; }).runScoped([&value](int32 result) { value = result; });
+
+	// 通常の即時returnとは違って別スレッドなので、完了までに最低限の待機は必要
+	while (!runner.done())
+	{
+		System::Update();
+	}
+	REQUIRE(value == 42);
+}
+
+TEST_CASE("s3d::AsyncTask with sleep")
+{
+	std::atomic<int32> value = 0;
+
+	// 完了に十分な時間待つ
+	const auto wait = Co::Delay(0.5s).runScoped();
+	{
+		const auto runner = AsyncTaskCaller([] { std::this_thread::sleep_for(0.01s); return 42; }).runScoped([&value](int32 result) { value = result; });
+		REQUIRE(runner.done() == false);
+		REQUIRE(value == 0);
+
+		while (!wait.done())
+		{
+			System::Update();
+		}
+	}
+
+	REQUIRE(value == 42);
+}
+
+TEST_CASE("s3d::AsyncTask with sleep canceled")
+{
+	std::atomic<int32> value = 0;
+	int32 finishCallbackCOunt = 0;
+	int32 cancelCallbackCount = 0;
+
+	// 完了に不十分な時間しか待たない場合も、タスク自体はキャンセルされるが、std::futureの破棄タイミングでスレッド終了を待機するため実行は最後までされることを確認
+	{
+		const auto runner = AsyncTaskCaller([&] { std::this_thread::sleep_for(0.2s); value = 42; })
+			.runScoped([&]() { ++finishCallbackCOunt; }, [&]() { ++cancelCallbackCount; });
+		REQUIRE(runner.done() == false);
+		REQUIRE(value == 0);
+
+		const auto wait = Co::Delay(0.01s).runScoped();
+		while (!wait.done())
+		{
+			System::Update();
+		}
+	}
+	REQUIRE(value == 42);
+	REQUIRE(finishCallbackCOunt == 0);
+	REQUIRE(cancelCallbackCount == 1);
+}
+
+TEST_CASE("s3d::AsyncTask with exception")
+{
+	std::atomic<int32> value = 0;
+	int32 finishCallbackCOunt = 0;
+	int32 cancelCallbackCount = 0;
+
+	auto task = AsyncTaskCaller([&] { std::this_thread::sleep_for(0.01s); throw std::runtime_error("test exception"); value = 42; })
+		.runScoped([&]() { ++finishCallbackCOunt; }, [&]() { ++cancelCallbackCount; });
+	REQUIRE(value == 0);
+
+	const auto fnWait = [&task]
+		{
+			while (!task.done())
+			{
+				std::this_thread::sleep_for(0.01s);
+
+				// System::Update内で例外が発生すると以降のテスト実行に影響が出る可能性があるため、手動resumeでテスト
+				Co::detail::Backend::ManualUpdate();
+			}
+		};
+
+	// 他スレッドで発生した例外が捕捉できることを確認
+	REQUIRE_THROWS_WITH(fnWait(), "test exception");
+	REQUIRE(value == 0);
+	REQUIRE(finishCallbackCOunt == 0);
+	REQUIRE(cancelCallbackCount == 1);
+}
+
+// 別スレッドの処理を待つため、完了するまでupdateを繰り返す(テストが終わらなくなることを避けるため、一定回数で打ち切る)
+template <typename TRunner>
+void UpdateUntilDone(const TRunner& runner)
+{
+	for (int32 i = 0; i < 10000 && !runner.done(); ++i)
+	{
+		System::Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	}
+}
+
+// キャンセルが要求されるまで待機する(テストが終わらなくなることを避けるため、一定時間で打ち切る)
+bool WaitForCancellation(const Co::CancellationToken& token)
+{
+	for (int32 i = 0; i < 5000 && !token.isCancellationRequested(); ++i)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	}
+	return token.isCancellationRequested();
+}
+
+TEST_CASE("Co::AllOf with s3d::AsyncTask array")
+{
+	Array<int32> results;
+	const auto fnTask = [&]() -> Co::Task<void>
+		{
+			Array<AsyncTask<int32>> asyncTasks;
+			asyncTasks.push_back(Async([] { std::this_thread::sleep_for(0.02s); return 1; }));
+			asyncTasks.push_back(Async([] { return 2; }));
+			asyncTasks.push_back(Async([] { std::this_thread::sleep_for(0.01s); return 3; }));
+			results = co_await Co::AllOf(std::move(asyncTasks));
+		};
+
+	const auto runner = fnTask().runScoped();
+	UpdateUntilDone(runner);
+	REQUIRE(runner.done());
+	REQUIRE(results == Array<int32>{ 1, 2, 3 });
+}
+
+TEST_CASE("Co::AnyOf with s3d::AsyncTask array requests cancellation of the rest")
+{
+	const Co::CancellationToken token;
+	std::atomic<bool> isCanceledObserved = false;
+	Optional<std::pair<std::size_t, int32>> result;
+	const auto fnTask = [&]() -> Co::Task<void>
+		{
+			Array<AsyncTask<int32>> asyncTasks;
+			asyncTasks.push_back(Async([token, &isCanceledObserved] { isCanceledObserved = WaitForCancellation(token); return 1; }));
+			asyncTasks.push_back(Async([] { return 2; }));
+			result = co_await Co::AnyOf(std::move(asyncTasks), token);
+		};
+
+	const auto runner = fnTask().runScoped();
+	UpdateUntilDone(runner);
+	REQUIRE(runner.done());
+	REQUIRE(result == std::pair<std::size_t, int32>{ 1, 2 });
+	REQUIRE(isCanceledObserved);
+}
+
+TEST_CASE("Co::AllOf with s3d::AsyncTask array requests cancellation on runner destruction")
+{
+	const Co::CancellationToken token;
+	std::atomic<bool> isCanceledObserved = false;
+	{
+		Array<AsyncTask<void>> asyncTasks;
+		asyncTasks.push_back(Async([token, &isCanceledObserved] { isCanceledObserved = WaitForCancellation(token); }));
+		const auto runner = Co::AllOf(std::move(asyncTasks), token).runScoped();
+		System::Update();
+		REQUIRE(!runner.done());
+		REQUIRE(!token.isCancellationRequested());
+	}
+
+	// std::futureの破棄時にスレッドの終了を待機するため、この時点でキャンセルを受け取っている
+	REQUIRE(token.isCancellationRequested());
+	REQUIRE(isCanceledObserved);
+}
+
+TEST_CASE("s3d::AsyncTask with move-only result")
+{
+	std::unique_ptr<int32> result = nullptr;
+
+	// ムーブオンリー型の結果も取得できる
+	const auto runner = AsyncTaskCaller([](int32 value) { return std::make_unique<int32>(value * 10); }, 42)
+		.runScoped([&](std::unique_ptr<int32>&& r) { result = std::move(r); });
+
+	// 通常の即時returnとは違って別スレッドなので、完了までに最低限の待機は必要
+	while (!runner.done())
+	{
+		System::Update();
+	}
+	REQUIRE(result != nullptr);
+	REQUIRE(*result == 420);
+}
+
+TEST_CASE("ScopedDrawer draw order")
+{
+	std::vector<int32> order;
+
+	Co::ScopedDrawer drawer1{ [&] { order.push_back(1); } };
+	Co::ScopedDrawer drawer2{ [&] { order.push_back(2); }, Co::Layer::Default, Co::DrawIndex::Back };
+	Co::ScopedDrawer drawer3{ [&] { order.push_back(3); } };
+	Co::ScopedDrawer drawer4{ [&] { order.push_back(4); }, Co::Layer::Modal };
+	Co::ScopedDrawer drawer5{ [&] { order.push_back(5); }, Co::Layer::User_PreDefault_1 };
+
+	// レイヤー順 → drawIndex順 → 登録順で描画される
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 5, 2, 1, 3, 4 });
+
+	// drawIndexを変更しても同じdrawIndex内では登録順が保たれる
+	order.clear();
+	drawer3.setDrawIndex(Co::DrawIndex::Back);
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 5, 2, 3, 1, 4 });
+
+	// レイヤーを移動しても登録順が保たれる
+	order.clear();
+	drawer5.setLayer(Co::Layer::Default);
+	drawer5.setDrawIndex(Co::DrawIndex::Back);
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 2, 3, 5, 1, 4 });
+}
+
+TEST_CASE("ScopedDrawer remove and layer existence")
+{
+	std::vector<int32> order;
+
+	REQUIRE(Co::HasActiveDrawerInLayer(Co::Layer::User_PostDefault_1) == false);
+
+	Optional<Co::ScopedDrawer> drawer1{ std::in_place, [&] { order.push_back(1); }, Co::Layer::User_PostDefault_1 };
+	Optional<Co::ScopedDrawer> drawer2{ std::in_place, [&] { order.push_back(2); }, Co::Layer::User_PostDefault_1 };
+	Co::ScopedDrawer drawer3{ [&] { order.push_back(3); }, Co::Layer::User_PostDefault_1 };
+	REQUIRE(Co::HasActiveDrawerInLayer(Co::Layer::User_PostDefault_1) == true);
+
+	// 削除後も残りの描画順は変わらない
+	drawer1.reset();
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 2, 3 });
+
+	// 削除したスロットを再利用した場合も、後から追加したものは後に描画される
+	order.clear();
+	Co::ScopedDrawer drawer4{ [&] { order.push_back(4); }, Co::Layer::User_PostDefault_1 };
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 2, 3, 4 });
+
+	drawer2.reset();
+	drawer3.setLayer(Co::Layer::User_PostDefault_2);
+	drawer4.setLayer(Co::Layer::User_PostDefault_2);
+	REQUIRE(Co::HasActiveDrawerInLayer(Co::Layer::User_PostDefault_1) == false);
+	REQUIRE(Co::HasActiveDrawerInLayer(Co::Layer::User_PostDefault_2) == true);
+}
+
+TEST_CASE("Hidden ScopedDrawer is skipped")
+{
+	std::vector<int32> order;
+
+	Co::ScopedDrawer drawer1{ [&] { order.push_back(1); }, Co::Layer::User_PostDefault_3 };
+	Co::ScopedDrawer drawer2{ [&] { order.push_back(2); }, Co::Layer::User_PostDefault_3 };
+
+	// 非表示のDrawerは登録したまま描画されない
+	drawer1.setVisible(false);
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 2 });
+	REQUIRE(Co::HasActiveDrawerInLayer(Co::Layer::User_PostDefault_3) == true);
+
+	// 再表示すると元の描画順で描画される
+	order.clear();
+	drawer1.setVisible(true);
+	System::Update();
+	REQUIRE(order == std::vector<int32>{ 1, 2 });
+}
+
+TEST_CASE("Cached layer draws drawers only when invalidated")
+{
+	constexpr auto CachedLayer = Co::Layer::User_PreDefault_3;
+
+	int32 drawCount1 = 0;
+	int32 drawCount2 = 0;
+	Co::ScopedDrawer drawer1{ [&] { ++drawCount1; }, CachedLayer };
+
+	Co::SetLayerCached(CachedLayer, true);
+	REQUIRE(Co::IsLayerCached(CachedLayer) == true);
+
+	// 初回のみDrawerを描画し、以降はキャッシュを描画する
+	System::Update();
+	System::Update();
+	REQUIRE(drawCount1 == 1);
+
+	// 明示的に無効化すると描画し直す
+	Co::InvalidateLayerCache(CachedLayer);
+	System::Update();
+	System::Update();
+	REQUIRE(drawCount1 == 2);
+
+	{
+		// Drawerの追加・削除時は自動的に無効化される
+		Co::ScopedDrawer drawer2{ [&] { ++drawCount2; }, CachedLayer };
+		System::Update();
+		REQUIRE(drawCount1 == 3);
+		REQUIRE(drawCount2 == 1);
+	}
+	System::Update();
+	REQUIRE(drawCount1 == 4);
+	REQUIRE(drawCount2 == 1);
+
+	// 表示状態の変更時も無効化される
+	drawer1.setVisible(false);
+	System::Update();
+	REQUIRE(drawCount1 == 4);
+	drawer1.setVisible(true);
+	System::Update();
+	REQUIRE(drawCount1 == 5);
+
+	// キャッシュを解除すると毎フレーム描画される
+	Co::SetLayerCached(CachedLayer, false);
+	REQUIRE(Co::IsLayerCached(CachedLayer) == false);
+	System::Update();
+	System::Update();
+	REQUIRE(drawCount1 == 7);
+}
+
+TEST_CASE("Cached layer draws semi-transparent drawers same as uncached layer")
+{
+	constexpr auto CachedLayer = Co::Layer::User_PreDefault_3;
+
+	// 不透明な背景の上に、不透明度0.5のDrawerを描画した結果の左上のピクセルを取得する
+	const auto fnDrawPixel = []
+		{
+			RenderTexture target{ 4, 4 };
+			target.clear(ColorF{ 0.0, 0.0, 1.0, 1.0 });
+			{
+				const ScopedRenderTarget2D renderTarget{ target };
+				Co::detail::Backend::ManualDraw();
+			}
+			Graphics2D::Flush();
+
+			Image image;
+			target.readAsImage(image);
+			return image[0][0];
+		};
+
+	const auto fnIsNear = [](const Color& a, const Color& b)
+		{
+			return Abs(a.r - b.r) <= 2 && Abs(a.g - b.g) <= 2 && Abs(a.b - b.b) <= 2 && Abs(a.a - b.a) <= 2;
+		};
+
+	const Co::ScopedDrawer drawer{ [] { Rect{ 0, 0, 4, 4 }.draw(ColorF{ 1.0, 0.0, 0.0, 0.5 }); }, CachedLayer };
+
+	const Color uncachedPixel = fnDrawPixel();
+
+	Co::SetLayerCached(CachedLayer, true);
+	const Color cachedPixel = fnDrawPixel();
+	const Color cachedPixel2 = fnDrawPixel();
+	Co::SetLayerCached(CachedLayer, false);
+
+	// キャッシュの有無で描画結果が変わらない(不透明度が二重に掛からない)
+	REQUIRE(fnIsNear(uncachedPixel, Color{ 128, 0, 128, 255 }));
+	REQUIRE(fnIsNear(cachedPixel, uncachedPixel));
+	REQUIRE(fnIsNear(cachedPixel2, uncachedPixel));
+}
+
+Co::Task<int32> NestedDelayFrameTest(int32 depth, int32* pLeafResumeCount)
+{
+	if (depth == 0)
+	{
+		for (int32 i = 0; i < 3; ++i)
+		{
+			co_await Co::NextFrame();
+			++*pLeafResumeCount;
+		}
+		co_return 0;
+	}
+	const int32 result = co_await NestedDelayFrameTest(depth - 1, pLeafResumeCount);
+	co_await Co::NextFrame();
+	co_return result + 1;
+}
+
+TEST_CASE("Deeply nested co_await")
+{
+	int32 leafResumeCount = 0;
+	Optional<int32> result;
+	const auto runner = NestedDelayFrameTest(50, &leafResumeCount).runScoped([&](int32 r) { result = r; });
+
+	for (int32 i = 0; i < 3; ++i)
+	{
+		REQUIRE(leafResumeCount == i);
+		System::Update();
+	}
+	REQUIRE(leafResumeCount == 3);
+
+	// 末端の完了後は1階層ずつ親へ戻る
+	for (int32 i = 0; i < 50; ++i)
+	{
+		REQUIRE(runner.done() == false);
+		System::Update();
+	}
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == 50);
+}
+
+Co::Task<int32> NestedWithConcurrentTaskTest(std::vector<int32>* pVec, int32* pLeafResumeCount)
+{
+	co_return co_await NestedDelayFrameTest(5, pLeafResumeCount).with(PushBackValueEveryFrame(pVec, 1));
+}
+
+TEST_CASE("Deeply nested co_await with concurrent task")
+{
+	std::vector<int32> values;
+	int32 leafResumeCount = 0;
+	Optional<int32> result;
+	const auto runner = NestedWithConcurrentTaskTest(&values, &leafResumeCount).runScoped([&](int32 r) { result = r; });
+
+	// 途中の階層にある並行タスクも毎フレーム実行される
+	for (int32 i = 0; i < 8; ++i)
+	{
+		REQUIRE(runner.done() == false);
+		REQUIRE(values.size() == static_cast<std::size_t>(i));
+		System::Update();
+	}
+	REQUIRE(runner.done() == true);
+	REQUIRE(leafResumeCount == 3);
+	REQUIRE(result == 5);
+}
+
+TEST_CASE("Task::with execution order")
+{
+	std::vector<int32> vec;
+
+	// インラインに保持できる数を超えて追加しても、タイミングごとに追加順で実行される
+	const auto runner = PushBackValueEveryFrame(&vec, 0)
+		.with(PushBackValueEveryFrame(&vec, 1))
+		.with(PushBackValueEveryFrame(&vec, -1), Co::WithTiming::Before)
+		.with(PushBackValueEveryFrame(&vec, 2))
+		.with(PushBackValueEveryFrame(&vec, -2), Co::WithTiming::Before)
+		.with(PushBackValueEveryFrame(&vec, 3), Co::WithTiming::After)
+		.runScoped();
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ -1, -2, 0, 1, 2, 3 });
+
+	vec.clear();
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ -1, -2, 0, 1, 2, 3 });
+}
+
+TEST_CASE("Task::with companion is destroyed with parent")
+{
+	int32 value = 0;
+	bool isCompanionCanceled = false;
+	{
+		// 並行タスクの中でScopedTaskRunnerを持ち、並行タスクの破棄を検出する
+		auto companion = [](bool* pIsCanceled) -> Co::Task<void>
+			{
+				const auto runner = Co::WaitForever().runScoped(nullptr, [pIsCanceled] { *pIsCanceled = true; });
+				co_await Co::WaitForever();
+			}(&isCompanionCanceled);
+
+		const auto runner = DelayFrameTest(&value).with(std::move(companion)).runScoped();
+		System::Update();
+		REQUIRE(isCompanionCanceled == false);
+	}
+
+	// 親の破棄とともに並行タスクも破棄される
+	REQUIRE(isCompanionCanceled == true);
+}
+
+TEST_CASE("Task::with empty companion")
+{
+	int32 value = 0;
+	const auto runner = DelayFrameTest(&value).with(Co::EmptyTask()).runScoped();
+	for (int32 i = 0; i < 4; ++i)
+	{
+		REQUIRE(runner.done() == false);
+		System::Update();
+	}
+	REQUIRE(runner.done() == true);
+	REQUIRE(value == 3);
+}
+
+TEST_CASE("Task holds only its handle")
+{
+	// 並行タスクはPromise側で保持されるため、Taskオブジェクトの大きさは並行タスクの有無に依存しない
+	static_assert(sizeof(Co::Task<void>) == sizeof(Co::ITask) + sizeof(std::coroutine_handle<>));
+	static_assert(sizeof(Co::Task<int32>) == sizeof(Co::Task<void>));
+	SUCCEED();
+}
+
+struct CountingTestClock : ISteadyClock
+{
+	uint64 microsec = 0;
+	int32* pCallCount;
+
+	explicit CountingTestClock(int32* pCallCount)
+		: pCallCount(pCallCount)
+	{
+	}
+
+	uint64 getMicrosec() override
+	{
+		++*pCallCount;
+		return microsec;
+	}
+};
+
+TEST_CASE("Parked Delay does not resume every frame")
+{
+	int32 callCount = 0;
+	CountingTestClock clock{ &callCount };
+
+	std::vector<Co::ScopedTaskRunner> runners;
+	for (int32 i = 0; i < 10; ++i)
+	{
+		runners.push_back(Co::Delay(1s, &clock).runScoped());
+	}
+	System::Update(); // ここで休止に入る
+
+	// 休止中は時計の取得がupdateあたり1回のみになる
+	const int32 callCountBefore = callCount;
+	System::Update();
+	System::Update();
+	REQUIRE(callCount - callCountBefore == 2);
+	REQUIRE(std::all_of(runners.begin(), runners.end(), [](const auto& runner) { return !runner.done(); }));
+
+	clock.microsec = 999'999;
+	System::Update();
+	REQUIRE(std::all_of(runners.begin(), runners.end(), [](const auto& runner) { return !runner.done(); }));
+
+	clock.microsec = 1'000'000;
+	System::Update();
+	REQUIRE(std::all_of(runners.begin(), runners.end(), [](const auto& runner) { return runner.done(); }));
+}
+
+TEST_CASE("Steady clock is sampled once per update")
+{
+	int32 callCount = 0;
+	CountingTestClock clock{ &callCount };
+
+	Array<double> values(100, 0.0);
+	Co::MultiRunner mr;
+	for (auto& value : values)
+	{
+		Co::LinearEase(&value, 1s, &clock).fromTo(0.0, 100.0).playAddTo(mr);
+	}
+
+	// 毎フレーム更新される多数のタイマーがあっても、時計の取得はupdateあたり1回のみ
+	const int32 callCountBefore = callCount;
+	clock.microsec = 100'000;
+	System::Update();
+	REQUIRE(callCount - callCountBefore == 1);
+	clock.microsec = 200'000;
+	System::Update();
+	REQUIRE(callCount - callCountBefore == 2);
+	REQUIRE(std::all_of(values.begin(), values.end(), [](double value) { return value == Approx(20.0); }));
+}
+
+TEST_CASE("Timers in the same update share the same time")
+{
+	TestClock clock;
+
+	// update中に時計が進んでも、同じupdate内の後続のタスクは同じ時刻を参照する
+	double value1 = 0.0;
+	double value2 = 0.0;
+	const auto runner1 = Co::LinearEase(&value1, 1s, &clock).fromTo(0.0, 100.0).playScoped();
+	const auto clockAdvancer = [](TestClock* pClock) -> Co::Task<void>
+		{
+			while (true)
+			{
+				co_await Co::NextFrame();
+				pClock->microsec += 100'000;
+			}
+		}(&clock).runScoped();
+	const auto runner2 = Co::LinearEase(&value2, 1s, &clock).fromTo(0.0, 100.0).playScoped();
+
+	System::Update();
+	REQUIRE(value1 == 0.0);
+	REQUIRE(value1 == value2);
+	System::Update();
+	REQUIRE(value1 == Approx(10.0));
+	REQUIRE(value1 == value2);
+}
+
+TEST_CASE("Cancel parked Delay with steady clock")
+{
+	int32 callCount = 0;
+	auto pClock = std::make_unique<CountingTestClock>(&callCount);
+
+	Optional<Co::ScopedTaskRunner> runner = Co::Delay(1s, pClock.get()).runScoped();
+	System::Update();
+	REQUIRE(runner->done() == false);
+
+	// 休止中のタスクがなくなった時計は破棄されている可能性があるため、以降は時刻を取得しない
+	runner.reset();
+	pClock.reset();
+	const int32 callCountBefore = callCount;
+	System::Update();
+	System::Update();
+	REQUIRE(callCount == callCountBefore);
+}
+
+Co::Task<void> PushBackValueAfterDelayFrame(std::vector<int32>* pVec, int32 value, int32 frames)
+{
+	co_await Co::DelayFrame(frames);
+	pVec->push_back(value);
+}
+
+TEST_CASE("Parked DelayFrame keeps execution order")
+{
+	std::vector<int32> values;
+
+	const auto runner1 = PushBackValueAfterDelayFrame(&values, 1, 2).runScoped();
+	const auto runner2 = PushBackValueEveryFrame(&values, 2).runScoped();
+
+	System::Update();
+	REQUIRE(values == std::vector<int32>{ 2 });
+
+	// 休止から復帰したタスクも登録順に実行される
+	System::Update();
+	REQUIRE(values == std::vector<int32>{ 2, 1, 2 });
+	REQUIRE(runner1.done() == true);
+}
+
+Co::Task<void> PushBackValueEveryFrameAfterDone(const Co::TaskFinishSource<void>* pSource, std::vector<int32>* pVec, int32 value)
+{
+	co_await pSource->waitUntilDone();
+	while (true)
+	{
+		pVec->push_back(value);
+		co_await Co::NextFrame();
+	}
+}
+
+TEST_CASE("Tasks woken during update keep execution order")
+{
+	std::vector<int32> values;
+	Co::TaskFinishSource<void> source;
+	bool finishRequested = false;
+
+	const auto runner1 = PushBackValueEveryFrameAfterDone(&source, &values, 1).runScoped();
+	const auto runner2 = PushBackValueEveryFrame(&values, 2).runScoped();
+	const auto runner3 = PushBackValueEveryFrameAfterDone(&source, &values, 3).runScoped();
+	Optional<Co::ScopedTaskRunner> runner4 = PushBackValueEveryFrame(&values, 4).runScoped();
+	const auto runner5 = PushBackValueEveryFrame(&values, 5).runScoped();
+	const auto finisher = Co::UpdaterTask([&] { if (finishRequested) source.requestFinish(); }).runScoped();
+	const auto runner6 = PushBackValueEveryFrameAfterDone(&source, &values, 6).runScoped();
+	const auto runner7 = PushBackValueEveryFrame(&values, 7).runScoped();
+	const auto runner8 = PushBackValueEveryFrameAfterDone(&source, &values, 8).runScoped();
+
+	System::Update();
+	REQUIRE(values == std::vector<int32>{ 2, 4, 5, 7 });
+
+	// update中に起床したタスクのうち、実行順がまだ回ってきていないものは同じupdate内で登録順の位置から実行される
+	finishRequested = true;
+	values.clear();
+	System::Update();
+	REQUIRE(values == std::vector<int32>{ 2, 4, 5, 6, 7, 8 });
+
+	// 実行順を既に通過していたものは次のupdateから登録順に実行される(途中で削除されたタスクは除く)
+	runner4.reset();
+	values.clear();
+	System::Update();
+	REQUIRE(values == std::vector<int32>{ 1, 2, 3, 5, 6, 7, 8 });
+
+	values.clear();
+	System::Update();
+	REQUIRE(values == std::vector<int32>{ 1, 2, 3, 5, 6, 7, 8 });
+}
+
+TEST_CASE("Parked DelayFrame counts updates")
+{
+	const auto runner = Co::DelayFrame(5).runScoped();
+
+	System::Update();
+	Co::detail::Backend::ManualUpdate();
+	REQUIRE(runner.done() == false);
+
+	// DelayFrameは毎フレームではなくupdateごとに進む
+	System::Update();
+	Co::detail::Backend::ManualUpdate();
+	REQUIRE(runner.done() == false);
+
+	System::Update();
+	REQUIRE(runner.done() == true);
+}
+
+TEST_CASE("Parked Delay does not advance while paused")
+{
+	TestClock clock;
+	bool isPaused = false;
+
+	const auto runner = Co::Delay(1s, &clock).pausedWhile([&] { return isPaused; }).runScoped();
+	System::Update();
+
+	// 親タスクがresumeしない間は時間が進まない
+	isPaused = true;
+	clock.microsec = 2'000'000;
+	System::Update();
+	isPaused = false;
+	System::Update();
+	REQUIRE(runner.done() == false);
+
+	clock.microsec = 2'999'999;
+	System::Update();
+	REQUIRE(runner.done() == false);
+
+	clock.microsec = 3'000'000;
+	System::Update();
+	REQUIRE(runner.done() == true);
+}
+
+// コピー回数を数える型
+struct CopyCountingValue
+{
+	int32 value = 0;
+	int32* pCopyCount = nullptr;
+
+	CopyCountingValue(int32 value, int32* pCopyCount)
+		: value(value)
+		, pCopyCount(pCopyCount)
+	{
+	}
+
+	CopyCountingValue(const CopyCountingValue& rhs)
+		: value(rhs.value)
+		, pCopyCount(rhs.pCopyCount)
+	{
+		++*pCopyCount;
+	}
+
+	CopyCountingValue(CopyCountingValue&&) noexcept = default;
+
+	CopyCountingValue& operator=(const CopyCountingValue& rhs)
+	{
+		value = rhs.value;
+		pCopyCount = rhs.pCopyCount;
+		++*pCopyCount;
+		return *this;
+	}
+
+	CopyCountingValue& operator=(CopyCountingValue&&) noexcept = default;
+};
+
+Co::Task<CopyCountingValue> CopyCountingValueTask(int32 value, int32* pCopyCount)
+{
+	co_await Co::DelayFrame(1);
+	co_return CopyCountingValue{ value, pCopyCount };
+}
+
+Co::Task<CopyCountingValue> NestedCopyCountingValueTask(int32 value, int32* pCopyCount)
+{
+	co_return co_await CopyCountingValueTask(value, pCopyCount);
+}
+
+TEST_CASE("Task result is moved through nested tasks without copy")
+{
+	int32 copyCount = 0;
+
+	Optional<CopyCountingValue> result;
+	const auto runner = NestedCopyCountingValueTask(42, &copyCount).runScoped([&](CopyCountingValue r) { result = std::move(r); });
+	System::Update();
+	REQUIRE(runner.done() == true);
+	REQUIRE(result.has_value());
+	REQUIRE(result->value == 42);
+	REQUIRE(copyCount == 0);
+
+	// Co::Allの結果もコピーされない
+	Optional<std::tuple<CopyCountingValue, CopyCountingValue>> allResult;
+	const auto allRunner = Co::All(NestedCopyCountingValueTask(1, &copyCount), CopyCountingValueTask(2, &copyCount))
+		.runScoped([&](std::tuple<CopyCountingValue, CopyCountingValue> r) { allResult = std::move(r); });
+	System::Update();
+	REQUIRE(allRunner.done() == true);
+	REQUIRE(std::get<0>(*allResult).value == 1);
+	REQUIRE(std::get<1>(*allResult).value == 2);
+	REQUIRE(copyCount == 0);
+}
+
+TEST_CASE("Frame allocator")
+{
+	Co::SetFrameAllocatorEnabled(true);
+	Co::ReleaseFrameAllocatorCache();
+	Co::ResetFrameAllocatorStats();
+
+	const auto fnRunToEnd = []
+		{
+			int32 value = 0;
+			const auto runner = DelayFrameTest(&value).runScoped();
+			while (!runner.done())
+			{
+				System::Update();
+			}
+			REQUIRE(value == 3);
+		};
+
+	// 初回はフリーリストが空なのでグローバルヒープから確保される
+	fnRunToEnd();
+	const auto stats1 = Co::GetFrameAllocatorStats();
+	REQUIRE(stats1.allocateCount > 0);
+	REQUIRE(stats1.allocateCount == stats1.deallocateCount);
+	REQUIRE(stats1.poolHitCount == 0);
+	REQUIRE(stats1.heapAllocateCount == stats1.allocateCount);
+	REQUIRE(stats1.heapDeallocateCount == 0);
+	REQUIRE(stats1.cachedBlockCount > 0);
+
+	// 2回目は解放済みのフレームが再利用され、グローバルヒープからは確保されない
+	fnRunToEnd();
+	const auto stats2 = Co::GetFrameAllocatorStats();
+	REQUIRE(stats2.allocateCount == stats1.allocateCount * 2);
+	REQUIRE(stats2.poolHitCount == stats1.allocateCount);
+	REQUIRE(stats2.heapAllocateCount == stats1.heapAllocateCount);
+	REQUIRE(stats2.cachedBlockCount == stats1.cachedBlockCount);
+	REQUIRE(stats2.poolHitRate() == Approx(0.5));
+
+	// 無効にするとグローバルヒープへ返却される
+	Co::SetFrameAllocatorEnabled(false);
+	Co::ReleaseFrameAllocatorCache();
+	fnRunToEnd();
+	const auto stats3 = Co::GetFrameAllocatorStats();
+	REQUIRE(stats3.cachedBlockCount == 0);
+	REQUIRE(stats3.heapDeallocateCount == stats3.deallocateCount - stats2.deallocateCount + stats2.cachedBlockCount);
+}
+
+TEST_CASE("Frame allocator toggled without releasing cache")
+{
+	Co::SetFrameAllocatorEnabled(true);
+	Co::ReleaseFrameAllocatorCache();
+
+	const auto fnRunToEnd = []
+		{
+			int32 value = 0;
+			const auto runner = DelayFrameTest(&value).runScoped();
+			while (!runner.done())
+			{
+				System::Update();
+			}
+		};
+
+	// フリーリストにブロックを溜める
+	fnRunToEnd();
+	const auto stats1 = Co::GetFrameAllocatorStats();
+	REQUIRE(stats1.cachedBlockCount > 0);
+
+	// 無効にした後は、フリーリストに残っているブロックがあってもグローバルヒープから確保・返却する
+	Co::SetFrameAllocatorEnabled(false);
+	fnRunToEnd();
+	const auto stats2 = Co::GetFrameAllocatorStats();
+	REQUIRE(stats2.poolHitCount == stats1.poolHitCount);
+	REQUIRE(stats2.heapAllocateCount - stats1.heapAllocateCount == stats2.allocateCount - stats1.allocateCount);
+	REQUIRE(stats2.heapDeallocateCount - stats1.heapDeallocateCount == stats2.deallocateCount - stats1.deallocateCount);
+	REQUIRE(stats2.cachedBlockCount == stats1.cachedBlockCount);
+
+	// 再び有効にすると、残っていたブロックが再利用される
+	Co::SetFrameAllocatorEnabled(true);
+	fnRunToEnd();
+	const auto stats3 = Co::GetFrameAllocatorStats();
+	REQUIRE(stats3.poolHitCount - stats2.poolHitCount == stats3.allocateCount - stats2.allocateCount);
+	REQUIRE(stats3.heapAllocateCount == stats2.heapAllocateCount);
+
+	Co::SetFrameAllocatorEnabled(false);
+	Co::ReleaseFrameAllocatorCache();
+}
+
+TEST_CASE("Frame allocator with registered task callbacks")
+{
+	Co::SetFrameAllocatorEnabled(true);
+	Co::ReleaseFrameAllocatorCache();
+
+	int32 finishCount = 0;
+	int32 cancelCount = 0;
+	const auto fnRun = [&](bool cancel)
+		{
+			int32 value = 0;
+			auto runner = DelayFrameTest(&value).runScoped([&] { ++finishCount; }, [&] { ++cancelCount; });
+			System::Update();
+			if (cancel)
+			{
+				runner.requestCancel();
+			}
+			while (!runner.done())
+			{
+				System::Update();
+			}
+		};
+
+	// 初回でフリーリストに確保済みのブロックが溜まる
+	fnRun(false);
+	REQUIRE(finishCount == 1);
+	REQUIRE(cancelCount == 0);
+
+	// 2回目以降はAwaiterとコールバックの保持もフリーリストから確保される
+	Co::ResetFrameAllocatorStats();
+	fnRun(false);
+	fnRun(true);
+	const auto stats = Co::GetFrameAllocatorStats();
+	REQUIRE(finishCount == 2);
+	REQUIRE(cancelCount == 1);
+	REQUIRE(stats.allocateCount > 0);
+	REQUIRE(stats.heapAllocateCount == 0);
+	REQUIRE(stats.poolHitCount == stats.allocateCount);
+
+	Co::SetFrameAllocatorEnabled(false);
+	Co::ReleaseFrameAllocatorCache();
+}
+
+Co::Task<void> AppendEveryFrame(Array<int32>* pLog, int32 value)
+{
+	while (true)
+	{
+		co_await Co::NextFrame();
+		pLog->push_back(value);
+	}
+}
+
+TEST_CASE("Critical tasks run before normal tasks")
+{
+	Array<int32> log;
+	const auto normal = AppendEveryFrame(&log, 1).runScoped();
+	auto critical = AppendEveryFrame(&log, 2).runScoped();
+	const auto background = AppendEveryFrame(&log, 3).runScoped();
+	critical.setPriority(Co::TaskPriority::Critical);
+	REQUIRE(critical.priority() == Co::TaskPriority::Critical);
+	REQUIRE(normal.priority() == Co::TaskPriority::Normal);
+
+	System::Update();
+	REQUIRE(log == Array<int32>{ 2, 1, 3 });
+
+	// Normalに戻すと登録順で実行される
+	critical.setPriority(Co::TaskPriority::Normal);
+	log.clear();
+	System::Update();
+	REQUIRE(log == Array<int32>{ 1, 2, 3 });
+}
+
+Co::Task<void> ConsumeBudget(TestClock* pClock, uint64 microsec, Array<int32>* pLog, int32 value)
+{
+	while (true)
+	{
+		co_await Co::NextFrame();
+		pClock->microsec += microsec;
+		pLog->push_back(value);
+	}
+}
+
+TEST_CASE("Background tasks are round-robined within the frame budget")
+{
+	TestClock clock;
+	Co::SetFrameBudget(5ms, &clock);
+	Co::ResetTaskPriorityStats();
+
+	// 1タスクあたり3ミリ秒かかるため、5ミリ秒の予算では1フレームに2タスクまで実行される
+	Array<int32> log;
+	std::array<Co::ScopedTaskRunner, 3> runners
+	{
+		ConsumeBudget(&clock, 3000, &log, 1).runScoped(),
+		ConsumeBudget(&clock, 3000, &log, 2).runScoped(),
+		ConsumeBudget(&clock, 3000, &log, 3).runScoped(),
+	};
+	for (auto& runner : runners)
+	{
+		runner.setPriority(Co::TaskPriority::Background);
+	}
+
+	System::Update();
+	REQUIRE(log == Array<int32>{ 1, 2 });
+
+	// 前回持ち越されたタスクから再開する
+	log.clear();
+	System::Update();
+	REQUIRE(log == Array<int32>{ 3, 1 });
+
+	log.clear();
+	System::Update();
+	REQUIRE(log == Array<int32>{ 2, 3 });
+
+	const auto stats = Co::GetTaskPriorityStats(Co::TaskPriority::Background);
+	REQUIRE(stats.resumeCount == 6);
+	REQUIRE(stats.deferCount == 3);
+	REQUIRE(stats.forcedResumeCount == 0);
+
+	Co::SetFrameBudget(0s);
+}
+
+TEST_CASE("Deferred background tasks are not starved")
+{
+	TestClock clock;
+	Co::SetFrameBudget(5ms, &clock);
+	Co::SetMaxDeferredUpdates(2);
+	Co::ResetTaskPriorityStats();
+
+	// Normalのタスクだけで予算を使い切る
+	Array<int32> log;
+	const auto normal = ConsumeBudget(&clock, 10000, &log, 1).runScoped();
+	auto background = ConsumeBudget(&clock, 0, &log, 2).runScoped();
+	background.setPriority(Co::TaskPriority::Background);
+
+	System::Update();
+	System::Update();
+	REQUIRE(log == Array<int32>{ 1, 1 });
+
+	// 2回続けて持ち越されたため、予算を超えていても実行される
+	System::Update();
+	REQUIRE(log == Array<int32>{ 1, 1, 1, 2 });
+
+	System::Update();
+	REQUIRE(log == Array<int32>{ 1, 1, 1, 2, 1 });
+
+	const auto stats = Co::GetTaskPriorityStats(Co::TaskPriority::Background);
+	REQUIRE(stats.deferCount == 3);
+	REQUIRE(stats.forcedResumeCount == 1);
+	REQUIRE(Co::GetTaskPriorityStats(Co::TaskPriority::Normal).resumeCount >= 4);
+
+	Co::SetMaxDeferredUpdates(8);
+	Co::SetFrameBudget(0s);
+}
+
+TEST_CASE("Frame allocator counts live frames and entries")
+{
+	const auto statsBefore = Co::GetFrameAllocatorStats();
+
+	int32 value = 0;
+	{
+		auto task = DelayFrameTest(&value);
+		const auto statsCreated = Co::GetFrameAllocatorStats();
+		REQUIRE(statsCreated.liveFrameCount == statsBefore.liveFrameCount + 1);
+		REQUIRE(statsCreated.liveFrameBytes > statsBefore.liveFrameBytes);
+		REQUIRE(statsCreated.liveFrameBytes % 64 == statsBefore.liveFrameBytes % 64); // サイズクラスに切り上げた値で数える
+		REQUIRE(statsCreated.peakLiveFrameCount >= statsCreated.liveFrameCount);
+		REQUIRE(statsCreated.liveEntryCount == statsBefore.liveEntryCount);
+
+		const auto runner = std::move(task).runScoped();
+		const auto statsRunning = Co::GetFrameAllocatorStats();
+		REQUIRE(statsRunning.liveEntryCount == statsBefore.liveEntryCount + 1);
+		REQUIRE(statsRunning.liveEntryBytes > statsBefore.liveEntryBytes);
+	}
+
+	const auto statsAfter = Co::GetFrameAllocatorStats();
+	REQUIRE(statsAfter.liveFrameCount == statsBefore.liveFrameCount);
+	REQUIRE(statsAfter.liveFrameBytes == statsBefore.liveFrameBytes);
+	REQUIRE(statsAfter.liveFrameCountsBySizeClass == statsBefore.liveFrameCountsBySizeClass);
+	REQUIRE(statsAfter.liveEntryCount == statsBefore.liveEntryCount);
+	REQUIRE(statsAfter.liveEntryBytes == statsBefore.liveEntryBytes);
+
+	// リセット後も使用中の値は保持され、最大値は現在の値から計測し直される
+	Co::ResetFrameAllocatorStats();
+	const auto statsReset = Co::GetFrameAllocatorStats();
+	REQUIRE(statsReset.liveFrameCount == statsAfter.liveFrameCount);
+	REQUIRE(statsReset.peakLiveFrameCount == statsAfter.liveFrameCount);
+}
+
+TEST_CASE("Frame allocator counts frames freed on another thread against that thread")
+{
+	const auto statsBefore = Co::GetFrameAllocatorStats();
+
+	int32 value = 0;
+	auto task = DelayFrameTest(&value);
+	REQUIRE(Co::GetFrameAllocatorStats().liveFrameCount == statsBefore.liveFrameCount + 1);
+
+	// 使用中の数は解放したスレッドの統計情報から差し引かれる(確保したスレッドの値は戻らず、解放したスレッドの値は負になる)
+	Co::FrameAllocatorStats threadStats;
+	std::thread thread{ [&]
+		{
+			const auto threadStatsBefore = Co::GetFrameAllocatorStats();
+			{
+				const auto discarded = std::move(task);
+			}
+			threadStats = Co::GetFrameAllocatorStats();
+			threadStats.liveFrameCount -= threadStatsBefore.liveFrameCount;
+			threadStats.liveFrameBytes -= threadStatsBefore.liveFrameBytes;
+		} };
+	thread.join();
+
+	const auto statsAfter = Co::GetFrameAllocatorStats();
+	REQUIRE(threadStats.liveFrameCount == -1);
+	REQUIRE(statsAfter.liveFrameCount == statsBefore.liveFrameCount + 1);
+
+	// 全スレッドの値の合計は実際に使用中の数と一致する
+	REQUIRE(statsAfter.liveFrameCount + threadStats.liveFrameCount == statsBefore.liveFrameCount);
+	REQUIRE(statsAfter.liveFrameBytes + threadStats.liveFrameBytes == statsBefore.liveFrameBytes);
+}
+
+TEST_CASE("Task::with companion list does not enlarge coroutine frames")
+{
+	// 並行タスクを持たないタスクのPromiseには、並行タスクの一覧のためにポインタ1つ分のみを持つ
+	STATIC_REQUIRE(sizeof(Co::detail::CompanionList) == sizeof(void*));
+
+	const auto censusBefore = Co::GetMemoryCensus();
+	{
+		const auto runner = Co::WaitForever().runScoped();
+		REQUIRE(Co::GetMemoryCensus().companionBytes == censusBefore.companionBytes);
+	}
+
+	// 並行タスクが1つの場合も一覧は追加確保されず、増えるのは並行タスクのコルーチンフレームのみとなる
+	// (親と並行タスクは同じコルーチンのため、フレームの合計は並行タスクのフレームの2倍となる)
+	{
+		const auto runner = Co::WaitForever().with(Co::WaitForever()).runScoped();
+		const auto census = Co::GetMemoryCensus();
+		REQUIRE(census.companionCount == censusBefore.companionCount + 1);
+		REQUIRE((census.companionBytes - censusBefore.companionBytes) * 2 == census.frameBytes - censusBefore.frameBytes);
+	}
+}
+
+TEST_CASE("Memory census counts tasks and companions")
+{
+	const auto censusBefore = Co::GetMemoryCensus();
+
+	{
+		const auto runner = Co::WaitForever()
+			.with(Co::WaitForever())
+			.with(Co::WaitForever())
+			.with(Co::WaitForever())
+			.runScoped();
+		const Co::ScopedDrawer drawer{ [] {} };
+
+		const auto census = Co::GetMemoryCensus();
+		REQUIRE(census.taskCount == censusBefore.taskCount + 1);
+		REQUIRE(census.frameCount == censusBefore.frameCount + 4);
+		REQUIRE(census.companionCount == censusBefore.companionCount + 3);
+
+		// 並行タスクの一覧は最初の追加時に追加確保される
+		REQUIRE(census.companionBytes > censusBefore.companionBytes + 3 * 64);
+		REQUIRE(census.frameBytes > census.companionBytes - censusBefore.companionBytes);
+		REQUIRE(census.drawerCount == censusBefore.drawerCount + 1);
+		REQUIRE(census.drawerBytes > 0);
+		REQUIRE(census.backendBytes > 0);
+	}
+
+	const auto censusAfter = Co::GetMemoryCensus();
+	REQUIRE(censusAfter.taskCount == censusBefore.taskCount);
+	REQUIRE(censusAfter.frameCount == censusBefore.frameCount);
+	REQUIRE(censusAfter.companionCount == censusBefore.companionCount);
+	REQUIRE(censusAfter.drawerCount == censusBefore.drawerCount);
+}
+
+TEST_CASE("Live tasks report age and parked state")
+{
+	// 他のテストで残っているタスクと区別するため、条件に合うタスクの数の差で確認する
+	const auto fnCount = [](uint64 ageUpdateCount, bool isParked)
+		{
+			const auto tasks = Co::GetLiveTasks();
+			return std::count_if(tasks.begin(), tasks.end(), [&](const Co::LiveTaskInfo& info) { return info.ageUpdateCount == ageUpdateCount && info.isParked == isParked && info.frameCount == 1; });
+		};
+	const std::size_t countBefore = Co::GetLiveTasks().size();
+	const auto runningCountBefore = fnCount(0, false);
+	const auto parkedCountBefore = fnCount(2, true);
+
+	const auto runner = Co::WaitForever().runScoped();
+	REQUIRE(Co::GetLiveTasks().size() == countBefore + 1);
+	REQUIRE(fnCount(0, false) == runningCountBefore + 1);
+
+	// 休止中のタスクも一覧に含まれる
+	System::Update();
+	System::Update();
+	REQUIRE(Co::GetLiveTasks().size() == countBefore + 1);
+	REQUIRE(fnCount(2, true) == parkedCountBefore + 1);
+	REQUIRE(Co::DumpLiveTasks().contains(U"age=2 frames=1"));
+	REQUIRE(Co::DumpLiveTasks().contains(U"parked"));
+}
+
+TEST_CASE("Task::named does not change behavior")
+{
+	int32 value = 0;
+	const auto runner = DelayFrameTest(&value).named(U"DelayFrameTest").runScoped();
+	while (!runner.done())
+	{
+		System::Update();
+	}
+	REQUIRE(value == 3);
+}
+
+TEST_CASE("ChromeTraceProfilerSink")
+{
+	Co::ChromeTraceProfilerSink sink;
+	sink.beginZone(Co::ProfileZone{ .kind = Co::ProfileZoneKind::Layer, .name = U"Layer" }, 1'000'000);
+	sink.beginZone(Co::ProfileZone{ .kind = Co::ProfileZoneKind::Drawer, .name = U"A\"B" }, 1'000'500);
+	sink.endZone(1'002'000);
+	sink.endZone(1'003'250);
+
+	// 対応する開始のない終了は無視される
+	sink.endZone(1'004'000);
+
+	REQUIRE(sink.size() == 2);
+	REQUIRE(sink.toJSON() == U"{\"traceEvents\":["
+		U"{\"name\":\"A\\\"B\",\"cat\":\"drawer\",\"ph\":\"X\",\"ts\":1000.500,\"dur\":1.500,\"pid\":1,\"tid\":1},"
+		U"{\"name\":\"Layer\",\"cat\":\"layer\",\"ph\":\"X\",\"ts\":1000.000,\"dur\":3.250,\"pid\":1,\"tid\":1}"
+		U"]}");
+
+	sink.clear();
+	REQUIRE(sink.size() == 0);
+	REQUIRE(sink.toJSON() == U"{\"traceEvents\":[]}");
+}
+
+#ifdef COTASKLIB_ENABLE_PROFILER
+TEST_CASE("Profiler records task resumes")
+{
+	Co::ChromeTraceProfilerSink sink;
+	Co::SetProfilerSink(&sink);
+
+	auto runner = []() -> Co::Task<void>
+		{
+			for (int32 i = 0; i < 5; ++i)
+			{
+				co_await Co::NextFrame();
+			}
+		}().named(U"Profiled").runScoped();
+	System::Update();
+	System::Update();
+
+	const auto profiles = Co::GetTaskProfiles();
+	const auto it = std::find_if(profiles.begin(), profiles.end(), [](const Co::TaskProfile& profile) { return profile.name == U"Profiled"; });
+	REQUIRE(it != profiles.end());
+	REQUIRE(it->resumeCount == 2);
+	REQUIRE(it->line > 0);
+	REQUIRE(sink.toJSON().contains(U"Profiled"));
+
+	Co::SetProfilerSink(nullptr);
+	while (!runner.done())
+	{
+		System::Update();
+	}
+}
+
+TEST_CASE("Profiler records drawer zones")
+{
+	Co::ChromeTraceProfilerSink sink;
+	Co::SetProfilerSink(&sink);
+	{
+		const Co::ScopedDrawer drawer{ [] {}, Co::Layer::Debug };
+		System::Update();
+	}
+	Co::SetProfilerSink(nullptr);
+
+	const String json = sink.toJSON();
+	REQUIRE(json.contains(U"\"cat\":\"layer\""));
+	REQUIRE(json.contains(U"\"cat\":\"drawer\""));
+}
+
+TEST_CASE("Profiler drawer names")
+{
+	// 型名はマングルされていない形で表示される
+	REQUIRE(Co::detail::ProfileTypeName(typeid(Co::ScopedDrawer)) == U"Co::ScopedDrawer");
+
+	Co::ChromeTraceProfilerSink sink;
+	Co::SetProfilerSink(&sink);
+	{
+		Co::ScopedDrawer drawer{ [] {}, Co::Layer::Debug };
+		drawer.setProfileName(U"NamedDrawer");
+		System::Update();
+	}
+	Co::SetProfilerSink(nullptr);
+
+	REQUIRE(sink.toJSON().contains(U"NamedDrawer"));
+}
+#endif
+
+TEST_CASE("RunOnWorker")
+{
+	const auto mainThreadID = std::this_thread::get_id();
+	Optional<int32> result;
+	bool isRunOnOtherThread = false;
+	const auto fnTask = [&]() -> Co::Task<void>
+		{
+			const auto [value, threadID] = co_await Co::RunOnWorker([] { return std::make_pair(42, std::this_thread::get_id()); });
+			result = value;
+			isRunOnOtherThread = threadID != mainThreadID;
+		};
+
+	const auto runner = fnTask().runScoped();
+	UpdateUntilDone(runner);
+	REQUIRE(runner.done());
+	REQUIRE(result == 42);
+	REQUIRE(isRunOnOtherThread);
+	REQUIRE(Co::GetWorkerThreadCount() >= 1);
+}
+
+TEST_CASE("RunOnWorker resumes only after the work finishes")
+{
+	std::atomic<bool> isReleased = false;
+	int32 value = 0;
+	const auto fnTask = [&]() -> Co::Task<void>
+		{
+			co_await Co::RunOnWorker([&] { while (!isReleased) std::this_thread::yield(); });
+			++value;
+		};
+
+	const auto runner = fnTask().runScoped();
+	for (int32 i = 0; i < 5; ++i)
+	{
+		System::Update();
+	}
+	REQUIRE(!runner.done());
+	REQUIRE(value == 0);
+
+	isReleased = true;
+	UpdateUntilDone(runner);
+	REQUIRE(runner.done());
+	REQUIRE(value == 1);
+}
+
+TEST_CASE("RunOnWorker rethrows exceptions on the main thread")
+{
+	bool isCaught = false;
+	const auto fnTask = [&]() -> Co::Task<void>
+		{
+			try
+			{
+				co_await Co::RunOnWorker([]() -> int32 { throw std::runtime_error{ "error" }; });
+			}
+			catch (const std::runtime_error&)
+			{
+				isCaught = true;
+			}
+		};
+
+	const auto runner = fnTask().runScoped();
+	UpdateUntilDone(runner);
+	REQUIRE(runner.done());
+	REQUIRE(isCaught);
+}
+
+TEST_CASE("RunOnWorkerBatch")
+{
+	Array<int32> results;
+	std::atomic<int32> voidCount = 0;
+	bool isEmptyDone = false;
+	const auto fnTask = [&]() -> Co::Task<void>
+		{
+			results = co_await Co::RunOnWorkerBatch(1000, [](std::size_t index) { return static_cast<int32>(index) * 2; });
+			co_await Co::RunOnWorkerBatch(100, [&](std::size_t) { ++voidCount; });
+			isEmptyDone = (co_await Co::RunOnWorkerBatch(0, [](std::size_t) { return 0; })).empty();
+		};
+
+	const auto runner = fnTask().runScoped();
+	UpdateUntilDone(runner);
+	REQUIRE(runner.done());
+	REQUIRE(results.size() == 1000);
+	bool isAllCorrect = true;
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		isAllCorrect = isAllCorrect && results[i] == static_cast<int32>(i) * 2;
+	}
+	REQUIRE(isAllCorrect);
+	REQUIRE(voidCount == 100);
+	REQUIRE(isEmptyDone);
+}
+
+TEST_CASE("RunOnWorker passes a CancellationToken canceled on runner destruction")
+{
+	struct State
+	{
+		std::atomic<bool> isStarted = false;
+		std::atomic<bool> isCanceledObserved = false;
+	};
+	const auto pState = std::make_shared<State>();
+
+	{
+		const auto runner = Co::RunOnWorker([pState](const Co::CancellationToken& token)
+			{
+				pState->isStarted = true;
+				pState->isCanceledObserved = WaitForCancellation(token);
+			}).runScoped();
+
+		// 未着手のまま破棄すると関数自体が実行されないため、実行が始まるまで待つ
+		for (int32 i = 0; i < 10000 && !pState->isStarted; ++i)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+		REQUIRE(pState->isStarted);
+		REQUIRE(!runner.done());
+	}
+
+	// ジョブが破棄されるまで待つ(完了キューが保持する参照はupdateで解放される)
+	for (int32 i = 0; i < 10000 && pState.use_count() > 1; ++i)
+	{
+		System::Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	}
+	REQUIRE(pState.use_count() == 1);
+	REQUIRE(pState->isCanceledObserved);
+}
+
+TEST_CASE("RunOnWorkerBatch skips remaining items when the task is destroyed")
+{
+	struct State
+	{
+		std::atomic<bool> isReleased = false;
+		std::atomic<int32> runCount = 0;
+	};
+	const auto pState = std::make_shared<State>();
+
+	{
+		const auto runner = Co::RunOnWorkerBatch(1000, [pState](std::size_t)
+			{
+				++pState->runCount;
+				while (!pState->isReleased) std::this_thread::yield();
+			}).runScoped();
+		System::Update();
+	}
+	pState->isReleased = true;
+
+	// ジョブが破棄されるまで待つ(完了キューが保持する参照はupdateで解放される)
+	for (int32 i = 0; i < 10000 && pState.use_count() > 1; ++i)
+	{
+		System::Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	}
+	REQUIRE(pState.use_count() == 1);
+	REQUIRE(pState->runCount <= static_cast<int32>(Co::GetWorkerThreadCount()));
+}
+
+Co::Task<void> CountEveryFrame(int32* pCount)
+{
+	while (true)
+	{
+		co_await Co::NextFrame();
+		++*pCount;
+	}
+}
+
+TEST_CASE("TaskGroup pauses all members")
+{
+	const auto fnParkedCount = []
+		{
+			const auto tasks = Co::GetLiveTasks();
+			return std::count_if(tasks.begin(), tasks.end(), [](const Co::LiveTaskInfo& info) { return info.isParked; });
+		};
+
+	Co::TaskGroup group;
+	int32 countA = 0;
+	int32 countB = 0;
+	int32 countOutside = 0;
+	const auto runnerA = CountEveryFrame(&countA).runScoped(group);
+	Co::MultiRunner mr;
+	mr.joinGroup(group);
+	CountEveryFrame(&countB).runAddTo(mr);
+	const auto runnerOutside = CountEveryFrame(&countOutside).runScoped();
+	REQUIRE(group.size() == 2);
+
+	System::Update();
+	REQUIRE(countA == 1);
+	REQUIRE(countB == 1);
+	REQUIRE(countOutside == 1);
+
+	// コピーしたTaskGroupは状態を共有する
+	Co::TaskGroup groupCopy = group;
+	groupCopy.setPaused(true);
+	REQUIRE(group.isPaused());
+	const auto parkedCountBefore = fnParkedCount();
+	System::Update();
+	System::Update();
+	REQUIRE(countA == 1);
+	REQUIRE(countB == 1);
+	REQUIRE(countOutside == 3);
+
+	// 一時停止中の所属タスクは休止し、毎フレームのresume対象から外れる
+	REQUIRE(fnParkedCount() == parkedCountBefore + 2);
+
+	group.setPaused(false);
+	System::Update();
+	REQUIRE(countA == 2);
+	REQUIRE(countB == 2);
+	REQUIRE(countOutside == 4);
+}
+
+TEST_CASE("TaskGroup clock follows pause and time scale")
+{
+	TestClock clock;
+	Co::TaskGroup group{ &clock };
+	bool isDone = false;
+	const auto runner = Co::Delay(1s).runScoped(group, [&] { isDone = true; });
+
+	clock.microsec = 500'000;
+	System::Update();
+	REQUIRE(!isDone);
+
+	// 一時停止中はTaskGroupの時計が進まない
+	group.setPaused(true);
+	clock.microsec = 10'000'000;
+	System::Update();
+	System::Update();
+	REQUIRE(!isDone);
+	REQUIRE(group.clock()->getMicrosec() == 500'000);
+
+	group.setPaused(false);
+	group.setTimeScale(2.0);
+	clock.microsec = 10'250'000;
+	System::Update();
+	REQUIRE(isDone);
+	REQUIRE(group.clock()->getMicrosec() == 1'000'000);
+
+	REQUIRE_THROWS_AS(group.setTimeScale(-1.0), Error);
+}
+
+TEST_CASE("TaskGroup::requestCancelAll")
+{
+	Co::TaskGroup group;
+	Co::MultiRunner mr;
+	mr.joinGroup(group);
+	for (int32 i = 0; i < 3; ++i)
+	{
+		Co::WaitForever().runAddTo(mr);
+	}
+	const auto runnerOutside = Co::WaitForever().runScoped();
+	REQUIRE(group.size() == 3);
+
+	REQUIRE(group.requestCancelAll());
+	REQUIRE(group.empty());
+	REQUIRE(mr.allDone());
+	REQUIRE(!runnerOutside.done());
+	REQUIRE(!group.requestCancelAll());
+}
+
+TEST_CASE("Leaving a paused TaskGroup resumes the task")
+{
+	Co::TaskGroup group;
+	int32 count = 0;
+	const auto runner = CountEveryFrame(&count).runScoped();
+	runner.joinGroup(group);
+	group.setPaused(true);
+	System::Update();
+	System::Update();
+	REQUIRE(count == 0);
+
+	runner.leaveGroup();
+	REQUIRE(group.empty());
+	System::Update();
+	REQUIRE(count == 1);
+}
+
+TEST_CASE("Updater without TaskFinishSource argument")
+{
+	const auto censusBefore = Co::GetMemoryCensus();
+
+	int32 count = 0;
+	auto updater = Co::Updater([&] { ++count; });
+
+	// 生成時点ではまだ実行されない
+	REQUIRE(count == 0);
+
+	// runScopedで開始すると1回実行される
+	const auto runner = std::move(updater).runScoped();
+	REQUIRE(count == 1);
+	REQUIRE(runner.done() == false);
+
+	System::Update();
+	REQUIRE(count == 2);
+	REQUIRE(runner.done() == false);
+
+	// コルーチンフレームは確保されない
+	const auto census = Co::GetMemoryCensus();
+	REQUIRE(census.taskCount == censusBefore.taskCount + 1);
+	REQUIRE(census.frameCount == censusBefore.frameCount);
+}
+
+TEST_CASE("Updater with TaskFinishSource argument that has result")
+{
+	int32 count = 0;
+	auto updater = Co::Updater(
+		[&](Co::TaskFinishSource<int32>& taskFinishSource)
+		{
+			if (count == 2)
+			{
+				taskFinishSource.requestFinish(42);
+				return;
+			}
+			++count;
+		});
+
+	int32 result = 0;
+	const auto runner = std::move(updater).runScoped([&](int32 r) { result = r; });
+	REQUIRE(count == 1);
+	REQUIRE(runner.done() == false);
+
+	System::Update();
+	REQUIRE(count == 2);
+	REQUIRE(runner.done() == false);
+	REQUIRE(result == 0);
+
+	// requestFinishが呼ばれたら完了する
+	System::Update();
+	REQUIRE(count == 2);
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == 42);
+}
+
+TEST_CASE("Updater with TaskFinishSource argument that has immediate result")
+{
+	int32 result = 0;
+	const auto runner = Co::Updater([](Co::TaskFinishSource<int32>& taskFinishSource) { taskFinishSource.requestFinish(42); })
+		.runScoped([&](int32 r) { result = r; });
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == 42);
+}
+
+TEST_CASE("co_await Updater")
+{
+	int32 count = 0;
+	int32 result = 0;
+	const auto runner = [&]() -> Co::Task<void>
+		{
+			result = co_await Co::Updater(
+				[&](Co::TaskFinishSource<int32>& taskFinishSource)
+				{
+					if (++count == 3)
+					{
+						taskFinishSource.requestFinish(count * 10);
+					}
+				});
+		}().runScoped();
+	REQUIRE(count == 1);
+	REQUIRE(runner.done() == false);
+
+	System::Update();
+	REQUIRE(count == 2);
+	REQUIRE(runner.done() == false);
+
+	// 完了したフレーム内で待機元のタスクも再開される
+	System::Update();
+	REQUIRE(count == 3);
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == 30);
+}
+
+TEST_CASE("Updater value")
+{
+	auto updater = Co::Updater([](Co::TaskFinishSource<String>& taskFinishSource) { taskFinishSource.requestFinish(U"done"); });
+	updater.resume();
+	REQUIRE(updater.done() == true);
+
+	// const参照を返すため、何度呼んでも同じ結果を参照できる
+	REQUIRE(updater.value() == U"done");
+	REQUIRE(updater.value() == U"done");
+
+	// 右辺値に対して呼ぶと結果を取り出す
+	const String result = std::move(updater).value();
+	REQUIRE(result == U"done");
+}
 
-	// 即座に終了
+TEST_CASE("co_await Updater with move-only result")
+{
+	std::unique_ptr<int32> result;
+	const auto runner = [](std::unique_ptr<int32>& result) -> Co::Task<void>
+		{
+			result = co_await Co::Updater([](Co::TaskFinishSource<std::unique_ptr<int32>>& taskFinishSource) { taskFinishSource.requestFinish(std::make_unique<int32>(42)); });
+		}(result).runScoped();
 	REQUIRE(runner.done() == true);
-	REQUIRE(value == U"TEST");
+	REQUIRE(result != nullptr);
+	REQUIRE(*result == 42);
 }
 
-TEST_CASE("Co::Typewriter with total duration")
+TEST_CASE("Updater with Co::All and Co::Any")
 {
-	TestClock clock;
+	int32 count = 0;
+	const auto fnFinishAt = [&](int32 frame)
+		{
+			return Co::Updater(
+				[&count, frame](Co::TaskFinishSource<int32>& taskFinishSource)
+				{
+					if (count >= frame)
+					{
+						taskFinishSource.requestFinish(frame);
+					}
+				});
+		};
+	const auto counter = Co::Updater([&] { ++count; }).runScoped();
 
-	String value;
-	const auto runner = Co::Typewriter(&value)
-		.text(U"TEST")
-		.totalDuration(1s)
-		.setClock(&clock)
-		.playScoped();
+	Optional<std::tuple<int32, int32>> allResult;
+	const auto allRunner = Co::All(fnFinishAt(2), fnFinishAt(3)).runScoped([&](std::tuple<int32, int32> r) { allResult = r; });
+
+	Optional<std::tuple<Optional<int32>, Optional<Co::VoidResult>>> anyResult;
+	const auto anyRunner = Co::Any(fnFinishAt(2), Co::Delay(10s)).runScoped([&](auto r) { anyResult = r; });
 
-	// 0秒
-	clock.microsec = 0;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"T");
+	REQUIRE(count == 2);
+	REQUIRE(allResult == none);
+	REQUIRE(anyResult.has_value());
+	REQUIRE(std::get<0>(*anyResult) == 2);
+	REQUIRE(std::get<1>(*anyResult) == none);
 
-	// 0.2501秒
-	clock.microsec = 250'100;
 	System::Update();
+	REQUIRE(allResult.has_value());
+	REQUIRE(*allResult == std::make_tuple(2, 3));
+}
+
+TEST_CASE("Throw exception in Updater")
+{
+	int32 finishCallbackCount = 0;
+	int32 cancelCallbackCount = 0;
+
+	int32 count = 0;
+	const auto runner = Co::Updater(
+		[&]
+		{
+			if (++count == 2)
+			{
+				throw std::runtime_error("test exception");
+			}
+		}).runScoped([&] { ++finishCallbackCount; }, [&] { ++cancelCallbackCount; });
+
+	// System::Update内で例外が発生すると以降のテスト実行に影響が出る可能性があるため、手動resumeでテスト
+	REQUIRE_THROWS_WITH(Co::detail::Backend::ManualUpdate(), "test exception");
+
+	REQUIRE(finishCallbackCount == 0);
+	REQUIRE(cancelCallbackCount == 1);
+}
+
+TEST_CASE("Area input waiters are parked and registered to the input router")
+{
+	const auto& router = Co::detail::Backend::GetInputRouter();
+	const std::size_t nodeCountBefore = router.nodeCount();
+	const auto parkedCountBefore = Co::GetMemoryCensus().parkedTaskCount;
+
+	// カーソルが当たらない画面外の領域で待機する
+	{
+		const auto runner1 = Co::WaitUntilLeftClicked(Rect{ -10000, -10000, 100, 100 }).runScoped();
+		const auto runner2 = Co::WaitUntilMouseOver(Circle{ -10000, -10000, 50 }).runScoped();
+		const auto runner3 = Co::WaitUntilRightClickedThenReleased(RectF{ -10000, -10000, 100, 100 }).runScoped();
+		REQUIRE(router.nodeCount() == nodeCountBefore + 3);
+
+		// 毎フレームのresume対象から外れる
+		System::Update();
+		REQUIRE(Co::GetMemoryCensus().parkedTaskCount == parkedCountBefore + 3);
+		System::Update();
+		REQUIRE(runner1.done() == false);
+		REQUIRE(runner2.done() == false);
+		REQUIRE(runner3.done() == false);
+	}
+
+	// タスクの破棄時に登録が解除される
+	REQUIRE(router.nodeCount() == nodeCountBefore);
+	REQUIRE(Co::GetMemoryCensus().parkedTaskCount == parkedCountBefore);
+}
+
+TEST_CASE("ScopedInputBlocker blocks lower layers")
+{
+	REQUIRE(Co::IsInputBlocked(Layer::Default) == false);
+
+	{
+		const Co::ScopedInputBlocker blocker{ Layer::Modal };
+		REQUIRE(Co::IsInputBlocked(Layer::Default) == true);
+		REQUIRE(Co::IsInputBlocked(Layer::User_PostDefault_10) == true);
+
+		// 同じレイヤー以上は遮断されない
+		REQUIRE(Co::IsInputBlocked(Layer::Modal) == false);
+		REQUIRE(Co::IsInputBlocked(Layer::Transition_General) == false);
+
+		// カーソル位置を覆わない領域の遮断は影響しない
+		const Co::ScopedInputBlocker areaBlocker{ Layer::Debug, RectF{ -10000, -10000, 100, 100 } };
+		REQUIRE(Co::IsInputBlocked(Layer::Modal) == false);
+	}
+
+	REQUIRE(Co::IsInputBlocked(Layer::Default) == false);
+}
+
+TEST_CASE("PreloadDialogText preloads glyphs across frames")
+{
+	// 他のテストでプリロードされない文字を使用
+	const String text = U"鰯鰹鰆鱈鯖鰤鯵鰈鰻鮪";
+	REQUIRE(Co::IsDialogTextPreloaded(text) == false);
+
+	const auto runner = Co::PreloadDialogText(text, 4).runScoped();
 	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"TE");
+	REQUIRE(Co::IsDialogTextPreloaded(U"鰯鰹鰆鱈") == true);
+	REQUIRE(Co::IsDialogTextPreloaded(U"鯖") == false);
 
-	// 0.5001秒
-	clock.microsec = 500'100;
 	System::Update();
 	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"TES");
+	REQUIRE(Co::IsDialogTextPreloaded(U"鯖鰤鯵鰈") == true);
+	REQUIRE(Co::IsDialogTextPreloaded(U"鰻") == false);
 
-	// 0.7501秒
-	clock.microsec = 750'100;
 	System::Update();
-	REQUIRE(runner.done() == false);
-	REQUIRE(value == U"TEST");
+	REQUIRE(runner.done() == true);
+	REQUIRE(Co::IsDialogTextPreloaded(text) == true);
+
+	// プリロード済みの文字のみの場合は即座に完了する
+	const auto runner2 = Co::PreloadDialogText(Array<String>{ U"鰻鮪", U"鰯" }).runScoped();
+	REQUIRE(runner2.done() == true);
+}
+
+TEST_CASE("PreloadDialogText skips duplicated glyphs")
+{
+	// 他のテストでプリロードされない文字を使用
+	const String text = U"鱧鱚鱧鱚鱧鱚鱧鱚";
+	REQUIRE(Co::IsDialogTextPreloaded(text) == false);
+
+	// 重複した文字は1回のみプリロードするため、異なる文字数分のフレームで完了する
+	const auto runner = Co::PreloadDialogText(text, 1).runScoped();
+	REQUIRE(Co::IsDialogTextPreloaded(U"鱧") == true);
+	REQUIRE(Co::IsDialogTextPreloaded(U"鱚") == false);
 
-	// 1.0001秒
-	clock.microsec = 1'000'100;
 	System::Update();
 	REQUIRE(runner.done() == true);
-	REQUIRE(value == U"TEST");
+	REQUIRE(Co::IsDialogTextPreloaded(text) == true);
 }
 
-template <typename Func, typename... Args>
-auto AsyncTaskCaller(Func func, Args... args) -> Co::Task<std::invoke_result_t<Func, Args...>>
-	requires std::is_invocable_v<Func, Args...>
+TEST_CASE("PreloadDialogText with zero glyphsPerFrame")
 {
-	co_return co_await Async(func, std::move(args)...);
+	REQUIRE_THROWS_AS(Co::PreloadDialogText(U"鱒", 0).runScoped(), Error);
 }
 
-TEST_CASE("s3d::AsyncTask immediate")
+TEST_CASE("FastForward advances frame count and scene time")
+{
+	const int32 frameCountBefore = Co::GetFrameCount();
+	const double sceneTimeBefore = Co::GetSceneTime();
+
+	Co::FastForward(100, 0.25s);
+	REQUIRE(Co::GetFrameCount() == frameCountBefore + 100);
+	REQUIRE(Co::GetSceneTime() >= sceneTimeBefore + 24.9);
+
+	// 早送り後も連続する
+	const int32 frameCountAfter = Co::GetFrameCount();
+	System::Update();
+	REQUIRE(Co::GetFrameCount() == frameCountAfter + 1);
+}
+
+Co::Task<void> FastForwardDelayTest(int32* pValue)
+{
+	co_await Co::Delay(1s);
+	*pValue += 1;
+}
+
+Co::Task<void> FastForwardDelayFrameTest(int32* pValue)
+{
+	co_await Co::DelayFrame(100);
+	*pValue += 10;
+}
+
+TEST_CASE("FastForward with Delay and DelayFrame")
 {
 	int32 value = 0;
-	const auto runner = AsyncTaskCaller([] { return 42; }).runScoped([&value](int32 result) { value = result; });
 
-	// 通常の即時returnとは違って別スレッドなので、完了までに最低限の待機は必要
-	while (!runner.done())
+	const auto runner = Co::All(FastForwardDelayTest(&value), FastForwardDelayFrameTest(&value)).runScoped();
+
+	// 0.75秒
+	Co::FastForward(3, 0.25s);
+	REQUIRE(value == 0);
+
+	// 1.25秒
+	Co::FastForward(2, 0.25s);
+	REQUIRE(value == 1);
+
+	Co::FastForward(90, 0.25s);
+	REQUIRE(value == 1);
+	REQUIRE(runner.done() == false);
+
+	Co::FastForward(10, 0.25s);
+	REQUIRE(value == 11);
+	REQUIRE(runner.done() == true);
+}
+
+Co::Task<void> FastForwardDuringUpdateTest()
+{
+	co_await Co::NextFrame();
+	Co::FastForward(1);
+}
+
+TEST_CASE("FastForward during update throws")
+{
+	const auto runner = FastForwardDuringUpdateTest().runScoped();
+
+	REQUIRE_THROWS_WITH(Co::detail::Backend::ManualUpdate(), "FastForward must not be called during Backend update");
+}
+
+Co::Task<void> ExecutorDelayFrameTest(int32* pValue)
+{
+	co_await Co::DelayFrame(2);
+	*pValue = 1;
+}
+
+TEST_CASE("Executor runs bound tasks independently of main Backend")
+{
+	Co::Executor executor;
+	int32 value = 0;
+
+	Optional<Co::ScopedTaskRunner> runner;
 	{
-		System::Update();
+		const auto binding = executor.bind();
+		runner.emplace(ExecutorDelayFrameTest(&value).runScoped());
 	}
-	REQUIRE(value == 42);
+
+	// メインのBackendのupdateでは進まない
+	System::Update();
+	System::Update();
+	System::Update();
+	REQUIRE(value == 0);
+
+	executor.update();
+	REQUIRE(value == 0);
+
+	executor.update();
+	executor.update();
+	REQUIRE(value == 1);
+
+	{
+		const auto binding = executor.bind();
+		REQUIRE(runner->done() == true);
+		runner.reset();
+	}
+	REQUIRE(executor.hasTasks() == false);
 }
 
-TEST_CASE("s3d::AsyncTask with sleep")
+TEST_CASE("Executor runner destroyed outside its binding")
 {
-	std::atomic<int32> value = 0;
+	std::vector<int32> vec;
+	const auto mainRunner = PushBackValueEveryFrame(&vec, 1).runScoped();
 
-	// 完了に十分な時間待つ
-	const auto wait = Co::Delay(0.5s).runScoped();
+	Optional<Co::Executor> executor{ InPlace };
+	Optional<Co::ScopedTaskRunner> executorRunner;
+	Optional<Co::ScopedTaskRunner> executorRunner2;
 	{
-		const auto runner = AsyncTaskCaller([] { std::this_thread::sleep_for(0.01s); return 42; }).runScoped([&value](int32 result) { value = result; });
-		REQUIRE(runner.done() == false);
-		REQUIRE(value == 0);
-
-		while (!wait.done())
-		{
-			System::Update();
-		}
+		const auto binding = executor->bind();
+		executorRunner.emplace(Co::WaitForever().runScoped());
+		executorRunner2.emplace(Co::WaitForever().runScoped());
 	}
 
-	REQUIRE(value == 42);
+	// 切り替えの外でも、開始したExecutorのタスクとして参照・破棄される
+	REQUIRE(executorRunner->done() == false);
+	executorRunner.reset();
+	REQUIRE(executor->hasTasks() == true);
+	REQUIRE(executorRunner2->done() == false);
+
+	// メインのBackendのタスクには影響しない
+	REQUIRE(mainRunner.done() == false);
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1 });
+
+	// Executorが先に破棄された場合は完了扱いとなり、ランナーの破棄時も何もしない
+	executor.reset();
+	REQUIRE(executorRunner2->done() == true);
+	executorRunner2.reset();
+
+	System::Update();
+	REQUIRE(vec == std::vector<int32>{ 1, 1 });
+	REQUIRE(mainRunner.done() == false);
 }
 
-TEST_CASE("s3d::AsyncTask with sleep canceled")
+Co::Task<void> WaitForResultInto(Co::TaskFinishSource<int32>& source, Optional<int32>* pResult)
 {
-	std::atomic<int32> value = 0;
-	int32 finishCallbackCOunt = 0;
-	int32 cancelCallbackCount = 0;
+	*pResult = co_await source.waitForResult();
+}
 
-	// 完了に不十分な時間しか待たない場合も、タスク自体はキャンセルされるが、std::futureの破棄タイミングでスレッド終了を待機するため実行は最後までされることを確認
+Co::Task<void> RequestFinishAfterFrame(Co::TaskFinishSource<int32>& source, int32 value)
+{
+	co_await Co::NextFrame();
+	source.requestFinish(value);
+}
+
+TEST_CASE("TaskFinishSource finished inside Executor wakes main Backend waiter")
+{
+	Co::TaskFinishSource<int32> source;
+	Optional<int32> result;
+	const auto mainRunner = WaitForResultInto(source, &result).runScoped();
+
+	// メインのBackendで休止させる
+	System::Update();
+	REQUIRE(result == none);
+
+	Co::Executor executor;
+	Optional<Co::ScopedTaskRunner> executorRunner;
 	{
-		const auto runner = AsyncTaskCaller([&] { std::this_thread::sleep_for(0.2s); value = 42; })
-			.runScoped([&]() { ++finishCallbackCOunt; }, [&]() { ++cancelCallbackCount; });
-		REQUIRE(runner.done() == false);
-		REQUIRE(value == 0);
+		const auto binding = executor.bind();
+		executorRunner.emplace(RequestFinishAfterFrame(source, 42).runScoped());
+	}
 
-		const auto wait = Co::Delay(0.01s).runScoped();
-		while (!wait.done())
-		{
-			System::Update();
-		}
+	// Executor内で完了させても、休止させたメインのBackendのタスクが起床する
+	executor.update();
+	REQUIRE(executorRunner->done() == true);
+	System::Update();
+	REQUIRE(result == 42);
+	REQUIRE(mainRunner.done() == true);
+}
+
+Co::Task<int32> ExecutorComputeTest()
+{
+	co_await Co::DelayFrame(1);
+	co_return 42;
+}
+
+Co::Task<void> RunOnExecutorTest(Co::Executor& executor, int32* pResult)
+{
+	*pResult = co_await Co::RunOnExecutor(executor, ExecutorComputeTest());
+}
+
+TEST_CASE("RunOnExecutor")
+{
+	Co::Executor executor;
+	int32 result = 0;
+
+	const auto runner = RunOnExecutorTest(executor, &result).runScoped();
+	REQUIRE(executor.hasPendingTasks() == true);
+
+	for (int32 i = 0; i < 10 && !runner.done(); ++i)
+	{
+		executor.update();
+		System::Update();
 	}
-	REQUIRE(value == 42);
-	REQUIRE(finishCallbackCOunt == 0);
-	REQUIRE(cancelCallbackCount == 1);
+	REQUIRE(runner.done() == true);
+	REQUIRE(result == 42);
 }
 
-TEST_CASE("s3d::AsyncTask with exception")
+Co::Task<int32> ExecutorThrowTest()
 {
-	std::atomic<int32> value = 0;
-	int32 finishCallbackCOunt = 0;
-	int32 cancelCallbackCount = 0;
+	throw Error{ U"executor exception" };
+	co_return 0;
+}
 
-	auto task = AsyncTaskCaller([&] { std::this_thread::sleep_for(0.01s); throw std::runtime_error("test exception"); value = 42; })
-		.runScoped([&]() { ++finishCallbackCOunt; }, [&]() { ++cancelCallbackCount; });
-	REQUIRE(value == 0);
+Co::Task<void> RunOnExecutorThrowTest(Co::Executor& executor)
+{
+	co_await Co::RunOnExecutor(executor, ExecutorThrowTest());
+}
 
-	const auto fnWait = [&task]
-		{
-			while (!task.done())
-			{
-				std::this_thread::sleep_for(0.01s);
+TEST_CASE("RunOnExecutor with exception")
+{
+	Co::Executor executor;
 
-				// System::Update内で例外が発生すると以降のテスト実行に影響が出る可能性があるため、手動resumeでテスト
-				Co::detail::Backend::ManualUpdate();
-			}
-		};
+	const auto runner = RunOnExecutorThrowTest(executor).runScoped();
 
-	// 他スレッドで発生した例外が捕捉できることを確認
-	REQUIRE_THROWS_WITH(fnWait(), "test exception");
-	REQUIRE(value == 0);
-	REQUIRE(finishCallbackCOunt == 0);
-	REQUIRE(cancelCallbackCount == 1);
+	// Executor側の例外は投入元で再送出される
+	executor.update();
+	REQUIRE_THROWS_WITH(Co::detail::Backend::ManualUpdate(), "executor exception");
 }
 
-TEST_CASE("s3d::AsyncTask with move-only result")
+Co::Task<void> RunOnExecutorForeverTest(Co::Executor& executor)
 {
-	std::unique_ptr<int32> result = nullptr;
+	co_await Co::RunOnExecutor(executor, Co::WaitForever());
+}
 
-	// ムーブオンリー型の結果も取得できる
-	const auto runner = AsyncTaskCaller([](int32 value) { return std::make_unique<int32>(value * 10); }, 42)
-		.runScoped([&](std::unique_ptr<int32>&& r) { result = std::move(r); });
+TEST_CASE("RunOnExecutor with destroyed executor")
+{
+	Optional<Co::Executor> executor{ InPlace };
 
-	// 通常の即時returnとは違って別スレッドなので、完了までに最低限の待機は必要
-	while (!runner.done())
+	const auto runner = RunOnExecutorForeverTest(*executor).runScoped();
+	executor->update();
+	REQUIRE(executor->hasTasks() == true);
+
+	// Executorの破棄時に実行中のタスクはキャンセルされ、投入元には例外が送出される
+	executor.reset();
+	REQUIRE_THROWS_WITH(Co::detail::Backend::ManualUpdate(), "RunOnExecutor: The task was canceled because the executor was destroyed");
+}
+
+TEST_CASE("RunOnExecutor with ExecutorGroup")
+{
+	Co::ExecutorGroup executorGroup{ 2, 0.001s };
+	REQUIRE(executorGroup.threadCount() == 2);
+
+	Array<int32> results;
+	const auto runner = Co::All(
+		Co::RunOnExecutor(executorGroup, ExecutorComputeTest()),
+		Co::RunOnExecutor(executorGroup, ExecutorComputeTest()),
+		Co::RunOnExecutor(executorGroup, ExecutorComputeTest())).runScoped([&](const std::tuple<int32, int32, int32>& result)
+		{
+			results = { std::get<0>(result), std::get<1>(result), std::get<2>(result) };
+		});
+
+	for (int32 i = 0; i < 600 && !runner.done(); ++i)
 	{
 		System::Update();
 	}
-	REQUIRE(result != nullptr);
-	REQUIRE(*result == 420);
+	REQUIRE(runner.done() == true);
+	REQUIRE(results == Array<int32>{ 42, 42, 42 });
 }
 
 void Main()